@@ -0,0 +1,5 @@
+// Benchmarks are built as their own Catch2 executable, separate from the tests.
+// Run with "[!benchmark]" or a specific tag to select benchmarks.
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
@@ -0,0 +1,65 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "collision_grid.h"
+#include "physics_body.h"
+
+/* Balls scattered through a box that grows with their number, so each ball has about the same number of neighbors at every count */
+static std::vector<PhysicsBody*> ballsAtDemoDensity(size_t count) {
+	float box_size = 20 * std::cbrt(count / 40.0f);
+	std::vector<PhysicsBody*> bodies;
+	std::srand(0);
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f position = ofVec3f(ofRandom(-0.5f, 0.5f), ofRandom(-0.5f, 0.5f), ofRandom(-0.5f, 0.5f)) * box_size;
+		bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 1, position, ofVec3f(1, 0, 0), ofVec3f(0, 0, 0), ofRandom(0.05f, 0.55f)));
+	}
+	return bodies;
+}
+
+TEST_CASE("Collision grid: 100 to 100,000 balls", "[!benchmark][collision]") {
+	CollisionGrid grid;
+	BodyStore store;
+	std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+	//The grid sorts a store of the bodies, so the balls are copied into it every step
+	auto copyBodies = [&](const std::vector<PhysicsBody*>& bodies) {
+		store.resize(bodies.size());
+		for (size_t i = 0; i < bodies.size(); i++) {
+			store.setBody(i, bodies[i]->position, bodies[i]->mass, bodies[i]->radius);
+		}
+	};
+
+	for (size_t count : { 100, 1000, 10000, 100000 }) {
+		std::vector<PhysicsBody*> bodies = ballsAtDemoDensity(count);
+		copyBodies(bodies);
+		grid.build(store);
+		grid.findPairs(store, pairs);
+		WARN(count << " balls: " << pairs.size() << " touching pairs");
+
+		BENCHMARK("grid, " + std::to_string(count) + " balls") {
+			copyBodies(bodies);
+			grid.build(store);
+			grid.findPairs(store, pairs);
+			for (const std::pair<uint32_t, uint32_t>& pair : pairs) {
+				bodies[pair.first]->collideWithBody(bodies[pair.second]);
+			}
+			return pairs.size();
+		};
+
+		//Every pair, the way Renderer::updatePhysics used to. Too slow to run past a few thousand balls
+		if (count <= 10000) {
+			BENCHMARK("every pair, " + std::to_string(count) + " balls") {
+				for (size_t i = 0; i + 1 < bodies.size(); i++) {
+					for (size_t j = i + 1; j < bodies.size(); j++) {
+						bodies[i]->collideWith(bodies[j]);
+					}
+				}
+				return bodies.size();
+			};
+		}
+
+		for (PhysicsBody* body : bodies) {
+			delete body;
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "camera.h"
+#include "plane.h"
+
+/* Hundreds of models on a grid all around the camera, standing on the floor from Renderer */
+struct CrowdScene {
+	Camera camera = Camera(ofVec3f(0, 0, 0), ofVec2f(0.3f, -0.1f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	Plane floor = Plane(ofVec3f(0, -1, 0), ofVec3f(0, 1, 0), ofColor::gray, 30);
+	std::vector<Model3D*> models;
+
+	CrowdScene() {
+		const char* obj_paths[3] = { "..\\models\\cow.obj", "..\\models\\teapot.obj", "..\\models\\cube.obj" };
+		const float size_scales[3] = { 0.2f, 0.4f, 1.0f };
+		int index = 0;
+		for (int x = -10; x <= 10; x++) {
+			for (int z = -10; z <= 10; z++) {
+				if (x == 0 && z == 0) {
+					continue;
+				}
+				models.push_back(new Model3D(obj_paths[index % 3], ofColor::white, ofVec3f(x * 3, 0, z * 3), size_scales[index % 3]));
+				index++;
+			}
+		}
+	}
+
+	~CrowdScene() {
+		for (Model3D* model : models) {
+			delete model;
+		}
+	}
+
+	/* Draws the floor and every model, returning how many were culled */
+	size_t draw(LineBatch& lines) {
+		lines.clear();
+		size_t culled = !camera.drawModel(&floor, lines);
+		for (Model3D* model : models) {
+			culled += !camera.drawModel(model, lines);
+		}
+		return culled;
+	}
+};
+
+TEST_CASE("Culling: hundreds of models around the camera", "[!benchmark][culling]") {
+	CrowdScene scene;
+	LineBatch lines;
+
+	scene.camera.frustum_culling = false;
+	scene.draw(lines);
+	size_t all_segments = lines.segmentCount();
+	scene.camera.frustum_culling = true;
+	size_t culled = scene.draw(lines);
+
+	//Culling must not change what ends up on screen
+	REQUIRE(lines.segmentCount() == all_segments);
+	WARN(scene.models.size() + 1 << " models, " << culled << " culled, " << all_segments << " segments");
+
+	for (bool culling : { false, true }) {
+		scene.camera.frustum_culling = culling;
+		BENCHMARK(culling ? "frustum culling" : "no culling") {
+			return scene.draw(lines);
+		};
+	}
+
+	BENCHMARK("sphere tests alone") {
+		size_t visible = 0;
+		for (Model3D* model : scene.models) {
+			visible += scene.camera.inFrustum(model->position, model->boundingRadius());
+		}
+		return visible;
+	};
+}
@@ -0,0 +1,40 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "camera.h"
+
+TEST_CASE("Decimation: a field of teapots reaching into the distance", "[!benchmark][decimation]") {
+	Camera camera = Camera(ofVec3f(0, 2, 0), ofVec2f(0, -0.05f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	std::vector<Model3D*> teapots;
+	for (int row = 1; row <= 40; row++) {
+		for (int column = -5; column <= 5; column++) {
+			teapots.push_back(new Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(column * 3 * row / 4.0f, 0, -row * row * 1.5f), 0.4f));
+		}
+	}
+	LineBatch lines;
+	auto draw = [&]() {
+		lines.clear();
+		camera.resetDrawCounters();
+		for (Model3D* teapot : teapots) {
+			camera.drawModel(teapot, lines);
+		}
+		return lines.segmentCount();
+	};
+
+	//The renderer's default thresholds, then with decimation off
+	for (bool decimation : { false, true }) {
+		camera.decimation_radius = decimation ? 40.0f : 0.0f;
+		camera.marker_radius = decimation ? 2.0f : 0.0f;
+		camera.min_edge_length = decimation ? 0.5f : 0.0f;
+		draw();
+		WARN((decimation ? "decimation: " : "every edge: ") << teapots.size() << " teapots, " << lines.segmentCount() << " segments, "
+			<< camera.edges_decimated << " edges decimated, " << camera.marker_count << " markers, " << camera.edges_subpixel << " sub-pixel edges");
+		BENCHMARK(decimation ? "decimation" : "every edge") {
+			return draw();
+		};
+	}
+
+	for (Model3D* teapot : teapots) {
+		delete teapot;
+	}
+}
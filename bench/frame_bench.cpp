@@ -0,0 +1,124 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "camera.h"
+
+/* The scene set up by Renderer::initModelsDemo, seen from the camera's starting position in Renderer::setup */
+struct ModelsDemoScene {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	std::vector<Model3D*> models = {
+		new Model3D("..\\models\\cow.obj", ofColor::white, ofVec3f(0, 0, -1), 0.2),
+		new Model3D("..\\models\\teapot.obj", ofColor::lightBlue, ofVec3f(2, 0, 0), 0.4),
+		new Model3D("..\\models\\cube.obj", ofColor::green, ofVec3f(-2, 0, 0), 1)
+	};
+
+	~ModelsDemoScene() {
+		for (Model3D* model : models) {
+			delete model;
+		}
+	}
+};
+
+/* Whether a projected point is inside the window. Points behind the camera are projected to out_of_bounds_point, which isn't */
+static bool onScreen(const Camera& camera, ofVec2f point) {
+	return point.x >= 0 && point.x <= camera.win_width && point.y >= 0 && point.y <= camera.win_height;
+}
+
+/* Counts the edges entirely on screen by transforming both endpoints of every edge, the way drawModel originally worked */
+static size_t countEdgesPerEdgeTransform(Camera& camera, const Model3D* model) {
+	size_t drawn = 0;
+	ofMatrix3x3 model_matrix = model->modelMatrix();
+	const std::vector<ofVec3f>& vertices = model->mesh->vertices;
+	model->mesh->edges.forEach([&](uint32_t vert0, uint32_t vert1) {
+		ofVec2f point0 = camera.transform(Model3D::applyMatrix(model_matrix, vertices[vert0]) + model->position);
+		ofVec2f point1 = camera.transform(Model3D::applyMatrix(model_matrix, vertices[vert1]) + model->position);
+		if (onScreen(camera, point0) && onScreen(camera, point1)) {
+			drawn++;
+		}
+	});
+	return drawn;
+}
+
+/* Counts the edges entirely on screen using the camera's projected vertex cache, the way drawModel works now */
+static size_t countEdgesProjectedOnce(Camera& camera, const Model3D* model) {
+	size_t drawn = 0;
+	camera.projectModel(model);
+	model->mesh->edges.forEach([&](uint32_t vert0, uint32_t vert1) {
+		if ((camera.vertex_outcodes[vert0] | camera.vertex_outcodes[vert1]) == 0) {
+			drawn++;
+		}
+	});
+	return drawn;
+}
+
+TEST_CASE("Frame: models demo vertex projection", "[!benchmark][frame]") {
+	ModelsDemoScene scene;
+
+	//Both paths must draw the same edges
+	for (Model3D* model : scene.models) {
+		REQUIRE(countEdgesPerEdgeTransform(scene.camera, model) == countEdgesProjectedOnce(scene.camera, model));
+	}
+
+	BENCHMARK("transform per edge endpoint") {
+		size_t drawn = 0;
+		for (Model3D* model : scene.models) {
+			drawn += countEdgesPerEdgeTransform(scene.camera, model);
+		}
+		return drawn;
+	};
+	BENCHMARK("transform per vertex") {
+		size_t drawn = 0;
+		for (Model3D* model : scene.models) {
+			drawn += countEdgesProjectedOnce(scene.camera, model);
+		}
+		return drawn;
+	};
+}
+
+/* Transforms a point the way Camera::transform did before the view matrix was cached, computing the rotation for every point */
+static ofVec2f transformWithoutViewMatrix(Camera& camera, ofVec3f point3d) {
+	float x = point3d.x - camera.position.x;
+	float y = point3d.y - camera.position.y;
+	float z = point3d.z - camera.position.z;
+	camera.rotateCoords(x, z, camera.rotation.x);
+	camera.rotateCoords(y, z, camera.rotation.y);
+	if (z < 0) {
+		z = camera.field_of_view / z;
+		return ofVec2f(camera.win_center.x - x * z, camera.win_center.y + y * z);
+	}
+	return camera.out_of_bounds_point;
+}
+
+TEST_CASE("Frame: camera transform of 100k points", "[!benchmark][frame]") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0.3f, -0.2f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	std::vector<ofVec3f> points;
+	for (int i = 0; i < 100000; i++) {
+		points.push_back(ofVec3f(std::sin(i * 0.37f) * 10, std::cos(i * 0.11f) * 10, std::sin(i * 0.23f) * 10));
+	}
+	std::vector<ofVec2f> projected(points.size());
+
+	BENCHMARK("rotation per point") {
+		for (size_t i = 0; i < points.size(); i++) {
+			projected[i] = transformWithoutViewMatrix(camera, points[i]);
+		}
+		return projected[0];
+	};
+	BENCHMARK("cached view matrix, batch") {
+		camera.transform(points.data(), projected.data(), points.size());
+		return projected[0];
+	};
+}
+
+TEST_CASE("Frame: models demo line batch", "[!benchmark][frame]") {
+	ModelsDemoScene scene;
+	LineBatch lines;
+
+	//Everything Renderer::draw does for the scene on the CPU, up to uploading the batch
+	BENCHMARK("collect models demo into one line batch") {
+		lines.clear();
+		for (Model3D* model : scene.models) {
+			scene.camera.drawModel(model, lines);
+		}
+		return lines.segmentCount();
+	};
+}
@@ -0,0 +1,68 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "gravity_solver.h"
+
+/* Small bodies scattered evenly through a ball */
+static BodyStore evenCluster(size_t count) {
+	BodyStore bodies;
+	bodies.resize(count);
+	std::srand(0);
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f direction = ofVec3f(ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1)).getNormalized();
+		float distance = 50 * std::cbrt(ofRandom(0, 1));
+		float mass = ofRandom(1, 10);
+		bodies.setBody(i, direction * distance, mass, 0.01f);
+	}
+	return bodies;
+}
+
+/* Runs a solver over the bodies and returns the force on each */
+static std::vector<ofVec3f> solverForces(GravitySolver& solver, BodyStore& bodies) {
+	std::vector<ofVec3f> forces;
+	solver.applyForces(bodies);
+	for (size_t i = 0; i < bodies.size(); i++) {
+		forces.push_back(bodies.force(i));
+	}
+	return forces;
+}
+
+TEST_CASE("Gravity kernel: scalar and AVX2 direct sums against Barnes-Hut", "[!benchmark][gravity_kernel]") {
+	if (!ProjectionKernel::supports(ProjectionKernel::AVX2)) {
+		WARN("AVX2 is not supported here");
+		return;
+	}
+
+	GravitySolver solver;
+	for (size_t count : { 1000, 5000, 20000 }) {
+		BodyStore bodies = evenCluster(count);
+
+		//Largest difference between the two direct sums, relative to the largest force
+		solver.path = ProjectionKernel::SCALAR;
+		std::vector<ofVec3f> scalar = solverForces(solver, bodies);
+		solver.path = ProjectionKernel::AVX2;
+		std::vector<ofVec3f> avx2 = solverForces(solver, bodies);
+		float largest = 0;
+		float difference = 0;
+		for (size_t i = 0; i < bodies.size(); i++) {
+			largest = std::max(largest, scalar[i].length());
+			difference = std::max(difference, (avx2[i] - scalar[i]).length());
+		}
+		WARN(count << " bodies: AVX2 differs from scalar by at most " << difference / largest << " of the largest force");
+
+		for (ProjectionKernel::Path path : { ProjectionKernel::SCALAR, ProjectionKernel::AVX2 }) {
+			solver.path = path;
+			BENCHMARK(std::string(path == ProjectionKernel::AVX2 ? "AVX2" : "scalar") + " direct, " + std::to_string(count) + " bodies") {
+				solver.applyForces(bodies);
+				return bodies.fxs[0];
+			};
+		}
+
+		solver.method = GravitySolver::BARNES_HUT;
+		BENCHMARK("Barnes-Hut, opening angle 0.5, " + std::to_string(count) + " bodies") {
+			solver.applyForces(bodies);
+			return bodies.fxs[0];
+		};
+		solver.method = GravitySolver::DIRECT;
+	}
+}
@@ -0,0 +1,78 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "gravity_solver.h"
+
+/* Small bodies scattered through a ball, denser toward the middle like a star cluster */
+static BodyStore starCluster(size_t count) {
+	BodyStore bodies;
+	bodies.resize(count);
+	std::srand(0);
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f direction = ofVec3f(ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1)).getNormalized();
+		float distance = 50 * std::pow(ofRandom(0, 1), 2.0f);
+		float mass = ofRandom(1, 10);
+		bodies.setBody(i, direction * distance, mass, 0.01f);
+	}
+	return bodies;
+}
+
+/* Runs a solver over the bodies and returns the force on each */
+static std::vector<ofVec3f> solverForces(GravitySolver& solver, BodyStore& bodies) {
+	std::vector<ofVec3f> forces;
+	solver.applyForces(bodies);
+	for (size_t i = 0; i < bodies.size(); i++) {
+		forces.push_back(bodies.force(i));
+	}
+	return forces;
+}
+
+/* Square root of the mean squared difference between two sets of forces, relative to the mean squared size of the reference forces */
+static float relativeError(const std::vector<ofVec3f>& forces, const std::vector<ofVec3f>& reference) {
+	double error = 0;
+	double size = 0;
+	for (size_t i = 0; i < forces.size(); i++) {
+		error += (forces[i] - reference[i]).lengthSquared();
+		size += reference[i].lengthSquared();
+	}
+	return (float)std::sqrt(error / size);
+}
+
+TEST_CASE("Gravity: accuracy and speed of Barnes-Hut against the direct sum", "[!benchmark][gravity]") {
+	GravitySolver solver;
+	BodyStore bodies = starCluster(10000);
+	std::vector<ofVec3f> direct = solverForces(solver, bodies);
+
+	BENCHMARK("direct, 10000 bodies") {
+		solver.applyForces(bodies);
+		return bodies.fxs[0];
+	};
+
+	solver.method = GravitySolver::BARNES_HUT;
+	for (float opening_angle : { 0.3f, 0.5f, 0.7f, 1.0f }) {
+		solver.opening_angle = opening_angle;
+		WARN("opening angle " << opening_angle << ": " << relativeError(solverForces(solver, bodies), direct) * 100 << "% RMS force error, "
+			<< solver.nodeCount() << " nodes");
+		BENCHMARK("Barnes-Hut, 10000 bodies, opening angle " + ofToString(opening_angle)) {
+			solver.applyForces(bodies);
+			return bodies.fxs[0];
+		};
+		}
+}
+
+TEST_CASE("Gravity: Barnes-Hut with 100,000 bodies", "[!benchmark][gravity]") {
+	GravitySolver solver;
+	solver.method = GravitySolver::BARNES_HUT;
+	BodyStore bodies = starCluster(100000);
+
+	BENCHMARK("Barnes-Hut, 100000 bodies, every thread") {
+		solver.applyForces(bodies);
+		return bodies.fxs[0];
+	};
+
+	solver.thread_count = 1;
+	BENCHMARK("Barnes-Hut, 100000 bodies, one thread") {
+		solver.applyForces(bodies);
+		return bodies.fxs[0];
+	};
+}
@@ -0,0 +1,62 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "camera.h"
+#include "depth_buffer.h"
+
+/* One large model filling most of the screen, as in the models demo up close */
+struct CloseUpScene {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0.3f, -0.2f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	DepthBuffer depth_buffer = DepthBuffer(1920, 1080);
+	Model3D model;
+
+	CloseUpScene(const std::string& obj_path, float size_scale) : model(obj_path, ofColor::white, ofVec3f(0, 0, 0), size_scale) {
+	}
+
+	/* Draws every edge of the model */
+	void drawWireframe(LineBatch& lines) {
+		lines.clear();
+		camera.drawModel(&model, lines);
+	}
+
+	/* Draws the model's faces into the depth buffer, then only the parts of its edges in front of them */
+	void drawHiddenLines(LineBatch& lines) {
+		lines.clear();
+		depth_buffer.clear();
+		camera.drawModelDepth(&model, depth_buffer);
+		depth_buffer.updateTiles();
+		camera.drawModel(&model, lines, &depth_buffer);
+	}
+};
+
+TEST_CASE("Hidden lines: a large model up close", "[!benchmark][hidden]") {
+	for (const std::pair<const char*, float>& model : { std::make_pair("..\\models\\teddy.obj", 0.08f), std::make_pair("..\\models\\pumpkin.obj", 0.025f) }) {
+		CloseUpScene scene = CloseUpScene(model.first, model.second);
+		LineBatch lines;
+
+		scene.drawWireframe(lines);
+		size_t all_segments = lines.segmentCount();
+		scene.drawHiddenLines(lines);
+		REQUIRE(lines.segmentCount() > 0);
+		WARN(model.first << ": " << scene.model.mesh->triangles.size() / 3 << " triangles, " << all_segments << " segments in wireframe, "
+			<< lines.segmentCount() << " with hidden lines, " << scene.depth_buffer.edges_rejected << " of " << scene.depth_buffer.edges_tested
+			<< " edges rejected by tiles");
+
+		BENCHMARK(std::string(model.first) + " wireframe") {
+			scene.drawWireframe(lines);
+			return lines.segmentCount();
+		};
+
+		BENCHMARK(std::string(model.first) + " hidden lines") {
+			scene.drawHiddenLines(lines);
+			return lines.segmentCount();
+		};
+
+		BENCHMARK(std::string(model.first) + " depth pass alone") {
+			scene.depth_buffer.clear();
+			scene.camera.drawModelDepth(&scene.model, scene.depth_buffer);
+			scene.depth_buffer.updateTiles();
+			return scene.depth_buffer.getDepth(960, 540);
+		};
+	}
+}
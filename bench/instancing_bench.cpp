@@ -0,0 +1,90 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include <unordered_map>
+
+#include "camera.h"
+#include "physics_body.h"
+#include "physics_world.h"
+#include "scene_bvh.h"
+
+TEST_CASE("Instancing: 10,000 balls from one sphere mesh", "[!benchmark][instancing]") {
+	Camera camera = Camera(ofVec3f(0, 0, 60), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+
+	//A box full of balls, as the box demo would have with its cap lifted
+	size_t loads_before = MeshRegistry::loadCount();
+	std::vector<PhysicsBody*> bodies;
+	std::vector<ModelInstance> instances;
+	for (int x = 0; x < 25; x++) {
+		for (int y = 0; y < 20; y++) {
+			for (int z = 0; z < 20; z++) {
+				ofVec3f position = ofVec3f(x - 12.0f, y - 10.0f, z - 10.0f) * 2;
+				bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor(x * 10, y * 12, z * 12), 1, position, ofVec3f(0, 0, 0), ofVec3f(0, 0, 0), 0.5f));
+				bodies.back()->rotate(ofVec3f(x * 0.1f, y * 0.2f, z * 0.3f));
+				instances.push_back(bodies.back()->instance());
+			}
+		}
+	}
+	const Mesh& mesh = *bodies[0]->mesh;
+	WARN(instances.size() << " balls sharing " << MeshRegistry::loadCount() - loads_before << " mesh load(s) of " << mesh.vertices.size()
+		<< " vertices, " << sizeof(ModelInstance) << " bytes per instance, " << sizeof(PhysicsBody) << " per PhysicsBody");
+
+	LineBatch lines;
+	BENCHMARK("drawModel for each body") {
+		lines.clear();
+		for (PhysicsBody* body : bodies) {
+			camera.drawModel(body, lines);
+		}
+		return lines.segmentCount();
+	};
+	BENCHMARK("drawInstances") {
+		lines.clear();
+		camera.drawInstances(mesh, instances, lines);
+		return lines.segmentCount();
+	};
+
+	//Finding the balls in view each frame: through a hierarchy over every model and a lookup of each model in view, the way
+	//Renderer::draw first did, against one pass over the physics world's bodies
+	PhysicsWorld world;
+	std::unordered_map<const Model3D*, uint32_t> body_indices;
+	std::vector<Model3D*> models;
+	for (PhysicsBody* body : bodies) {
+		body_indices[body] = (uint32_t)models.size();
+		models.push_back(body);
+		world.addBody(body);
+	}
+	SceneBVH bvh;
+	bvh.build(models);
+	std::vector<uint32_t> visible;
+	BENCHMARK("gather instances: refit, cull and look up each model") {
+		instances.clear();
+		visible.clear();
+		bvh.refit();
+		bvh.cullFrustum(camera, visible);
+		for (uint32_t index : visible) {
+			auto body = body_indices.find(models[index]);
+			if (body != body_indices.end()) {
+				instances.push_back(bodies[body->second]->instance());
+			}
+		}
+		return instances.size();
+	};
+	std::vector<uint32_t> others;
+	BENCHMARK("gather instances: one pass over the bodies, then cull") {
+		instances.clear();
+		others.clear();
+		world.bodyInstances(&mesh, instances, others);
+		size_t visible_count = 0;
+		for (const ModelInstance& instance : instances) {
+			if (camera.inFrustum(instance.position, mesh.bounding_radius * std::abs(instance.scale))) {
+				instances[visible_count++] = instance;
+			}
+		}
+		instances.resize(visible_count);
+		return instances.size();
+	};
+
+	for (PhysicsBody* body : bodies) {
+		delete body;
+	}
+}
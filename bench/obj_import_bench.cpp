@@ -0,0 +1,47 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#include "mesh.h"
+
+/* Writes a size x size grid of vertices, with two triangles per grid square, to an OBJ file */
+static void writeGridOBJ(const std::string& file_path, int size) {
+	std::ofstream obj_writer(file_path);
+	obj_writer << "# Generated grid for import benchmarks\n";
+	for (int row = 0; row < size; row++) {
+		for (int col = 0; col < size; col++) {
+			obj_writer << "v " << row * 0.01f << " " << std::sin(row * 0.1f) * std::cos(col * 0.1f) << " " << col * 0.01f << "\n";
+		}
+	}
+	for (int row = 0; row < size - 1; row++) {
+		for (int col = 0; col < size - 1; col++) {
+			int corner = row * size + col + 1;
+			obj_writer << "f " << corner << " " << corner + 1 << " " << corner + size << "\n";
+			obj_writer << "f " << corner + 1 << " " << corner + size + 1 << " " << corner + size << "\n";
+		}
+	}
+}
+
+TEST_CASE("OBJ import: thread scaling on a large mesh", "[!benchmark][obj][threads]") {
+	//About 30MB of text, 360k vertices and 720k triangles
+	std::string path = "bench_grid.obj";
+	writeGridOBJ(path, 600);
+	{
+		MappedFile obj_file(path);
+		REQUIRE(obj_file.isOpen());
+
+		unsigned max_threads = std::max(4u, std::thread::hardware_concurrency());
+		for (unsigned thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+			BENCHMARK(std::to_string(thread_count) + " thread(s)") {
+				Mesh mesh;
+			mesh.importOBJ(obj_file, thread_count);
+			return mesh.edges.size();
+			};
+		}
+	}
+
+	//The file has to be unmapped before it can be removed on Windows
+	std::remove(path.c_str());
+}
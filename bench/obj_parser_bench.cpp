@@ -0,0 +1,100 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#include "mesh.h"
+
+/* Reads vertices and triangles token by token with an fstream, the way Model3D::readFromOBJ originally did */
+static ObjContents streamParse(const std::string& file_path) {
+	ObjContents contents;
+	std::fstream obj_reader(file_path);
+	std::string file_line;
+	std::string int_string;
+	ofVec3f new_vector;
+
+	while (obj_reader >> file_line) {
+		if (file_line.size() == 1) {
+			if (file_line[0] == 'v') {
+				obj_reader >> new_vector.x;
+				obj_reader >> new_vector.y;
+				obj_reader >> new_vector.z;
+				contents.vertices.push_back(new_vector);
+			}
+			else if (file_line[0] == 'f') {
+				for (int i = 0; i < 3; i++) {
+					obj_reader >> file_line;
+					int j = 0;
+					while (isdigit(file_line[j])) {
+						int_string += file_line[j];
+						j++;
+					}
+					contents.triangles.push_back(stoi(int_string) - 1);
+					int_string = "";
+				}
+			}
+		}
+	}
+	return contents;
+}
+
+/* Maps the file and reads it with ObjParser */
+static ObjContents mappedParse(const std::string& file_path) {
+	ObjContents contents;
+	MappedFile obj_file(file_path);
+	ObjParser::parse(obj_file.begin(), obj_file.end(), contents);
+	return contents;
+}
+
+TEST_CASE("OBJ parsing: fstream tokens vs. mapped from_chars", "[!benchmark][obj]") {
+	for (std::string name : { "pumpkin", "cow", "head" }) {
+		std::string path = "..\\models\\" + name + ".obj";
+
+		//Both parsers must agree before their speed is compared
+		ObjContents expected = streamParse(path);
+		ObjContents actual = mappedParse(path);
+		REQUIRE(actual.triangles == expected.triangles);
+		REQUIRE(actual.vertices.size() == expected.vertices.size());
+
+		BENCHMARK("fstream " + name) {
+			return streamParse(path);
+		};
+		BENCHMARK("mapped " + name) {
+			return mappedParse(path);
+		};
+	}
+}
+
+/* Reads a mesh the way the registry does when a model is created */
+static size_t readMesh(const std::string& path) {
+	Mesh mesh;
+	mesh.readFromOBJ(path);
+	return mesh.edges.size();
+}
+
+TEST_CASE("OBJ import: full mesh import", "[!benchmark][obj]") {
+	for (std::string name : { "pumpkin", "cow", "teapot" }) {
+		std::string path = "..\\models\\" + name + ".obj";
+		BENCHMARK("Mesh " + name) {
+			//Time the OBJ path, not the binary cache
+			std::remove(MeshCache::cachePath(path).c_str());
+			return readMesh(path);
+		};
+	}
+}
+
+TEST_CASE("OBJ import: binary mesh cache", "[!benchmark][obj][cache]") {
+	std::string path = "..\\models\\cow.obj";
+
+	//Make sure the cache exists before timing
+	readMesh(path);
+
+	BENCHMARK("Mesh cow (cached)") {
+		return readMesh(path);
+	};
+	BENCHMARK("Mesh cow (uncached)") {
+		std::remove(MeshCache::cachePath(path).c_str());
+		return readMesh(path);
+	};
+}
@@ -0,0 +1,47 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "camera.h"
+
+TEST_CASE("Outlines: dense models seen from around them", "[!benchmark][outline]") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	LineBatch lines;
+
+	for (const std::pair<const char*, float>& model : { std::make_pair("..\\models\\cow.obj", 0.4f), std::make_pair("..\\models\\teddy.obj", 0.06f),
+		std::make_pair("..\\models\\pumpkin.obj", 0.02f) }) {
+		Model3D subject = Model3D(model.first, ofColor::white, ofVec3f(0, 0, 0), model.second);
+		const Mesh& mesh = *subject.mesh;
+
+		//Walk the model around a full turn in front of the camera and count the edges drawn each way
+		size_t all_segments = 0;
+		size_t outline_segments = 0;
+		for (int step = 0; step < 8; step++) {
+			subject.orientation = Quaternion::fromRotationVector(ofVec3f(0.3f, step * TWO_PI / 8, 0));
+			camera.outline_only = false;
+			lines.clear();
+			camera.drawModel(&subject, lines);
+			all_segments += lines.segmentCount();
+			camera.outline_only = true;
+			lines.clear();
+			camera.drawModel(&subject, lines);
+			outline_segments += lines.segmentCount();
+		}
+		WARN(model.first << ": " << mesh.edges.size() << " edges, " << mesh.crease_edges.size() << " creases, on average "
+			<< all_segments / 8 << " segments for every edge and " << outline_segments / 8 << " for the outline");
+
+		for (bool outline_only : { false, true }) {
+			camera.outline_only = outline_only;
+			BENCHMARK(std::string(model.first) + (outline_only ? " outline" : " every edge")) {
+				lines.clear();
+				camera.drawModel(&subject, lines);
+				return lines.segmentCount();
+			};
+		}
+
+		Mesh copy = mesh;
+		BENCHMARK(std::string(model.first) + " computeEdgeFaces") {
+			copy.computeEdgeFaces();
+			return copy.crease_edges.size();
+		};
+	}
+}
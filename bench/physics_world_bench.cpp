@@ -0,0 +1,94 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "physics_world.h"
+
+/* The box demo at a size that keeps about the same number of balls touching at every count: six walls, then the balls */
+static std::vector<Model3D*> boxDemoScene(size_t count) {
+	int box_size = (int)(20 * std::cbrt(count / 40.0f));
+	int wall_offset = (box_size + 1) / 2;
+	int wall_size = 2 * wall_offset + 1;
+	std::vector<Model3D*> scene_models = {
+		new Plane(ofVec3f(0, -wall_offset, 0), ofVec3f(0, 1, 0), ofColor::gray, wall_size),
+		new Plane(ofVec3f(0, wall_offset, 0), ofVec3f(0, -1, 0), ofColor::gray, wall_size),
+		new Plane(ofVec3f(wall_offset, 0, 0), ofVec3f(-1, 0, 0), ofColor::gray, wall_size),
+		new Plane(ofVec3f(-wall_offset, 0, 0), ofVec3f(1, 0, 0), ofColor::gray, wall_size),
+		new Plane(ofVec3f(0, 0, wall_offset), ofVec3f(0, 0, -1), ofColor::gray, wall_size),
+		new Plane(ofVec3f(0, 0, -wall_offset), ofVec3f(0, 0, 1), ofColor::gray, wall_size)
+	};
+	std::srand(0);
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f position = ofVec3f(ofRandom(-0.4f, 0.4f), ofRandom(-0.4f, 0.4f), ofRandom(-0.4f, 0.4f)) * box_size;
+		ofVec3f velocity = ofVec3f(ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1)) * box_size * 0.6f;
+		ofVec3f angular_vel = ofVec3f(ofRandom(-2, 2), ofRandom(-2, 2), ofRandom(-2, 2));
+		scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, ofRandom(1, 21), position, velocity, angular_vel, ofRandom(0.05f, 0.55f) * box_size / 20));
+	}
+	return scene_models;
+}
+
+TEST_CASE("Physics step: 1,000 and 10,000 balls in a box", "[!benchmark][physics]") {
+	for (size_t count : { 1000, 10000 }) {
+		std::vector<Model3D*> scene_models = boxDemoScene(count);
+		std::vector<PhysicsBody*> physics_bodies;
+		std::vector<Plane*> physics_planes;
+		CollisionGrid collision_grid;
+		BodyStore collision_store;
+		std::vector<std::pair<uint32_t, uint32_t>> collision_pairs;
+
+		//The way Renderer::updatePhysics used to step: sort the scene by casting every model, then call into each of them
+		BENCHMARK("casting the scene models, " + ofToString(count) + " balls") {
+			physics_bodies.clear();
+			physics_planes.clear();
+			for (Model3D* model : scene_models) {
+				if (PhysicsBody* body = dynamic_cast<PhysicsBody*>(model)) {
+					physics_bodies.push_back(body);
+				}
+				else if (Plane* plane = dynamic_cast<Plane*>(model)) {
+					physics_planes.push_back(plane);
+				}
+			}
+			collision_store.resize(physics_bodies.size());
+			for (size_t i = 0; i < physics_bodies.size(); i++) {
+				collision_store.setBody(i, physics_bodies[i]->position, physics_bodies[i]->mass, physics_bodies[i]->radius);
+			}
+			collision_grid.build(collision_store);
+			collision_grid.findPairs(collision_store, collision_pairs);
+			for (const std::pair<uint32_t, uint32_t>& pair : collision_pairs) {
+				physics_bodies[pair.first]->collideWithBody(physics_bodies[pair.second]);
+			}
+			for (PhysicsBody* body : physics_bodies) {
+				for (Plane* plane : physics_planes) {
+					body->collideWithPlane(plane);
+				}
+			}
+			for (PhysicsBody* body : physics_bodies) {
+				body->update(0.01f);
+				body->force = ofVec3f(0, 0, 0);
+			}
+			return physics_bodies.size();
+		};
+
+		PhysicsWorld world;
+		for (Model3D* model : scene_models) {
+			if (PhysicsBody* body = dynamic_cast<PhysicsBody*>(model)) {
+				world.addBody(body);
+			}
+			else {
+				world.addCollider(static_cast<Plane*>(model));
+			}
+		}
+		BENCHMARK("physics world step, " + ofToString(count) + " balls") {
+			world.step(0.01f, false);
+			return world.bodyCount();
+		};
+		BENCHMARK("physics world step and writing to the models, " + ofToString(count) + " balls") {
+			world.step(0.01f, false);
+			world.writeToModels();
+			return world.bodyCount();
+		};
+
+		for (Model3D* model : scene_models) {
+			delete model;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "camera.h"
+
+TEST_CASE("Projection kernel: one million vertices", "[!benchmark][projection]") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0.3f, -0.2f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	ProjectionParams params = camera.projectionParams(camera.view_matrix, Model3D::applyMatrix(camera.view_matrix, -camera.position));
+
+	//A scanned mesh sized point cloud, stored both ways
+	const size_t vertex_count = 1000000;
+	std::vector<ofVec3f> vertices(vertex_count);
+	std::vector<float> xs(vertex_count), ys(vertex_count), zs(vertex_count);
+	for (size_t i = 0; i < vertex_count; i++) {
+		vertices[i] = ofVec3f(std::sin(i * 0.37f) * 3, std::cos(i * 0.11f) * 3, std::sin(i * 0.23f) * 3);
+		xs[i] = vertices[i].x;
+		ys[i] = vertices[i].y;
+		zs[i] = vertices[i].z;
+	}
+	std::vector<ofVec2f> projected(vertex_count);
+	std::vector<uint8_t> outcodes(vertex_count);
+
+	BENCHMARK("Camera::transform and inBounds per vertex") {
+		for (size_t i = 0; i < vertex_count; i++) {
+			projected[i] = camera.transform(vertices[i]);
+			outcodes[i] = !camera.inBounds(projected[i]);
+		}
+		return outcodes[0];
+	};
+
+	for (ProjectionKernel::Path path : { ProjectionKernel::SCALAR, ProjectionKernel::SSE, ProjectionKernel::AVX2 }) {
+		if (!ProjectionKernel::supports(path)) {
+			continue;
+		}
+		std::string name = path == ProjectionKernel::SCALAR ? "scalar" : (path == ProjectionKernel::SSE ? "SSE" : "AVX2");
+		BENCHMARK("kernel, " + name) {
+			ProjectionKernel::project(xs.data(), ys.data(), zs.data(), vertex_count, params, projected.data(), outcodes.data(), path);
+			return outcodes[0];
+		};
+	}
+}
@@ -0,0 +1,140 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "scene_bvh.h"
+
+/* Static models on a square grid around the camera, side by side models along each edge, like a scene built up in the models demo */
+struct StaticCityScene {
+	Camera camera = Camera(ofVec3f(0, 1, 0), ofVec2f(0.3f, -0.1f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	std::vector<Model3D*> models;
+
+	StaticCityScene(int side = 100) {
+		const char* obj_paths[2] = { "..\\models\\cube.obj", "..\\models\\sphere.obj" };
+		for (int x = -side / 2; x < side - side / 2; x++) {
+			for (int z = -side / 2; z < side - side / 2; z++) {
+				models.push_back(new Model3D(obj_paths[(x + z) & 1], ofColor::white, ofVec3f(x * 4 + 2, 0, z * 4 + 2), 1));
+			}
+		}
+	}
+
+	~StaticCityScene() {
+		for (Model3D* model : models) {
+			delete model;
+		}
+	}
+};
+
+TEST_CASE("Scene BVH: 10,000 static models", "[!benchmark][bvh]") {
+	StaticCityScene scene;
+	SceneBVH bvh;
+	bvh.build(scene.models);
+	std::vector<uint32_t> visible;
+	bvh.cullFrustum(scene.camera, visible);
+	WARN(scene.models.size() << " models, " << visible.size() << " in view, " << bvh.nodeCount() << " nodes");
+
+	BENCHMARK("build") {
+		bvh.build(scene.models);
+		return bvh.nodeCount();
+	};
+	BENCHMARK("refit") {
+		bvh.refit();
+		return bvh.nodeCount();
+	};
+
+	BENCHMARK("cull, every model") {
+		visible.clear();
+		for (uint32_t i = 0; i < scene.models.size(); i++) {
+			if (scene.camera.inFrustum(scene.models[i]->position, scene.models[i]->boundingRadius())) {
+				visible.push_back(i);
+			}
+		}
+		return visible.size();
+	};
+	BENCHMARK("cull, hierarchy") {
+		visible.clear();
+		bvh.cullFrustum(scene.camera, visible);
+		return visible.size();
+	};
+
+	//Grabbing from the middle of the screen, the way Renderer::mouseDragged does
+	ofVec2f mouse = ofVec2f(1000, 560);
+	float grab_range = 200;
+	BENCHMARK("grab, every model") {
+		Model3D* grabbed = nullptr;
+		float min_mouse_dist = std::numeric_limits<float>::max();
+		for (Model3D* model : scene.models) {
+			float mouse_dist = (mouse - scene.camera.transform(model->position)).length();
+			if (mouse_dist < grab_range / (scene.camera.position - model->position).length() && mouse_dist < min_mouse_dist) {
+				grabbed = model;
+				min_mouse_dist = mouse_dist;
+			}
+		}
+		return grabbed;
+	};
+	std::vector<uint32_t> candidates;
+	BENCHMARK("grab, hierarchy") {
+		candidates.clear();
+		bvh.queryRay(scene.camera.position, scene.camera.screenRay(mouse), grab_range / scene.camera.field_of_view, candidates);
+		Model3D* grabbed = nullptr;
+		float min_mouse_dist = std::numeric_limits<float>::max();
+		for (uint32_t index : candidates) {
+			Model3D* model = scene.models[index];
+			float mouse_dist = (mouse - scene.camera.transform(model->position)).length();
+			if (mouse_dist < grab_range / (scene.camera.position - model->position).length() && mouse_dist < min_mouse_dist) {
+				grabbed = model;
+				min_mouse_dist = mouse_dist;
+			}
+		}
+		return grabbed;
+	};
+
+	//Everything Renderer::draw does on the CPU before handing the lines over. Nothing moves, so there is nothing to refit,
+	//and the camera doesn't test the models the hierarchy kept again
+	LineBatch lines;
+	scene.camera.frustum_culling = false;
+	BENCHMARK("whole frame: cull and draw") {
+		lines.clear();
+		visible.clear();
+		bvh.cullFrustum(scene.camera, visible);
+		for (uint32_t index : visible) {
+			scene.camera.drawModel(scene.models[index], lines);
+		}
+		return lines.segmentCount();
+	};
+}
+
+/* Where the hierarchy starts to beat testing every model, which sets Renderer::BVH_CULL_MIN_MODELS */
+TEST_CASE("Scene BVH: culling against the linear scan by scene size", "[!benchmark][bvh]") {
+	for (int side : { 10, 20, 32, 45, 64, 100, 300 }) {
+		StaticCityScene scene(side);
+		SceneBVH bvh;
+		bvh.build(scene.models);
+		std::vector<uint32_t> visible;
+
+		//Looking across the grid sees about a third of it. Looking down from above sees the same small patch of it at any size
+		for (float pitch : { -0.1f, -1.4f }) {
+			scene.camera.rotation = ofVec2f(0.3f, pitch);
+			scene.camera.position = ofVec3f(0, pitch < -1 ? 20.0f : 1.0f, 0);
+			scene.camera.computeLocalBasis();
+			scene.camera.updateViewMatrix();
+			visible.clear();
+			bvh.cullFrustum(scene.camera, visible);
+			std::string name = std::to_string(scene.models.size()) + " models, " + std::to_string(visible.size()) + " in view";
+
+			BENCHMARK("cull, every model, " + name) {
+				visible.clear();
+				for (uint32_t i = 0; i < scene.models.size(); i++) {
+					if (scene.camera.inFrustum(scene.models[i]->position, scene.models[i]->boundingRadius())) {
+						visible.push_back(i);
+					}
+				}
+				return visible.size();
+			};
+			BENCHMARK("cull, hierarchy, " + name) {
+				visible.clear();
+				bvh.cullFrustum(scene.camera, visible);
+				return visible.size();
+			};
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "../test/catch.hpp"
+
+#include "camera.h"
+#include "software_rasterizer.h"
+
+/* Rasterizes one model filling most of a 1920x1080 screen, with and without anti-aliasing, on one thread and on every core */
+static void benchmarkModel(const std::string& obj_path, float size_scale) {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	Model3D model = Model3D(obj_path, ofColor::white, ofVec3f(0, 0, 0), size_scale);
+	model.rotate(ofVec3f(0.3f, 0.5f, 0));
+	LineBatch lines;
+	camera.drawModel(&model, lines);
+	WARN(obj_path << ": " << lines.segmentCount() << " segments");
+
+	SoftwareRasterizer rasterizer = SoftwareRasterizer(1920, 1080);
+	std::vector<unsigned> thread_counts = { 1 };
+	if (rasterizer.thread_count > 1) {
+		thread_counts.push_back(rasterizer.thread_count);
+	}
+	for (unsigned thread_count : thread_counts) {
+		for (bool anti_aliasing : { false, true }) {
+			rasterizer.thread_count = thread_count;
+			rasterizer.anti_aliasing = anti_aliasing;
+			BENCHMARK(obj_path + ", " + std::to_string(thread_count) + " thread(s)" + (anti_aliasing ? ", anti-aliased" : "")) {
+				rasterizer.rasterize(lines);
+				return rasterizer.getPixel(960, 540);
+			};
+		}
+	}
+}
+
+TEST_CASE("Software rasterizer: teapot at 1920x1080", "[!benchmark][raster]") {
+	benchmarkModel("..\\models\\teapot.obj", 1.0f);
+}
+
+TEST_CASE("Software rasterizer: cow at 1920x1080", "[!benchmark][raster]") {
+	benchmarkModel("..\\models\\cow.obj", 0.6f);
+}
@@ -0,0 +1,51 @@
+#include "body_store.h"
+
+void BodyStore::resize(size_t count_) {
+	size_t padded_size = (count_ + PADDING - 1) / PADDING * PADDING;
+	for (std::vector<float>* values : { &xs, &ys, &zs, &masses, &radii, &fxs, &fys, &fzs }) {
+		values->resize(padded_size, 0);
+	}
+
+	//Bodies that used to be padding start out like any other new body
+	for (size_t i = count; i < count_; i++) {
+		xs[i] = ys[i] = zs[i] = 0;
+	}
+
+	//Comparisons with a position that is not a number are always false, so padding is never counted as far enough away to pull on anything
+	for (size_t i = count_; i < padded_size; i++) {
+		xs[i] = ys[i] = zs[i] = std::numeric_limits<float>::quiet_NaN();
+		masses[i] = 0;
+		radii[i] = 0;
+	}
+	count = count_;
+}
+
+size_t BodyStore::size() const {
+	return count;
+}
+
+size_t BodyStore::paddedSize() const {
+	return xs.size();
+}
+
+void BodyStore::setBody(size_t body, const ofVec3f& position, float mass, float radius) {
+	xs[body] = position.x;
+	ys[body] = position.y;
+	zs[body] = position.z;
+	masses[body] = mass;
+	radii[body] = radius;
+}
+
+ofVec3f BodyStore::position(size_t body) const {
+	return ofVec3f(xs[body], ys[body], zs[body]);
+}
+
+ofVec3f BodyStore::force(size_t body) const {
+	return ofVec3f(fxs[body], fys[body], fzs[body]);
+}
+
+void BodyStore::setForce(size_t body, const ofVec3f& force) {
+	fxs[body] = force.x;
+	fys[body] = force.y;
+	fzs[body] = force.z;
+}
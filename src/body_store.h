@@ -0,0 +1,45 @@
+// BODY STORE - Defines the BodyStore class - the positions, masses, radii and forces of many bodies, kept in separate arrays for SIMD code
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "ofMain.h"
+
+class BodyStore {
+
+private:
+	size_t count = 0;	/* Number of bodies stored, not counting padding */
+
+public:
+	static const size_t PADDING = 8;	/* The arrays are padded to a multiple of this many bodies, so SIMD code can always load whole registers */
+
+	// One entry per body, then padding bodies that have no mass and a position that is not a number, so they never touch or pull anything
+	std::vector<float> xs, ys, zs;		/* Position components */
+	std::vector<float> masses;		/* Masses */
+	std::vector<float> radii;		/* Radii used to tell whether two bodies are touching */
+	std::vector<float> fxs, fys, fzs;	/* Force components, written by whatever computes the forces */
+
+	/* Changes the number of bodies stored. New bodies are at the origin with no mass, and the padding is reset */
+	void resize(size_t count_);
+
+	/* Returns the number of bodies stored, not counting padding */
+	size_t size() const;
+
+	/* Returns the length of every array, including padding */
+	size_t paddedSize() const;
+
+	/* Sets the position, mass and radius of one body */
+	void setBody(size_t body, const ofVec3f& position, float mass, float radius);
+
+	/* Returns the position of one body */
+	ofVec3f position(size_t body) const;
+
+	/* Returns the force on one body */
+	ofVec3f force(size_t body) const;
+
+	/* Sets the force on one body */
+	void setForce(size_t body, const ofVec3f& force);
+};
@@ -15,7 +15,7 @@ Camera::Camera(ofVec3f position_, ofVec2f rotation_, float max_vertical_angle_,
 	mouse_sensitivity = mouse_sensitivity_;
 	field_of_view = field_of_view_;
 
-	//Initialize the local basis
+	//Initialize the local basis and view matrix
 	computeLocalBasis();
 
 	//Setup window parameters
@@ -56,31 +56,27 @@ void Camera::update(ofVec3f move_direction, ofVec2f rotation_change, bool mouse_
 void Camera::zoom(float zoom_scale) {
 	//Change the field of view exponentially
 	field_of_view *= std::powf(zoom_speed, zoom_scale);
+	updateViewMatrix();
 }
 
 ofVec2f Camera::transform(ofVec3f point3d) {
 	// 3d transformation equations from https://www.scratchapixel.com/lessons/3d-basic-rendering/computing-pixel-coordinates-of-3d-point
 	// and https://www.youtube.com/watch?v=g4E9iq0BixA
 
-	//Recenter points based on camera position, mazing camera.position the new origin
-	float x = point3d.x - position.x;
-	float y = point3d.y - position.y;
-	float z = point3d.z - position.z;
+	//Recenter the point based on camera position, making camera.position the new origin, then rotate and scale it into view space
+	return project(Model3D::applyMatrix(view_matrix, point3d - position));
+}
 
-	//Rotate x and z by camera.rotation[0] about the origin, then y and z by camera.rotation[1]
-	rotateCoords(x, z, rotation.x);
-	rotateCoords(y, z, rotation.y);
+void Camera::transform(const ofVec3f* in, ofVec2f* out, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		out[i] = project(Model3D::applyMatrix(view_matrix, in[i] - position));
+	}
+}
 
+ofVec2f Camera::project(ofVec3f view_point) {
 	//Check if the coordinate is in front of the camera
-	if (z < 0) {
-
-		//Scale x and y depending on how far the point is from the camera
-		z = field_of_view / z;
-		x *= z;
-		y *= z;
-
-		//Adjust point with respect to the screen center. Subtract from x-center and add to y-center to maintain proper coordinate system
-		return ofVec2f(win_center.x - x, win_center.y + y);
+	if (view_point.z < -near_plane) {
+		return perspective(view_point);
 	}
 	else {
 		//Return an out of bounds point to indicate that it should not be drawn
@@ -88,6 +84,14 @@ ofVec2f Camera::transform(ofVec3f point3d) {
 	}
 }
 
+ofVec2f Camera::perspective(ofVec3f view_point) {
+	//Scale x and y depending on how far the point is from the camera. field_of_view is already part of the view matrix
+	float depth_scale = 1.0f / view_point.z;
+
+	//Adjust point with respect to the screen center. Subtract from x-center and add to y-center to maintain proper coordinate system
+	return ofVec2f(win_center.x - view_point.x * depth_scale, win_center.y + view_point.y * depth_scale);
+}
+
 void Camera::rotateCoords(float& coord0, float& coord1, float angle) {
 	//Rotation equation from https://www.youtube.com/watch?v=g4E9iq0BixA
 	float temp = coord0;
@@ -100,19 +104,436 @@ bool Camera::inBounds(ofVec2f point2d) {
 	return (point2d.x >= -1 * win_margin[0] && point2d.x <= win_width + win_margin[0]) && (point2d.y >= -1 * win_margin[1] && point2d.y <= win_height + win_margin[1]);
 }
 
-void Camera::drawModel(Model3D* model) {
-	ofSetColor(model->color);
-	//Draw all edges of the given model
-	ofVec2f point0;
-	ofVec2f point1;
-	for (ofVec2f edge : model->edges) {
-		//Transform the two vertices indicated by the current edge
-		point0 = transform(model->vertices[(int)edge.x] + model->position);
-		point1 = transform(model->vertices[(int)edge.y] + model->position);
+ProjectionParams Camera::projectionParams(const ofMatrix3x3& matrix, ofVec3f offset) {
+	ProjectionParams params;
+	for (int i = 0; i < 9; i++) {
+		params.matrix[i] = matrix[i];
+	}
+	params.offset[0] = offset.x;
+	params.offset[1] = offset.y;
+	params.offset[2] = offset.z;
+	params.near_z = -near_plane;
+	params.center_x = win_center.x;
+	params.center_y = win_center.y;
+
+	//Clip to exactly the window. Edges crossing its border are cut there rather than drawn past it
+	params.min_x = 0;
+	params.max_x = win_width;
+	params.min_y = 0;
+	params.max_y = win_height;
+	params.out_x = out_of_bounds_point.x;
+	params.out_y = out_of_bounds_point.y;
+	return params;
+}
+
+ofVec3f Camera::screenRay(ofVec2f screen_point) const {
+	//Undo perspective() for a point one unit in front of the camera, then undo the view matrix. Its rows are the camera's axes,
+	//the first two scaled by field_of_view, so the inverse rotation is the transpose
+	float x = (screen_point.x - win_center.x) / (field_of_view * field_of_view);
+	float y = (win_center.y - screen_point.y) / (field_of_view * field_of_view);
+	ofVec3f direction = ofVec3f(view_matrix[0] * x + view_matrix[3] * y - view_matrix[6],
+		view_matrix[1] * x + view_matrix[4] * y - view_matrix[7],
+		view_matrix[2] * x + view_matrix[5] * y - view_matrix[8]);
+	return direction.getNormalized();
+}
+
+Camera::FrustumOverlap Camera::frustumOverlap(ofVec3f center, float radius) const {
+	//The view matrix scales x and y by field_of_view, so divide it back out to measure real distances
+	ofVec3f view_center = Model3D::applyMatrix(view_matrix, center - position);
+	float x = view_center.x / field_of_view;
+	float y = view_center.y / field_of_view;
+	float z = view_center.z;
+
+	//Entirely behind the near plane
+	if (z - radius >= -near_plane) {
+		return OUTSIDE;
+	}
+
+	//A point is on screen when |x| <= slope * -z, where slope is how far the window reaches sideways per unit of depth.
+	//Dividing by the length of the plane's normal gives the sphere center's actual distance outside each side
+	float slope_x = win_center.x / field_of_view;
+	float slope_y = win_center.y / field_of_view;
+	float outside_x = (std::abs(x) + slope_x * z) / std::sqrt(1 + slope_x * slope_x);
+	float outside_y = (std::abs(y) + slope_y * z) / std::sqrt(1 + slope_y * slope_y);
+	if (outside_x >= radius || outside_y >= radius) {
+		return OUTSIDE;
+	}
+	if (z + radius < -near_plane && outside_x <= -radius && outside_y <= -radius) {
+		return INSIDE;
+	}
+	return INTERSECTING;
+}
+
+bool Camera::inFrustum(ofVec3f center, float radius) const {
+	return frustumOverlap(center, radius) != OUTSIDE;
+}
+
+float Camera::projectedRadius(ofVec3f center, float radius) const {
+	//Only the distance in front of the camera matters, which is the unscaled last row of the view matrix
+	ofVec3f offset = center - position;
+	float distance = -(view_matrix[6] * offset.x + view_matrix[7] * offset.y + view_matrix[8] * offset.z);
+	if (distance <= radius) {
+		return std::numeric_limits<float>::infinity();
+	}
+	return field_of_view * radius / distance;
+}
+
+void Camera::resetDrawCounters() {
+	edges_decimated = 0;
+	edges_subpixel = 0;
+	marker_count = 0;
+}
+
+void Camera::projectModel(const Model3D* model) {
+	projectInstance(*model->mesh, model->instance());
+}
+
+void Camera::projectInstance(const Mesh& mesh, const ModelInstance& instance) {
+	//Combine the instance's scale and rotation with the camera's view matrix once, rather than once per vertex
+	model_view_matrix = view_matrix * instance.modelMatrix();
+	model_view_offset = Model3D::applyMatrix(view_matrix, instance.position - position);
+	const std::vector<ofVec3f>& vertices = mesh.vertices;
+	ProjectionParams params = projectionParams(model_view_matrix, model_view_offset);
 
-		//Only draw the edge if both points are in bounds
-		if (inBounds(point0) && inBounds(point1)) {
-			ofDrawLine(point0, point1);
+	//resize() keeps the existing capacity, so this only allocates when a bigger model comes along
+	projected_vertices.resize(vertices.size());
+	vertex_outcodes.resize(vertices.size());
+
+	//Each vertex is shared by several edges, but only needs to be transformed once. Meshes with their components split out go through the SIMD kernel
+	if (mesh.hasVertexComponents()) {
+		ProjectionKernel::project(mesh.vertex_xs.data(), mesh.vertex_ys.data(), mesh.vertex_zs.data(), vertices.size(),
+			params, projected_vertices.data(), vertex_outcodes.data(), projection_path);
+		return;
+	}
+	for (size_t i = 0; i < vertices.size(); i++) {
+		ofVec3f view_point = Model3D::applyMatrix(model_view_matrix, vertices[i]) + model_view_offset;
+		projected_vertices[i] = project(view_point);
+		vertex_outcodes[i] = ProjectionKernel::outcode(view_point.z, projected_vertices[i], params);
+	}
+}
+
+bool Camera::clipToNearPlane(ofVec3f& view_point0, ofVec3f& view_point1) {
+	float near_z = -near_plane;
+	bool in_front0 = view_point0.z < near_z;
+	bool in_front1 = view_point1.z < near_z;
+	if (!in_front0 && !in_front1) {
+		return false;
+	}
+
+	//Move the end behind the plane along the segment to where it crosses the plane. The view matrix is linear, so this is the same
+	//point as cutting the edge in world space
+	if (!in_front0 || !in_front1) {
+		float t = (near_z - view_point0.z) / (view_point1.z - view_point0.z);
+		ofVec3f crossing = view_point0 + (view_point1 - view_point0) * t;
+		crossing.z = near_z;
+		if (in_front0) {
+			view_point1 = crossing;
+		}
+		else {
+			view_point0 = crossing;
+		}
+	}
+	return true;
+}
+
+bool Camera::clipToViewport(ofVec2f& point0, ofVec2f& point1, float* depth0, float* depth1) {
+	//A segment that is not a number or infinitely long can't be clipped
+	if (!std::isfinite(point0.x) || !std::isfinite(point0.y) || !std::isfinite(point1.x) || !std::isfinite(point1.y)) {
+		return false;
+	}
+
+	// Liang-Barsky clipping. Along the segment point0 + t * (point1 - point0), find the range of t inside each edge of the window
+	float dx = point1.x - point0.x;
+	float dy = point1.y - point0.y;
+	float directions[4] = { -dx, dx, -dy, dy };
+	float distances[4] = { point0.x, win_width - point0.x, point0.y, win_height - point0.y };
+	float t_start = 0;
+	float t_end = 1;
+	for (int i = 0; i < 4; i++) {
+		if (directions[i] == 0) {
+			//Parallel to this edge, so either entirely inside or entirely outside it
+			if (distances[i] < 0) {
+				return false;
+			}
+			continue;
+		}
+		float t = distances[i] / directions[i];
+		if (directions[i] < 0) {
+			//Entering through this edge
+			t_start = std::max(t_start, t);
+		}
+		else {
+			//Leaving through this edge
+			t_end = std::min(t_end, t);
+		}
+		if (t_start > t_end) {
+			return false;
+		}
+	}
+
+	ofVec2f start = point0 + ofVec2f(dx, dy) * t_start;
+	point1 = point0 + ofVec2f(dx, dy) * t_end;
+	point0 = start;
+
+	//Inverse depth changes linearly across the screen, so it is cut at the same fractions of the segment
+	if (depth0 != nullptr && depth1 != nullptr) {
+		float depth_start = *depth0 + (*depth1 - *depth0) * t_start;
+		*depth1 = *depth0 + (*depth1 - *depth0) * t_end;
+		*depth0 = depth_start;
+	}
+	return true;
+}
+
+void Camera::projectVertexDepths(const Mesh& mesh) {
+	//Only the view space z is needed, which is the last row of the model-view matrix
+	const std::vector<ofVec3f>& vertices = mesh.vertices;
+	vertex_depths.resize(vertices.size());
+	for (size_t i = 0; i < vertices.size(); i++) {
+		float view_z = model_view_matrix[6] * vertices[i].x + model_view_matrix[7] * vertices[i].y + model_view_matrix[8] * vertices[i].z + model_view_offset.z;
+		vertex_depths[i] = view_z < -near_plane ? -1.0f / view_z : 0.0f;
+	}
+}
+
+int Camera::clipTriangleToNearPlane(const ofVec3f triangle[3], ofVec3f clipped[4]) {
+	//Walk around the triangle, keeping the corners in front of the plane and adding a corner wherever a side crosses it
+	float near_z = -near_plane;
+	int count = 0;
+	for (int i = 0; i < 3; i++) {
+		const ofVec3f& current = triangle[i];
+		const ofVec3f& next = triangle[(i + 1) % 3];
+		bool current_in_front = current.z < near_z;
+		bool next_in_front = next.z < near_z;
+		if (current_in_front) {
+			clipped[count++] = current;
+		}
+		if (current_in_front != next_in_front) {
+			float t = (near_z - current.z) / (next.z - current.z);
+			clipped[count] = current + (next - current) * t;
+			clipped[count++].z = near_z;
+		}
+	}
+	return count;
+}
+
+bool Camera::drawModelDepth(Model3D* model, DepthBuffer& depth_buffer) {
+	return drawInstanceDepth(*model->mesh, model->instance(), depth_buffer);
+}
+
+bool Camera::drawInstanceDepth(const Mesh& mesh, const ModelInstance& instance, DepthBuffer& depth_buffer) {
+	if (frustum_culling && !inFrustum(instance.position, mesh.bounding_radius * std::abs(instance.scale))) {
+		return false;
+	}
+	projectInstance(mesh, instance);
+	projectVertexDepths(mesh);
+	const std::vector<ofVec3f>& vertices = mesh.vertices;
+	const std::vector<uint32_t>& triangles = mesh.triangles;
+
+	for (size_t i = 0; i + 3 <= triangles.size(); i += 3) {
+		uint32_t vert0 = triangles[i];
+		uint32_t vert1 = triangles[i + 1];
+		uint32_t vert2 = triangles[i + 2];
+		uint8_t outcode0 = vertex_outcodes[vert0];
+		uint8_t outcode1 = vertex_outcodes[vert1];
+		uint8_t outcode2 = vertex_outcodes[vert2];
+
+		//Every corner past the same side of the view
+		if ((outcode0 & outcode1 & outcode2) != 0) {
+			continue;
+		}
+		if (((outcode0 | outcode1 | outcode2) & ProjectionKernel::BEHIND) == 0) {
+			depth_buffer.rasterizeTriangle(projected_vertices[vert0], vertex_depths[vert0], projected_vertices[vert1], vertex_depths[vert1],
+				projected_vertices[vert2], vertex_depths[vert2]);
+			continue;
+		}
+
+		//Part of the face is behind the camera. Cut that part off, leaving three or four corners, and draw them as a fan of triangles
+		ofVec3f corners[3] = {
+			Model3D::applyMatrix(model_view_matrix, vertices[vert0]) + model_view_offset,
+			Model3D::applyMatrix(model_view_matrix, vertices[vert1]) + model_view_offset,
+			Model3D::applyMatrix(model_view_matrix, vertices[vert2]) + model_view_offset
+		};
+		ofVec3f clipped[4];
+		int corner_count = clipTriangleToNearPlane(corners, clipped);
+		for (int corner = 1; corner + 1 < corner_count; corner++) {
+			depth_buffer.rasterizeTriangle(perspective(clipped[0]), -1.0f / clipped[0].z, perspective(clipped[corner]), -1.0f / clipped[corner].z,
+				perspective(clipped[corner + 1]), -1.0f / clipped[corner + 1].z);
+		}
+	}
+	return true;
+}
+
+size_t Camera::drawInstancesDepth(const Mesh& mesh, const std::vector<ModelInstance>& instances, DepthBuffer& depth_buffer) {
+	size_t culled = 0;
+	for (const ModelInstance& instance : instances) {
+		culled += !drawInstanceDepth(mesh, instance, depth_buffer);
+	}
+	return culled;
+}
+
+bool Camera::drawModel(Model3D* model, LineBatch& lines, DepthBuffer* depth_buffer) {
+	return drawInstance(*model->mesh, model->instance(), lines, depth_buffer);
+}
+
+bool Camera::drawInstance(const Mesh& mesh, const ModelInstance& instance, LineBatch& lines, DepthBuffer* depth_buffer) {
+	//Skip all vertex work for instances that can't be seen
+	float radius = mesh.bounding_radius * std::abs(instance.scale);
+	if (frustum_culling && !inFrustum(instance.position, radius)) {
+		return false;
+	}
+	ofFloatColor color = instance.color;
+
+	//An instance only a few pixels across is drawn as a square around its center instead, without projecting any vertices
+	float screen_radius = projectedRadius(instance.position, radius);
+	if (screen_radius < marker_radius) {
+		drawMarker(instance.position, std::max(screen_radius, 0.5f), color, lines, depth_buffer);
+		edges_decimated += mesh.edges.size();
+		marker_count++;
+		return true;
+	}
+
+	//Transform every vertex up front, so the edges only have to look their endpoints up
+	projectInstance(mesh, instance);
+	if (depth_buffer != nullptr) {
+		projectVertexDepths(mesh);
+	}
+	const std::vector<ofVec3f>& vertices = mesh.vertices;
+
+	auto draw_edge = [&](uint32_t vert0, uint32_t vert1) {
+		uint8_t outcode0 = vertex_outcodes[vert0];
+		uint8_t outcode1 = vertex_outcodes[vert1];
+
+		//Both ends are past the same side of the view (or both behind the camera), so none of the edge is visible
+		if ((outcode0 & outcode1) != 0) {
+			return;
+		}
+
+		//Both ends are visible, so the whole edge is, unless it is behind a face or too short to see
+		if ((outcode0 | outcode1) == 0) {
+			ofVec2f difference = projected_vertices[vert1] - projected_vertices[vert0];
+			if (std::abs(difference.x) < min_edge_length && std::abs(difference.y) < min_edge_length) {
+				edges_subpixel++;
+				return;
+			}
+			if (depth_buffer == nullptr) {
+				lines.addSegment(projected_vertices[vert0], projected_vertices[vert1], color);
+			}
+			else {
+				depth_buffer->addVisibleParts(projected_vertices[vert0], vertex_depths[vert0], projected_vertices[vert1], vertex_depths[vert1], color, lines);
+			}
+			return;
+		}
+
+		//Otherwise part of the edge may be visible. An end behind the camera has no screen position, so cut the edge at the near plane first
+		ofVec2f point0 = projected_vertices[vert0];
+		ofVec2f point1 = projected_vertices[vert1];
+		float depth0 = depth_buffer != nullptr ? vertex_depths[vert0] : 0;
+		float depth1 = depth_buffer != nullptr ? vertex_depths[vert1] : 0;
+		if ((outcode0 | outcode1) & ProjectionKernel::BEHIND) {
+			ofVec3f view_point0 = Model3D::applyMatrix(model_view_matrix, vertices[vert0]) + model_view_offset;
+			ofVec3f view_point1 = Model3D::applyMatrix(model_view_matrix, vertices[vert1]) + model_view_offset;
+			if (!clipToNearPlane(view_point0, view_point1)) {
+				return;
+			}
+			point0 = perspective(view_point0);
+			point1 = perspective(view_point1);
+			depth0 = -1.0f / view_point0.z;
+			depth1 = -1.0f / view_point1.z;
+		}
+
+		//Then cut it at the edges of the window. Straight lines stay straight under projection, so this is exact
+		if (!clipToViewport(point0, point1, &depth0, &depth1)) {
+			return;
+		}
+		if (depth_buffer == nullptr) {
+			lines.addSegment(point0, point1, color);
+		}
+		else {
+			depth_buffer->addVisibleParts(point0, depth0, point1, depth1, color, lines);
+		}
+	};
+
+	//Outline mode only applies to meshes with faces. Without them there is no outline to find, so every edge is drawn
+	if (outline_only && !mesh.edge_faces.empty()) {
+		findOutlineEdges(mesh, instance);
+		for (uint32_t index : outline_edges) {
+			Edge edge = mesh.edges[index];
+			draw_edge(edge.v0, edge.v1);
+		}
+	}
+	//A small instance draws as many of its most important edges as its share of the decimation area
+	else if (screen_radius < decimation_radius && !mesh.edges_by_priority.empty()) {
+		float area_fraction = (screen_radius / decimation_radius) * (screen_radius / decimation_radius);
+		size_t kept = std::min(mesh.edges_by_priority.size(), (size_t)std::ceil(mesh.edges_by_priority.size() * area_fraction));
+		for (size_t i = 0; i < kept; i++) {
+			Edge edge = mesh.edges[mesh.edges_by_priority[i]];
+			draw_edge(edge.v0, edge.v1);
+		}
+		edges_decimated += mesh.edges_by_priority.size() - kept;
+	}
+	else {
+		mesh.edges.forEach(draw_edge);
+	}
+	return true;
+}
+
+void Camera::drawMarker(ofVec3f center, float screen_radius, const ofFloatColor& color, LineBatch& lines, DepthBuffer* depth_buffer) {
+	ofVec3f view_center = Model3D::applyMatrix(view_matrix, center - position);
+	if (view_center.z >= -near_plane) {
+		return;
+	}
+	ofVec2f screen_center = perspective(view_center);
+	float depth = -1.0f / view_center.z;
+	ofVec2f corners[4] = {
+		screen_center + ofVec2f(-screen_radius, -screen_radius), screen_center + ofVec2f(screen_radius, -screen_radius),
+		screen_center + ofVec2f(screen_radius, screen_radius), screen_center + ofVec2f(-screen_radius, screen_radius)
+	};
+	for (int i = 0; i < 4; i++) {
+		ofVec2f point0 = corners[i];
+		ofVec2f point1 = corners[(i + 1) % 4];
+		float depth0 = depth;
+		float depth1 = depth;
+		if (!clipToViewport(point0, point1, &depth0, &depth1)) {
+			continue;
+		}
+		if (depth_buffer == nullptr) {
+			lines.addSegment(point0, point1, color);
+		}
+		else {
+			depth_buffer->addVisibleParts(point0, depth0, point1, depth1, color, lines);
+		}
+	}
+}
+
+size_t Camera::drawInstances(const Mesh& mesh, const std::vector<ModelInstance>& instances, LineBatch& lines, DepthBuffer* depth_buffer) {
+	//Every instance reuses the same scratch buffers, so there is never more than one instance's worth of projected vertices
+	size_t culled = 0;
+	for (const ModelInstance& instance : instances) {
+		culled += !drawInstance(mesh, instance, lines, depth_buffer);
+	}
+	return culled;
+}
+
+void Camera::findOutlineEdges(const Mesh& mesh, const ModelInstance& instance) {
+	//Move the camera into the mesh's own coordinates by undoing the instance's position, orientation and scale, so the face planes can be used as they are
+	ofVec3f offset = position - instance.position;
+	ofMatrix3x3 rotation = instance.orientation.toMatrix();
+	ofVec3f local_position = ofVec3f(
+		rotation[0] * offset.x + rotation[3] * offset.y + rotation[6] * offset.z,
+		rotation[1] * offset.x + rotation[4] * offset.y + rotation[7] * offset.z,
+		rotation[2] * offset.x + rotation[5] * offset.y + rotation[8] * offset.z
+	) / instance.scale;
+
+	//A face turns toward the camera when the camera is on the side of its plane its normal points to
+	faces_toward.resize(mesh.face_normals.size());
+	for (size_t face = 0; face < mesh.face_normals.size(); face++) {
+		faces_toward[face] = mesh.face_normals[face].dot(local_position) > mesh.face_offsets[face];
+	}
+
+	//Creases are drawn from every direction. A smooth edge is on the silhouette when exactly one of its faces turns toward the camera
+	outline_edges.assign(mesh.crease_edges.begin(), mesh.crease_edges.end());
+	for (uint32_t edge : mesh.smooth_edges) {
+		if (faces_toward[mesh.edge_faces[edge * 2]] != faces_toward[mesh.edge_faces[edge * 2 + 1]]) {
+			outline_edges.push_back(edge);
 		}
 	}
 }
@@ -128,4 +549,22 @@ void Camera::computeLocalBasis() {
 
 	// Take the cross product of the two  and normalize it - this will point straight up form the camera
 	local_basis[2] = local_basis[1].getCrossed(local_basis[0]).normalize();
+
+	//The view matrix shares the rotation, so keep the two in sync
+	updateViewMatrix();
+}
+
+void Camera::updateViewMatrix() {
+	//Same rotations as rotateCoords(x, z, rotation.x) followed by rotateCoords(y, z, rotation.y), multiplied out so the sines and cosines are only computed here
+	float cos_x = std::cos(rotation.x);
+	float sin_x = std::sin(rotation.x);
+	float cos_y = std::cos(rotation.y);
+	float sin_y = std::sin(rotation.y);
+
+	//Scaling x and y by field_of_view here saves a multiply per point in project()
+	view_matrix = ofMatrix3x3(
+		field_of_view * cos_x, 0, field_of_view * sin_x,
+		-field_of_view * sin_x * sin_y, field_of_view * cos_y, field_of_view * cos_x * sin_y,
+		-sin_x * cos_y, -sin_y, cos_x * cos_y
+	);
 }
\ No newline at end of file
@@ -2,13 +2,25 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "ofMain.h"
 #include "model3d.h"
+#include "projection_kernel.h"
+#include "line_batch.h"
+#include "depth_buffer.h"
 
 class Camera {
 
 public:
 
+	/* How much of a sphere is in the camera's view */
+	enum FrustumOverlap {
+		OUTSIDE, INTERSECTING, INSIDE
+	};
+
 	// Camera parameters
 	ofVec3f position;		/* World coordinates of the camera */
 	ofVec2f rotation;		/* The horizontal and vertical rotation of the camera in radians */
@@ -18,15 +30,39 @@ public:
 	float mouse_sensitivity;	/* Speed of camera roation when controlled by mouse. Proportional to radians per second (I think) */
 	float field_of_view;		/* Controls the camera's field of view (unknown units, maybe proportional to 1 / radians?) */
 	float zoom_speed = 1.1;		/* Speed of the camera's zoom feature */
+	float near_plane = 0.05f;	/* Distance in front of the camera where lines are cut off. Anything closer is treated as behind the camera */
+	bool frustum_culling = true;	/* Whether drawModel skips models whose bounding sphere is entirely outside the view */
+	bool outline_only = false;	/* Whether drawModel draws only the silhouette and crease edges of models with faces, instead of every edge */
+	float decimation_radius = 0;	/* Models whose bounding sphere's radius on screen is less than this many pixels draw only their most important edges. 0 turns this off */
+	float marker_radius = 0;	/* Models whose bounding sphere's radius on screen is less than this many pixels are drawn as a square marker instead. 0 turns this off */
+	float min_edge_length = 0;	/* Edges shorter than this many pixels on screen in both directions are skipped. 0 turns this off */
 	ofVec3f local_basis[3];		/* Defines unit vectors pointing forward, right, and up respectively. Updated every time the camera turns */
+	ofMatrix3x3 view_matrix;	/* Rotates a point relative to the camera into view space, with field_of_view folded into the x and y rows. Rebuilt whenever the rotation or zoom changes */
 
 	// Window parameters
 	int win_width;			/* Width of the screen */
 	int win_height;			/* Height of the screen */
-	int win_margin[2];		/* The amount of pixels outside width and height of the screen where lines can still be drawn */
+	int win_margin[2];		/* The amount of pixels outside width and height of the screen that inBounds() still accepts */
 	ofVec2f win_center;		/* Center of the screen */
 	ofVec2f out_of_bounds_point;	/* Point to return if intended not to be drawn on the screen */
 
+	// Scratch buffers - reused by every model so they only grow, never reallocate each frame
+	std::vector<ofVec2f> projected_vertices;	/* Screen coordinates of each vertex of the last mesh instance passed to projectInstance() */
+	std::vector<uint8_t> vertex_outcodes;		/* Which sides of the view each of those vertices is outside of, as ProjectionKernel outcode bits. 0 means visible */
+	ofMatrix3x3 model_view_matrix;			/* Model-view matrix of the last mesh instance passed to projectInstance() */
+	ofVec3f model_view_offset;			/* View space position of the last mesh instance passed to projectInstance() */
+	std::vector<float> vertex_depths;		/* Inverse depth (1 / distance in front of the camera) of each of those vertices, 0 if behind the near plane.
+							   Only filled for hidden-line drawing, by projectVertexDepths() */
+	std::vector<uint8_t> faces_toward;		/* Whether each face of the last mesh passed to findOutlineEdges() turns toward the camera */
+	std::vector<uint32_t> outline_edges;		/* Indices of the edges of that model to draw in outline mode */
+
+	// Draw counters - added to by every model drawn, until resetDrawCounters() is called
+	size_t edges_decimated = 0;	/* Edges left out because their model was small on screen, including the edges of models drawn as markers */
+	size_t edges_subpixel = 0;	/* Edges skipped for being shorter than min_edge_length */
+	size_t marker_count = 0;	/* Models drawn as a marker */
+
+	ProjectionKernel::Path projection_path = ProjectionKernel::bestPath();	/* Instruction set projectInstance() uses. Defaults to the fastest one the CPU supports */
+
 	//Default Camera constructor
 	Camera();
 
@@ -43,15 +79,90 @@ public:
 	/* Transforms a point in 3d space to a 2d screen coordinate. This method is the heart of all 3D rendering done in this program */
 	ofVec2f transform(ofVec3f point3d);
 
+	/* Transforms n points in 3d space to 2d screen coordinates, writing them to out */
+	void transform(const ofVec3f* in, ofVec2f* out, size_t n);
+
+	/* Projects a point that has already been through view_matrix onto the screen, or returns out_of_bounds_point if it is behind the near plane */
+	ofVec2f project(ofVec3f view_point);
+
+	/* Projects a point that has already been through view_matrix onto the screen, without checking that it is in front of the camera */
+	ofVec2f perspective(ofVec3f view_point);
+
 	/* Rotates two coordinates by a given angle */
 	void rotateCoords(float& coord0, float& coord1, float angle);
 
 	/* Returns whether a point is in the bounds of the screen */
 	bool inBounds(ofVec2f point2d);
 
-	/* Draws 3D Model on the screen */
-	void drawModel(Model3D* model);
+	/* Returns the parameters for projecting points with ProjectionKernel, for a model with the given model-view matrix and view space offset */
+	ProjectionParams projectionParams(const ofMatrix3x3& matrix, ofVec3f offset);
+
+	/* Returns the normalized world space direction from the camera's position through a point on the screen */
+	ofVec3f screenRay(ofVec2f screen_point) const;
+
+	/* Returns whether a sphere in world coordinates is entirely outside, partly inside, or entirely inside the camera's view, by testing it
+	   against the near plane and the four planes through the camera and the edges of the window */
+	FrustumOverlap frustumOverlap(ofVec3f center, float radius) const;
+
+	/* Returns whether any part of a sphere in world coordinates could be visible */
+	bool inFrustum(ofVec3f center, float radius) const;
+
+	/* Returns about how many pixels the radius of a sphere in world coordinates covers on screen, or infinity if the camera is inside it */
+	float projectedRadius(ofVec3f center, float radius) const;
+
+	/* Sets the draw counters back to 0. Call it once per frame to count that frame's edges */
+	void resetDrawCounters();
+
+	/* Transforms every vertex of a model to screen coordinates once, filling projected_vertices and vertex_outcodes */
+	void projectModel(const Model3D* model);
+
+	/* Transforms every vertex of one instance of a mesh to screen coordinates once, straight from the mesh's shared vertices */
+	void projectInstance(const Mesh& mesh, const ModelInstance& instance);
+
+	/* Cuts off the part of a view space segment behind the near plane. Returns false if the whole segment is behind it */
+	bool clipToNearPlane(ofVec3f& view_point0, ofVec3f& view_point1);
+
+	/* Cuts off the parts of a screen space segment outside the window. Returns false if the whole segment is outside it.
+	   If the inverse depths of the ends are given, they are moved along with the ends */
+	bool clipToViewport(ofVec2f& point0, ofVec2f& point1, float* depth0 = nullptr, float* depth1 = nullptr);
+
+	/* Cuts off the part of a view space triangle behind the near plane, writing the three or four corners left to clipped. Returns the number of corners */
+	int clipTriangleToNearPlane(const ofVec3f triangle[3], ofVec3f clipped[4]);
+
+	/* Fills outline_edges with the crease edges of one instance of a mesh, plus its silhouette edges as seen from the camera's current position:
+	   the edges between a face turned toward the camera and one turned away */
+	void findOutlineEdges(const Mesh& mesh, const ModelInstance& instance);
+
+	/* Fills vertex_depths for the mesh last passed to projectInstance() */
+	void projectVertexDepths(const Mesh& mesh);
+
+	/* Draws the faces of a 3D Model into a depth buffer, so they can hide the edges of every model drawn after it. Returns false if the model was culled */
+	bool drawModelDepth(Model3D* model, DepthBuffer& depth_buffer);
+
+	/* Draws the faces of one instance of a mesh into a depth buffer. Returns false if the instance was culled */
+	bool drawInstanceDepth(const Mesh& mesh, const ModelInstance& instance, DepthBuffer& depth_buffer);
+
+	/* Draws the faces of every instance of a mesh into a depth buffer. Returns the number of instances culled */
+	size_t drawInstancesDepth(const Mesh& mesh, const std::vector<ModelInstance>& instances, DepthBuffer& depth_buffer);
+
+	/* Adds the visible part of every edge of a 3D Model to a batch of lines, to be drawn on the screen along with the rest of the frame.
+	   With a depth buffer, the parts of edges behind faces already drawn into it are left out. With outline_only, only the edges found by findOutlineEdges() are drawn.
+	   Models that are small on screen draw fewer edges, or only a marker, depending on decimation_radius and marker_radius.
+	   Returns false if the model was culled without looking at its vertices, because its bounding sphere is outside the view */
+	bool drawModel(Model3D* model, LineBatch& lines, DepthBuffer* depth_buffer = nullptr);
+
+	/* Adds the visible part of every edge of one instance of a mesh to a batch of lines, the same way as drawModel(). Returns false if the instance was culled */
+	bool drawInstance(const Mesh& mesh, const ModelInstance& instance, LineBatch& lines, DepthBuffer* depth_buffer = nullptr);
+
+	/* Adds a square the size of a sphere's image on screen around its center, standing in for a model too small to draw */
+	void drawMarker(ofVec3f center, float screen_radius, const ofFloatColor& color, LineBatch& lines, DepthBuffer* depth_buffer);
+
+	/* Draws every instance of a mesh in turn, projecting each from the mesh's shared vertices. Returns the number of instances culled */
+	size_t drawInstances(const Mesh& mesh, const std::vector<ModelInstance>& instances, LineBatch& lines, DepthBuffer* depth_buffer = nullptr);
 
 	/* Computes a set of three vectors representing a local basis of the current camera position */
 	void computeLocalBasis();
+
+	/* Rebuilds view_matrix from the current rotation and field_of_view */
+	void updateViewMatrix();
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "collision_grid.h"
+
+int CollisionGrid::cellCoordinate(float position) const {
+	float cell = std::floor(position / cell_size);
+	if (!(std::abs(cell) < 1e8f)) {
+		return 0;
+	}
+	return (int)cell;
+}
+
+uint32_t CollisionGrid::bucket(int x, int y, int z) const {
+	//Multiply each coordinate by a large odd number and mix them, so neighboring cells spread across the table
+	uint32_t hash = (uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u ^ (uint32_t)z * 83492791u;
+	return hash & bucket_mask;
+}
+
+void CollisionGrid::build(const BodyStore& bodies) {
+	//Cells as wide as the largest body, so no body reaches past the cells next to its own
+	float largest_radius = 0;
+	for (size_t i = 0; i < bodies.size(); i++) {
+		largest_radius = std::max(largest_radius, bodies.radii[i]);
+	}
+	cell_size = largest_radius > 0 ? largest_radius * 2 : 1;
+
+	//About two buckets per body keeps most buckets to a single cell
+	uint32_t bucket_count = 1;
+	while (bucket_count < bodies.size() * 2) {
+		bucket_count *= 2;
+	}
+	bucket_mask = bucket_count - 1;
+
+	//Counting sort by bucket: count each bucket, turn the counts into starting points, then drop each body into place
+	body_cells.resize(bodies.size() * 3);
+	body_buckets.resize(bodies.size());
+	bucket_starts.assign(bucket_count + 1, 0);
+	for (size_t i = 0; i < bodies.size(); i++) {
+		int* cell = &body_cells[i * 3];
+		cell[0] = cellCoordinate(bodies.xs[i]);
+		cell[1] = cellCoordinate(bodies.ys[i]);
+		cell[2] = cellCoordinate(bodies.zs[i]);
+		body_buckets[i] = bucket(cell[0], cell[1], cell[2]);
+		bucket_starts[body_buckets[i] + 1]++;
+	}
+	for (uint32_t i = 0; i < bucket_count; i++) {
+		bucket_starts[i + 1] += bucket_starts[i];
+	}
+	sorted_bodies.resize(bodies.size());
+	std::vector<uint32_t> next = std::vector<uint32_t>(bucket_starts.begin(), bucket_starts.end() - 1);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		sorted_bodies[next[body_buckets[i]]++] = i;
+	}
+}
+
+void CollisionGrid::findPairs(const BodyStore& bodies, std::vector<std::pair<uint32_t, uint32_t>>& pairs) const {
+	pairs.clear();
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		ofVec3f position = bodies.position(i);
+		const int* cell = &body_cells[i * 3];
+
+		//The buckets of the 27 cells around this one. Two of them can hash to the same bucket, which must only be searched once
+		uint32_t buckets[27];
+		int bucket_count = 0;
+		for (int dx = -1; dx <= 1; dx++) {
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dz = -1; dz <= 1; dz++) {
+					uint32_t neighbor = bucket(cell[0] + dx, cell[1] + dy, cell[2] + dz);
+					if (std::find(buckets, buckets + bucket_count, neighbor) == buckets + bucket_count) {
+						buckets[bucket_count++] = neighbor;
+					}
+				}
+			}
+		}
+
+		//Each pair is found from its first body only. Compare squared distances, so no square roots are needed.
+		//The small allowance keeps rounding from dropping a pair that collideWithBody() would count as touching
+		for (int b = 0; b < bucket_count; b++) {
+			for (uint32_t k = bucket_starts[buckets[b]]; k < bucket_starts[buckets[b] + 1]; k++) {
+				uint32_t j = sorted_bodies[k];
+				if (j <= i) {
+					continue;
+				}
+				float reach = (bodies.radii[i] + bodies.radii[j]) * 1.0001f;
+				if ((bodies.position(j) - position).lengthSquared() <= reach * reach) {
+					pairs.push_back(std::make_pair(i, j));
+				}
+			}
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+}
+
+float CollisionGrid::cellSize() const {
+	return cell_size;
+}
+
+size_t CollisionGrid::bucketCount() const {
+	return bucket_starts.empty() ? 0 : bucket_starts.size() - 1;
+}
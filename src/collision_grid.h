@@ -0,0 +1,44 @@
+// COLLISION GRID - Defines the CollisionGrid class - a hashed uniform grid for finding the pairs of physics bodies close enough to touch
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "ofMain.h"
+#include "body_store.h"
+
+class CollisionGrid {
+
+private:
+	float cell_size = 1;			/* Width of a cell. At least the largest body's diameter, so touching bodies are always in neighboring cells */
+	uint32_t bucket_mask = 0;		/* Bucket count minus one. The bucket count is a power of two */
+	std::vector<uint32_t> bucket_starts;	/* Index into sorted_bodies of the first body in each bucket, plus one more entry for the end */
+	std::vector<uint32_t> sorted_bodies;	/* Indices of the bodies, grouped by bucket */
+	std::vector<uint32_t> body_buckets;	/* Bucket of each body's cell */
+	std::vector<int> body_cells;		/* x, y and z cell coordinates of each body, three per body */
+
+	/* Returns the cell coordinate of a position along one axis. Positions too far away to be meaningful all land in cell 0 */
+	int cellCoordinate(float position) const;
+
+	/* Returns the bucket of the cell at the given coordinates. Far apart cells may share a bucket, which only adds candidates */
+	uint32_t bucket(int x, int y, int z) const;
+
+public:
+
+	/* Sorts the bodies into the buckets of the cells holding their centers. Call this every step, after the bodies move */
+	void build(const BodyStore& bodies);
+
+	/* Fills pairs with the index pairs (smaller first) of every two bodies whose bounding spheres overlap, sorted, so they are handled in
+	   the same order as looping over every pair. Only the bodies in the 27 cells around each body are tested. Pass the same bodies
+	   as the last build */
+	void findPairs(const BodyStore& bodies, std::vector<std::pair<uint32_t, uint32_t>>& pairs) const;
+
+	/* Returns the width of a cell from the last build */
+	float cellSize() const;
+
+	/* Returns the number of buckets from the last build */
+	size_t bucketCount() const;
+};
@@ -0,0 +1,159 @@
+#include "depth_buffer.h"
+
+DepthBuffer::DepthBuffer() {
+	//Default constructor leaves the buffer empty until resize() is called
+}
+
+DepthBuffer::DepthBuffer(int width_, int height_) {
+	resize(width_, height_);
+}
+
+void DepthBuffer::resize(int width_, int height_) {
+	width = std::max(0, width_);
+	height = std::max(0, height_);
+	tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+	tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+	depths.assign((size_t)width * height, 0.0f);
+	tile_farthest.assign((size_t)tiles_x * tiles_y, 0.0f);
+}
+
+void DepthBuffer::clear() {
+	std::fill(depths.begin(), depths.end(), 0.0f);
+	std::fill(tile_farthest.begin(), tile_farthest.end(), 0.0f);
+	edges_tested = 0;
+	edges_rejected = 0;
+}
+
+void DepthBuffer::rasterizeTriangle(ofVec2f point0, float depth0, ofVec2f point1, float depth1, ofVec2f point2, float depth2) {
+	//Twice the signed area. Triangles facing either way are drawn, since a face seen from behind still hides what is behind it
+	float area = (point1.x - point0.x) * (point2.y - point0.y) - (point1.y - point0.y) * (point2.x - point0.x);
+	if (!(std::abs(area) > 0)) {
+		return;
+	}
+
+	//Only the pixels whose centers could be inside. Clamp before converting, since corners near the camera can be very far off screen
+	float left = std::max(-1.0f, std::floor(std::min({ point0.x, point1.x, point2.x }) - 0.5f));
+	float right = std::min((float)width, std::ceil(std::max({ point0.x, point1.x, point2.x }) - 0.5f));
+	float top = std::max(-1.0f, std::floor(std::min({ point0.y, point1.y, point2.y }) - 0.5f));
+	float bottom = std::min((float)height, std::ceil(std::max({ point0.y, point1.y, point2.y }) - 0.5f));
+	int min_x = std::max(0, (int)left);
+	int max_x = std::min(width - 1, (int)right);
+	int min_y = std::max(0, (int)top);
+	int max_y = std::min(height - 1, (int)bottom);
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	//Each corner's weight is the area of the triangle opposite it, which changes by a fixed amount per pixel in x and in y.
+	//Inverse depth is linear across the screen, so it can be blended with the same weights
+	float inverse_area = 1.0f / area;
+	float step_x[3] = { point1.y - point2.y, point2.y - point0.y, point0.y - point1.y };
+	float step_y[3] = { point2.x - point1.x, point0.x - point2.x, point1.x - point0.x };
+	ofVec2f start = ofVec2f(min_x + 0.5f, min_y + 0.5f);
+	float row_weight[3] = {
+		(point1.x - start.x) * (point2.y - start.y) - (point1.y - start.y) * (point2.x - start.x),
+		(point2.x - start.x) * (point0.y - start.y) - (point2.y - start.y) * (point0.x - start.x),
+		(point0.x - start.x) * (point1.y - start.y) - (point0.y - start.y) * (point1.x - start.x)
+	};
+
+	for (int y = min_y; y <= max_y; y++) {
+		float weight0 = row_weight[0] * inverse_area;
+		float weight1 = row_weight[1] * inverse_area;
+		float weight2 = row_weight[2] * inverse_area;
+		float* row = &depths[(size_t)y * width];
+		for (int x = min_x; x <= max_x; x++) {
+			if (weight0 >= 0 && weight1 >= 0 && weight2 >= 0) {
+				float depth = weight0 * depth0 + weight1 * depth1 + weight2 * depth2;
+				row[x] = std::max(row[x], depth);
+			}
+			weight0 += step_x[0] * inverse_area;
+			weight1 += step_x[1] * inverse_area;
+			weight2 += step_x[2] * inverse_area;
+		}
+		for (int i = 0; i < 3; i++) {
+			row_weight[i] += step_y[i];
+		}
+	}
+}
+
+void DepthBuffer::updateTiles() {
+	for (int tile_y = 0; tile_y < tiles_y; tile_y++) {
+		for (int tile_x = 0; tile_x < tiles_x; tile_x++) {
+			float farthest = std::numeric_limits<float>::max();
+			int end_x = std::min(width, (tile_x + 1) * TILE_SIZE);
+			int end_y = std::min(height, (tile_y + 1) * TILE_SIZE);
+			for (int y = tile_y * TILE_SIZE; y < end_y; y++) {
+				const float* row = &depths[(size_t)y * width];
+				for (int x = tile_x * TILE_SIZE; x < end_x; x++) {
+					farthest = std::min(farthest, row[x]);
+				}
+			}
+			tile_farthest[tile_y * tiles_x + tile_x] = farthest;
+		}
+	}
+}
+
+bool DepthBuffer::segmentHidden(ofVec2f point0, float depth0, ofVec2f point1, float depth1) const {
+	if (width == 0 || height == 0) {
+		return false;
+	}
+
+	//Depth along a segment is always between its ends' depths, so its nearest point is one of its ends
+	float nearest = std::max(depth0, depth1) * (1 + bias);
+
+	//Every tile the segment's bounding box touches must be nearer than that
+	int min_tile_x = std::max(0, std::min(tiles_x - 1, (int)(std::min(point0.x, point1.x) / TILE_SIZE)));
+	int max_tile_x = std::max(0, std::min(tiles_x - 1, (int)(std::max(point0.x, point1.x) / TILE_SIZE)));
+	int min_tile_y = std::max(0, std::min(tiles_y - 1, (int)(std::min(point0.y, point1.y) / TILE_SIZE)));
+	int max_tile_y = std::max(0, std::min(tiles_y - 1, (int)(std::max(point0.y, point1.y) / TILE_SIZE)));
+	for (int tile_y = min_tile_y; tile_y <= max_tile_y; tile_y++) {
+		for (int tile_x = min_tile_x; tile_x <= max_tile_x; tile_x++) {
+			if (tile_farthest[tile_y * tiles_x + tile_x] <= nearest) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void DepthBuffer::addVisibleParts(ofVec2f point0, float depth0, ofVec2f point1, float depth1, const ofFloatColor& color, LineBatch& lines) {
+	edges_tested++;
+	if (segmentHidden(point0, depth0, point1, depth1)) {
+		edges_rejected++;
+		return;
+	}
+
+	//Sample the segment once per pixel along its longer axis, and add each unbroken run of visible samples as one segment
+	ofVec2f difference = point1 - point0;
+	int steps = std::max(1, (int)std::ceil(std::max(std::abs(difference.x), std::abs(difference.y))));
+	int run_start = -1;
+	for (int i = 0; i <= steps; i++) {
+		bool visible = false;
+		if (i < steps) {
+			float t = (i + 0.5f) / steps;
+			int x = std::max(0, std::min(width - 1, (int)(point0.x + difference.x * t)));
+			int y = std::max(0, std::min(height - 1, (int)(point0.y + difference.y * t)));
+			float depth = depth0 + (depth1 - depth0) * t;
+			visible = depth * (1 + bias) >= depths[(size_t)y * width + x];
+		}
+		if (visible && run_start < 0) {
+			run_start = i;
+		}
+		else if (!visible && run_start >= 0) {
+			lines.addSegment(point0 + difference * ((float)run_start / steps), point0 + difference * ((float)i / steps), color);
+			run_start = -1;
+		}
+	}
+}
+
+float DepthBuffer::getDepth(int x, int y) const {
+	return depths[(size_t)y * width + x];
+}
+
+int DepthBuffer::getWidth() const {
+	return width;
+}
+
+int DepthBuffer::getHeight() const {
+	return height;
+}
@@ -0,0 +1,59 @@
+// DEPTH BUFFER - Defines the DepthBuffer class - for hiding the parts of lines that are behind the faces of a model, drawn on the CPU
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ofMain.h"
+#include "line_batch.h"
+
+class DepthBuffer {
+
+private:
+	int width = 0;				/* Width of the buffer in pixels */
+	int height = 0;				/* Height of the buffer in pixels */
+	int tiles_x = 0;			/* Number of tile columns */
+	int tiles_y = 0;			/* Number of tile rows */
+	std::vector<float> depths;		/* Inverse depth (1 / distance in front of the camera) of the nearest face at each pixel, row by row. 0 where there is none */
+	std::vector<float> tile_farthest;	/* Smallest inverse depth in each tile, so edges behind a whole tile can be rejected without visiting its pixels */
+
+public:
+	static const int TILE_SIZE = 8;		/* Width and height of a tile in pixels */
+
+	float bias = 0.01f;			/* Fraction of its distance an edge may be behind a face and still be drawn, so edges aren't hidden by their own faces */
+	size_t edges_tested = 0;		/* Number of edges given to addVisibleParts() since the last clear() */
+	size_t edges_rejected = 0;		/* How many of those were rejected by the tile test alone */
+
+	//Default DepthBuffer constructor
+	DepthBuffer();
+
+	//DepthBuffer constructor
+	DepthBuffer(int width_, int height_);
+
+	/* Changes the size of the buffer. Its contents are lost */
+	void resize(int width_, int height_);
+
+	/* Removes every face, so nothing is hidden */
+	void clear();
+
+	/* Draws the depth of a triangle into the buffer, keeping the nearest depth at each pixel center it covers. Each corner is a
+	   screen coordinate and an inverse depth, and all three must be in front of the camera */
+	void rasterizeTriangle(ofVec2f point0, float depth0, ofVec2f point1, float depth1, ofVec2f point2, float depth2);
+
+	/* Recomputes the tile depths. Call this after the last triangle and before testing any edges */
+	void updateTiles();
+
+	/* Returns whether a segment is certainly hidden, because every tile around it has faces nearer than its nearest end */
+	bool segmentHidden(ofVec2f point0, float depth0, ofVec2f point1, float depth1) const;
+
+	/* Adds the parts of a segment that are not behind any face to a batch of lines. The segment must be inside the buffer */
+	void addVisibleParts(ofVec2f point0, float depth0, ofVec2f point1, float depth1, const ofFloatColor& color, LineBatch& lines);
+
+	/* Returns the inverse depth at one pixel */
+	float getDepth(int x, int y) const;
+
+	int getWidth() const;
+	int getHeight() const;
+};
@@ -0,0 +1,91 @@
+#include "edge_list.h"
+
+void EdgeList::widen() {
+	wide_edges.reserve(narrow_edges.capacity());
+	for (const Edge16& edge : narrow_edges) {
+		wide_edges.push_back(Edge(edge.v0, edge.v1));
+	}
+	//Release the narrow storage entirely
+	std::vector<Edge16>().swap(narrow_edges);
+	wide = true;
+}
+
+void EdgeList::push_back(Edge edge) {
+	if (!wide && (edge.v0 > UINT16_MAX || edge.v1 > UINT16_MAX)) {
+		widen();
+	}
+
+	if (wide) {
+		wide_edges.push_back(edge);
+	}
+	else {
+		narrow_edges.push_back(Edge16((uint16_t)edge.v0, (uint16_t)edge.v1));
+	}
+}
+
+Edge EdgeList::operator[](size_t index) const {
+	if (wide) {
+		return wide_edges[index];
+	}
+	return Edge(narrow_edges[index].v0, narrow_edges[index].v1);
+}
+
+size_t EdgeList::size() const {
+	return wide ? wide_edges.size() : narrow_edges.size();
+}
+
+void EdgeList::reserve(size_t count) {
+	if (wide) {
+		wide_edges.reserve(count);
+	}
+	else {
+		narrow_edges.reserve(count);
+	}
+}
+
+void EdgeList::clear() {
+	narrow_edges.clear();
+	wide_edges.clear();
+	wide = false;
+}
+
+bool EdgeList::isWide() const {
+	return wide;
+}
+
+size_t EdgeList::byteSize() const {
+	return wide ? wide_edges.size() * sizeof(Edge) : narrow_edges.size() * sizeof(Edge16);
+}
+
+const void* EdgeList::data() const {
+	return wide ? (const void*)wide_edges.data() : (const void*)narrow_edges.data();
+}
+
+void EdgeList::assign(const void* edge_data, size_t count, bool wide_) {
+	clear();
+	wide = wide_;
+	if (wide) {
+		const Edge* first = (const Edge*)edge_data;
+		wide_edges.assign(first, first + count);
+	}
+	else {
+		const Edge16* first = (const Edge16*)edge_data;
+		narrow_edges.assign(first, first + count);
+	}
+}
+
+bool EdgeList::operator==(const EdgeList& other) const {
+	if (size() != other.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < size(); i++) {
+		if ((*this)[i] != other[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool EdgeList::operator!=(const EdgeList& other) const {
+	return !(*this == other);
+}
@@ -0,0 +1,84 @@
+// EDGE LIST - Defines the packed integer edge types and the EdgeList class - for storing the edges of a 3D model as pairs of vertex indices
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* A pair of indices of vertices connected by an edge */
+template <typename Index>
+struct PackedEdge {
+	Index v0;	/* Index of the first vertex */
+	Index v1;	/* Index of the second vertex */
+
+	PackedEdge(Index v0_ = 0, Index v1_ = 0) : v0(v0_), v1(v1_) {}
+
+	bool operator==(const PackedEdge& other) const {
+		return v0 == other.v0 && v1 == other.v1;
+	}
+	bool operator!=(const PackedEdge& other) const {
+		return !(*this == other);
+	}
+};
+
+typedef PackedEdge<uint32_t> Edge;	/* Edge type used for any mesh */
+typedef PackedEdge<uint16_t> Edge16;	/* Half-sized edge type used for meshes with fewer than 65536 vertices */
+
+class EdgeList {
+
+private:
+	std::vector<Edge16> narrow_edges;	/* Edges stored with 16 bit indices, used until an index no longer fits */
+	std::vector<Edge> wide_edges;		/* Edges stored with 32 bit indices, used once any index is 65536 or larger */
+	bool wide = false;			/* Whether the list has switched over to wide_edges */
+
+	/* Moves every edge from narrow_edges into wide_edges */
+	void widen();
+
+public:
+
+	/* Appends an edge, switching to 32 bit storage if either index does not fit in 16 bits */
+	void push_back(Edge edge);
+
+	/* Returns the edge at the given index */
+	Edge operator[](size_t index) const;
+
+	/* Returns the number of edges in the list */
+	size_t size() const;
+
+	/* Reserves room for the given number of edges */
+	void reserve(size_t count);
+
+	/* Removes every edge and returns to 16 bit storage */
+	void clear();
+
+	/* Returns whether the edges are stored with 32 bit indices */
+	bool isWide() const;
+
+	/* Returns the number of bytes used by the stored edges */
+	size_t byteSize() const;
+
+	/* Returns the stored edges as raw memory: byteSize() bytes of Edge if isWide(), or of Edge16 otherwise */
+	const void* data() const;
+
+	/* Replaces the list with count edges copied from raw memory holding Edge values if wide_ is set, or Edge16 values otherwise */
+	void assign(const void* edge_data, size_t count, bool wide_);
+
+	bool operator==(const EdgeList& other) const;
+	bool operator!=(const EdgeList& other) const;
+
+	/* Calls function(v0, v1) for every edge, without converting the stored index type */
+	template <typename Function>
+	void forEach(Function function) const {
+		if (wide) {
+			for (const Edge& edge : wide_edges) {
+				function(edge.v0, edge.v1);
+			}
+		}
+		else {
+			for (const Edge16& edge : narrow_edges) {
+				function(edge.v0, edge.v1);
+			}
+		}
+	}
+};
@@ -0,0 +1,69 @@
+#include "edge_set.h"
+
+#include <algorithm>
+
+EdgeSet::EdgeSet(size_t expected_edges) {
+	//Keep the table at most half full so probe sequences stay short
+	size_t capacity = 16;
+	while (capacity < expected_edges * 2) {
+		capacity *= 2;
+	}
+	slots.assign(capacity, EMPTY_KEY);
+}
+
+uint64_t EdgeSet::canonicalKey(int vert0, int vert1) {
+	uint32_t low = (uint32_t)std::min(vert0, vert1);
+	uint32_t high = (uint32_t)std::max(vert0, vert1);
+	return ((uint64_t)low << 32) | high;
+}
+
+uint64_t EdgeSet::hashKey(uint64_t key) {
+	//Finalizer from splitmix64 (http://xoshiro.di.unimi.it/splitmix64.c)
+	key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+	return key ^ (key >> 31);
+}
+
+void EdgeSet::grow() {
+	std::vector<uint64_t> old_slots;
+	old_slots.swap(slots);
+	slots.assign(old_slots.size() * 2, EMPTY_KEY);
+
+	//Reinsert every key using linear probing in the larger table
+	size_t mask = slots.size() - 1;
+	for (uint64_t key : old_slots) {
+		if (key != EMPTY_KEY) {
+			size_t index = hashKey(key) & mask;
+			while (slots[index] != EMPTY_KEY) {
+				index = (index + 1) & mask;
+			}
+			slots[index] = key;
+		}
+	}
+}
+
+bool EdgeSet::insert(int vert0, int vert1) {
+	//Grow before the table passes half full
+	if ((count + 1) * 2 > slots.size()) {
+		grow();
+	}
+
+	uint64_t key = canonicalKey(vert0, vert1);
+	size_t mask = slots.size() - 1;
+	size_t index = hashKey(key) & mask;
+
+	//Linear probing: walk forward until the key or an empty slot is found
+	while (slots[index] != EMPTY_KEY) {
+		if (slots[index] == key) {
+			return false;
+		}
+		index = (index + 1) & mask;
+	}
+	slots[index] = key;
+	count++;
+	return true;
+}
+
+size_t EdgeSet::size() const {
+	return count;
+}
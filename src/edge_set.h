@@ -0,0 +1,36 @@
+// EDGE SET - Defines the EdgeSet class - a temporary open-addressing hash set for deduplicating edges while importing a model
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class EdgeSet {
+
+private:
+	static constexpr uint64_t EMPTY_KEY = UINT64_MAX;	/* Marks an unused slot. No real edge can produce this key */
+
+	std::vector<uint64_t> slots;	/* Table of canonical edge keys, sized to a power of two */
+	size_t count = 0;		/* Number of edges currently in the set */
+
+	/* Packs an edge into a single key with the smaller vertex index first, so that an edge and its reverse share a key */
+	static uint64_t canonicalKey(int vert0, int vert1);
+
+	/* Scrambles a key so that neighboring vertex indices spread evenly across the table */
+	static uint64_t hashKey(uint64_t key);
+
+	/* Doubles the size of the table and reinserts every key */
+	void grow();
+
+public:
+
+	//EdgeSet constructor
+	EdgeSet(size_t expected_edges = 64);
+
+	/* Adds the edge (vert0, vert1) to the set. Returns false if it or its reverse was already in the set */
+	bool insert(int vert0, int vert1);
+
+	/* Returns the number of distinct edges in the set */
+	size_t size() const;
+};
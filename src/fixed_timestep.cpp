@@ -0,0 +1,32 @@
+#include "fixed_timestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+int FixedTimestep::advance(float frame_time) {
+	//A frame time that isn't a positive number adds nothing, rather than running the simulation backwards or breaking the accumulator
+	if (frame_time > 0 && std::isfinite(frame_time)) {
+		accumulator += frame_time;
+	}
+
+	int steps = 0;
+	while (accumulator >= step_time && steps < max_steps) {
+		accumulator -= step_time;
+		steps++;
+	}
+
+	//Over budget, keep only the part of a step left over. Catching up on the rest would take even longer next frame
+	if (accumulator >= step_time) {
+		accumulator = std::fmod(accumulator, step_time);
+	}
+	return steps;
+}
+
+float FixedTimestep::interpolation() const {
+	//The step time may have just been made shorter than what's left over
+	return std::min(accumulator / step_time, 1.0f);
+}
+
+void FixedTimestep::reset() {
+	accumulator = 0;
+}
@@ -0,0 +1,22 @@
+// FIXED TIMESTEP - Defines the FixedTimestep class - turns uneven frame times into a whole number of equal physics steps
+
+#pragma once
+
+class FixedTimestep {
+
+private:
+	float accumulator = 0;		/* Frame time not yet covered by a step */
+
+public:
+	float step_time = 1.0f / 120;	/* Seconds of simulated time per step */
+	int max_steps = 8;		/* Most steps to run for one frame. Time past that is dropped, so a slow frame slows the simulation down instead of freezing it */
+
+	/* Adds a frame's time and returns how many steps to run for it */
+	int advance(float frame_time);
+
+	/* Returns how far the time left over after the last step is into the next one, from 0 to 1, for drawing between the last two steps */
+	float interpolation() const;
+
+	/* Drops any time left over, like after the scene changes */
+	void reset();
+};
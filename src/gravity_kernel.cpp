@@ -0,0 +1,132 @@
+#include "gravity_kernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "simd_target.h"
+
+void GravityKernel::accumulate(BodyStore& bodies, size_t first, size_t count, float softening, ProjectionKernel::Path path) {
+	//Fall back on the scalar code if this CPU can't run AVX2
+	if (path == ProjectionKernel::AVX2 && ProjectionKernel::supports(ProjectionKernel::AVX2)) {
+		accumulateAVX2(bodies, first, count, softening);
+	}
+	else {
+		accumulateScalar(bodies, first, count, softening);
+	}
+}
+
+void GravityKernel::accumulateScalar(BodyStore& bodies, size_t first, size_t count, float softening) {
+	float softening_squared = softening * softening;
+	for (size_t i = first; i < first + count; i++) {
+		float pull_x = 0, pull_y = 0, pull_z = 0;
+		for (size_t j = 0; j < bodies.size(); j++) {
+			float dx = bodies.xs[j] - bodies.xs[i];
+			float dy = bodies.ys[j] - bodies.ys[i];
+			float dz = bodies.zs[j] - bodies.zs[i];
+			float distance_squared = dx * dx + dy * dy + dz * dz;
+			float touching_distance = bodies.radii[i] + bodies.radii[j];
+			float softened_squared = distance_squared + softening_squared;
+
+			//Written as "not apart" so a body never pulls on itself or on anything touching it, and a position that is not a number pulls on nothing
+			if (!(distance_squared >= touching_distance * touching_distance) || !(softened_squared > 0)) {
+				continue;
+			}
+			float inverse_distance = 1 / std::sqrt(softened_squared);
+			float weight = bodies.masses[j] * inverse_distance * inverse_distance * inverse_distance;
+			pull_x += dx * weight;
+			pull_y += dy * weight;
+			pull_z += dz * weight;
+		}
+
+		// F = GmM * r / (r^2 + softening^2)^(3/2), with Gm taken out of the sum
+		float scale = PhysicsBody::GRAVITATIONAL_CONSTANT * bodies.masses[i];
+		bodies.fxs[i] = pull_x * scale;
+		bodies.fys[i] = pull_y * scale;
+		bodies.fzs[i] = pull_z * scale;
+	}
+}
+
+#ifdef SIMD_TARGET_X64
+
+AVX2_FUNCTION void GravityKernel::accumulateAVX2(BodyStore& bodies, size_t first, size_t count, float softening) {
+	__m256 softening_squared = _mm256_set1_ps(softening * softening);
+	__m256 zero = _mm256_setzero_ps();
+	__m256 half = _mm256_set1_ps(0.5f);
+	__m256 three_halves = _mm256_set1_ps(1.5f);
+
+	//Eight running sums per component for every body of a block. Each lane adds up every eighth other body
+	alignas(32) float pulls[BLOCK_BODIES][3][8];
+
+	for (size_t block_start = first; block_start < first + count; block_start += BLOCK_BODIES) {
+		size_t block_end = std::min(block_start + BLOCK_BODIES, first + count);
+		for (size_t i = 0; i < block_end - block_start; i++) {
+			std::fill(&pulls[i][0][0], &pulls[i][0][0] + 24, 0.0f);
+		}
+
+		//Stream the other bodies past the block one tile at a time, so each tile is read from memory once per block rather than once per body
+		for (size_t tile_start = 0; tile_start < bodies.paddedSize(); tile_start += TILE_BODIES) {
+			size_t tile_end = std::min(tile_start + TILE_BODIES, bodies.paddedSize());
+			for (size_t i = block_start; i < block_end; i++) {
+				__m256 x = _mm256_set1_ps(bodies.xs[i]);
+				__m256 y = _mm256_set1_ps(bodies.ys[i]);
+				__m256 z = _mm256_set1_ps(bodies.zs[i]);
+				__m256 radius = _mm256_set1_ps(bodies.radii[i]);
+				float (*pull)[8] = pulls[i - block_start];
+				__m256 pull_x = _mm256_load_ps(pull[0]);
+				__m256 pull_y = _mm256_load_ps(pull[1]);
+				__m256 pull_z = _mm256_load_ps(pull[2]);
+
+				//The arrays are padded to a whole number of registers, so there is no remainder to finish off
+				for (size_t j = tile_start; j < tile_end; j += 8) {
+					__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&bodies.xs[j]), x);
+					__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&bodies.ys[j]), y);
+					__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&bodies.zs[j]), z);
+					__m256 distance_squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+					__m256 touching_distance = _mm256_add_ps(radius, _mm256_loadu_ps(&bodies.radii[j]));
+					__m256 softened_squared = _mm256_add_ps(distance_squared, softening_squared);
+
+					//The approximate reciprocal square root is good to about 12 bits. One Newton step, y * (3/2 - s/2 * y^2), brings it to about 23
+					__m256 inverse_distance = _mm256_rsqrt_ps(softened_squared);
+					inverse_distance = _mm256_mul_ps(inverse_distance, _mm256_sub_ps(three_halves,
+						_mm256_mul_ps(_mm256_mul_ps(half, softened_squared), _mm256_mul_ps(inverse_distance, inverse_distance))));
+					__m256 weight = _mm256_mul_ps(_mm256_loadu_ps(&bodies.masses[j]),
+						_mm256_mul_ps(_mm256_mul_ps(inverse_distance, inverse_distance), inverse_distance));
+
+					//Same rule as the scalar code. Masking the products also clears the infinities and NaNs of bodies that are touching or in the padding
+					__m256 apart = _mm256_and_ps(_mm256_cmp_ps(distance_squared, _mm256_mul_ps(touching_distance, touching_distance), _CMP_GE_OQ),
+						_mm256_cmp_ps(softened_squared, zero, _CMP_GT_OQ));
+					pull_x = _mm256_add_ps(pull_x, _mm256_and_ps(_mm256_mul_ps(dx, weight), apart));
+					pull_y = _mm256_add_ps(pull_y, _mm256_and_ps(_mm256_mul_ps(dy, weight), apart));
+					pull_z = _mm256_add_ps(pull_z, _mm256_and_ps(_mm256_mul_ps(dz, weight), apart));
+				}
+				_mm256_store_ps(pull[0], pull_x);
+				_mm256_store_ps(pull[1], pull_y);
+				_mm256_store_ps(pull[2], pull_z);
+			}
+		}
+
+		//Add up the lanes in a fixed order, so the result doesn't depend on how the bodies were split into ranges
+		for (size_t i = block_start; i < block_end; i++) {
+			float (*pull)[8] = pulls[i - block_start];
+			float sums[3] = { 0, 0, 0 };
+			for (int component = 0; component < 3; component++) {
+				for (int lane = 0; lane < 8; lane++) {
+					sums[component] += pull[component][lane];
+				}
+			}
+			float scale = PhysicsBody::GRAVITATIONAL_CONSTANT * bodies.masses[i];
+			bodies.fxs[i] = sums[0] * scale;
+			bodies.fys[i] = sums[1] * scale;
+			bodies.fzs[i] = sums[2] * scale;
+		}
+	}
+}
+
+#else
+
+//No SIMD path outside x86-64. ProjectionKernel::supports(AVX2) returns false, so accumulate() never gets here, but keep it callable
+void GravityKernel::accumulateAVX2(BodyStore& bodies, size_t first, size_t count, float softening) {
+	accumulateScalar(bodies, first, count, softening);
+}
+
+#endif
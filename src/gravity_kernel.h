@@ -0,0 +1,30 @@
+// GRAVITY KERNEL - Defines the GravityKernel class - for summing the gravity on many bodies from every other body at once using SIMD instructions
+
+#pragma once
+
+#include <cstddef>
+
+#include "ofMain.h"
+#include "body_store.h"
+#include "projection_kernel.h"
+#include "physics_body.h"
+
+class GravityKernel {
+
+public:
+	static const size_t BLOCK_BODIES = 64;	/* Bodies whose running sums stay in the cache together while tiles of other bodies stream past them */
+	static const size_t TILE_BODIES = 512;	/* Other bodies in a tile. A tile and a block's sums together fit in a 32KB L1 cache */
+
+	/* Sets the force on bodies first to first + count of a store to the pull of every other body in it, with the same rules as
+	   PhysicsBody::gravitateWith: F = GmM / r^2, and touching bodies don't pull on each other. A softening length is added in
+	   quadrature to every distance. Different ranges can be run on different threads at the same time. Uses the same paths as
+	   ProjectionKernel, with SSE running the scalar code */
+	static void accumulate(BodyStore& bodies, size_t first, size_t count, float softening, ProjectionKernel::Path path = ProjectionKernel::bestPath());
+
+	/* Sums the forces one pair at a time. Used for any path the CPU doesn't support */
+	static void accumulateScalar(BodyStore& bodies, size_t first, size_t count, float softening);
+
+	/* Sums the forces from eight other bodies at a time with AVX2, using a refined approximate reciprocal square root. Only call this
+	   if ProjectionKernel::supports(AVX2) */
+	static void accumulateAVX2(BodyStore& bodies, size_t first, size_t count, float softening);
+};
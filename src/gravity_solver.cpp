@@ -0,0 +1,245 @@
+#include "gravity_solver.h"
+
+/* Spreads the lowest 21 bits of a number out to every third bit, so three of them can be interleaved into one Morton code */
+static uint64_t spreadBits(uint64_t bits) {
+	bits &= 0x1fffff;
+	bits = (bits | bits << 32) & 0x1f00000000ffffull;
+	bits = (bits | bits << 16) & 0x1f0000ff0000ffull;
+	bits = (bits | bits << 8) & 0x100f00f00f00f00full;
+	bits = (bits | bits << 4) & 0x10c30c30c30c30c3ull;
+	bits = (bits | bits << 2) & 0x1249249249249249ull;
+	return bits;
+}
+
+/* Returns which of the 2^21 slices of the bounding cube a coordinate falls in along one axis */
+static uint64_t quantize(float coordinate, float min_coordinate, float scale) {
+	float slice = (coordinate - min_coordinate) * scale;
+	//NaN fails both comparisons and lands in slice 0
+	if (!(slice > 0)) {
+		return 0;
+	}
+	return (uint64_t)std::min(slice, (float)0x1fffff);
+}
+
+template <typename Work>
+void GravitySolver::parallelFor(size_t count, size_t min_count, size_t block_size, const Work& work) const {
+	//Threads take blocks of work in turn, since some bodies sit in busier parts of the tree than others
+	std::atomic<size_t> next_block(0);
+	std::function<void()> doBlocks = [&]() {
+		for (size_t start = next_block++ * block_size; start < count; start = next_block++ * block_size) {
+			for (size_t i = start; i < std::min(start + block_size, count); i++) {
+				work(i);
+			}
+		}
+	};
+
+	//Steps run many times a second, so the blocks go to the threads the whole program shares rather than new ones
+	size_t block_count = (count + block_size - 1) / block_size;
+	WorkerPool::shared().run(count >= min_count ? (unsigned)std::min((size_t)thread_count, std::max((size_t)1, block_count)) : 1, doBlocks);
+}
+
+void GravitySolver::applyForces(BodyStore& bodies) {
+	//Every body's force is summed on its own, so threads never write to the same place and the result doesn't depend on thread_count
+	if (method == BARNES_HUT) {
+		buildTree(bodies);
+		parallelFor(bodies.size(), PARALLEL_BODIES, 64, [&](size_t i) {
+			store.setForce(i, treeForce((uint32_t)i));
+		});
+		for (size_t i = 0; i < bodies.size(); i++) {
+			bodies.setForce(sorted_codes[i].second, store.force(i));
+		}
+	}
+	//The direct sum doesn't care about order, so it runs on the bodies where they are. Threads take a kernel block at a time
+	else {
+		size_t block_count = (bodies.size() + GravityKernel::BLOCK_BODIES - 1) / GravityKernel::BLOCK_BODIES;
+		parallelFor(block_count, PARALLEL_BODIES / GravityKernel::BLOCK_BODIES, 1, [&](size_t block) {
+			size_t first = block * GravityKernel::BLOCK_BODIES;
+			GravityKernel::accumulate(bodies, first, std::min(first + GravityKernel::BLOCK_BODIES, bodies.size()) - first, softening, path);
+		});
+	}
+}
+
+size_t GravitySolver::nodeCount() const {
+	return nodes.size();
+}
+
+void GravitySolver::gatherBodies(const BodyStore& bodies) {
+	store.resize(bodies.size());
+	for (size_t i = 0; i < bodies.size(); i++) {
+		uint32_t body = sorted_codes[i].second;
+		store.setBody(i, bodies.position(body), bodies.masses[body], bodies.radii[body]);
+	}
+}
+
+void GravitySolver::buildTree(const BodyStore& bodies) {
+	nodes.clear();
+	if (bodies.size() == 0) {
+		store.resize(0);
+		sorted_codes.clear();
+		return;
+	}
+
+	//Find the cube around every body, a little larger so the farthest bodies don't land exactly on its edge
+	ofVec3f min_corner = bodies.position(0);
+	ofVec3f max_corner = bodies.position(0);
+	for (size_t i = 0; i < bodies.size(); i++) {
+		ofVec3f position = bodies.position(i);
+		min_corner = ofVec3f(std::min(min_corner.x, position.x), std::min(min_corner.y, position.y), std::min(min_corner.z, position.z));
+		max_corner = ofVec3f(std::max(max_corner.x, position.x), std::max(max_corner.y, position.y), std::max(max_corner.z, position.z));
+	}
+	ofVec3f extent = max_corner - min_corner;
+	float root_size = std::max(std::max(extent.x, extent.y), extent.z) * 1.001f;
+	if (!(root_size > 0) || !std::isfinite(root_size)) {
+		root_size = 1;
+	}
+
+	//Interleave the bits of each body's position within the cube. Sorting by the result puts the bodies of every octree node next to each other
+	float scale = (1 << MAX_DEPTH) / root_size;
+	sorted_codes.resize(bodies.size());
+	parallelFor(bodies.size(), PARALLEL_BODIES, 64, [&](size_t i) {
+		ofVec3f position = bodies.position(i);
+		uint64_t code = spreadBits(quantize(position.x, min_corner.x, scale)) << 2 | spreadBits(quantize(position.y, min_corner.y, scale)) << 1
+			| spreadBits(quantize(position.z, min_corner.z, scale));
+		sorted_codes[i] = std::make_pair(code, (uint32_t)i);
+	});
+	std::sort(sorted_codes.begin(), sorted_codes.end());
+	gatherBodies(bodies);
+
+	//A small tree is built in one go
+	if (bodies.size() < PARALLEL_BODIES) {
+		buildNode(nodes, 0, (uint32_t)bodies.size(), 0, root_size);
+		return;
+	}
+
+	//Otherwise each of the root's eight children is built into its own list on its own thread...
+	std::vector<std::vector<Node>> child_nodes(8);
+	std::vector<uint32_t> child_starts(9, (uint32_t)bodies.size());
+	for (int child = 7; child >= 0; child--) {
+		uint64_t child_code = (uint64_t)child << (3 * (MAX_DEPTH - 1));
+		child_starts[child] = (uint32_t)(std::lower_bound(sorted_codes.begin(), sorted_codes.end(), std::make_pair(child_code, 0u)) - sorted_codes.begin());
+	}
+	parallelFor(8, 1, 1, [&](size_t child) {
+		if (child_starts[child + 1] > child_starts[child]) {
+			buildNode(child_nodes[child], child_starts[child], child_starts[child + 1] - child_starts[child], 1, root_size / 2);
+		}
+	});
+
+	//...then they are joined behind the root, moving each child's links along by the nodes in front of it
+	Node root;
+	root.size = root_size;
+	root.count = (uint32_t)bodies.size();
+	root.leaf = false;
+	nodes.push_back(root);
+	for (const std::vector<Node>& child_list : child_nodes) {
+		if (child_list.empty()) {
+			continue;
+		}
+		nodes[0].mass += child_list[0].mass;
+		nodes[0].max_radius = std::max(nodes[0].max_radius, child_list[0].max_radius);
+		nodes[0].center_of_mass += child_list[0].center_of_mass * child_list[0].mass;
+		uint32_t offset = (uint32_t)nodes.size();
+		for (Node node : child_list) {
+			node.next += offset;
+			nodes.push_back(node);
+		}
+	}
+	if (nodes[0].mass > 0) {
+		nodes[0].center_of_mass /= nodes[0].mass;
+	}
+	nodes[0].next = (uint32_t)nodes.size();
+}
+
+void GravitySolver::buildNode(std::vector<Node>& node_list, uint32_t first, uint32_t count, int level, float size) const {
+	size_t index = node_list.size();
+	node_list.push_back(Node());
+	node_list[index].first = first;
+	node_list[index].count = count;
+	node_list[index].size = size;
+
+	//Small nodes, and nodes whose bodies all share a Morton code, keep their bodies
+	if (count <= LEAF_SIZE || level >= MAX_DEPTH) {
+		float mass = 0;
+		ofVec3f weighted_position;
+		for (uint32_t i = first; i < first + count; i++) {
+			mass += store.masses[i];
+			weighted_position += store.position(i) * store.masses[i];
+			node_list[index].max_radius = std::max(node_list[index].max_radius, store.radii[i]);
+		}
+		node_list[index].mass = mass;
+		node_list[index].center_of_mass = mass > 0 ? weighted_position / mass : store.position(first);
+		node_list[index].next = (uint32_t)node_list.size();
+		return;
+	}
+
+	//The bodies are sorted, so each child's bodies are a run sharing the same three bits at this level
+	node_list[index].leaf = false;
+	int shift = 3 * (MAX_DEPTH - 1 - level);
+	float mass = 0;
+	ofVec3f weighted_position;
+	uint32_t child_first = first;
+	while (child_first < first + count) {
+		uint64_t child = sorted_codes[child_first].first >> shift & 7;
+		uint32_t child_end = child_first + 1;
+		while (child_end < first + count && (sorted_codes[child_end].first >> shift & 7) == child) {
+			child_end++;
+		}
+		size_t child_index = node_list.size();
+		buildNode(node_list, child_first, child_end - child_first, level + 1, size / 2);
+		mass += node_list[child_index].mass;
+		node_list[index].max_radius = std::max(node_list[index].max_radius, node_list[child_index].max_radius);
+		weighted_position += node_list[child_index].center_of_mass * node_list[child_index].mass;
+		child_first = child_end;
+	}
+	node_list[index].mass = mass;
+	node_list[index].center_of_mass = mass > 0 ? weighted_position / mass : store.position(first);
+	node_list[index].next = (uint32_t)node_list.size();
+}
+
+ofVec3f GravitySolver::bodyForce(uint32_t body, uint32_t other) const {
+	ofVec3f displacement = store.position(other) - store.position(body);
+	float distance_squared = displacement.lengthSquared();
+	float touching_distance = store.radii[body] + store.radii[other];
+	float softened_squared = distance_squared + softening * softening;
+
+	//Only gravitate if the bodies are not colliding, with the same rule as GravityKernel
+	if (body == other || !(distance_squared >= touching_distance * touching_distance) || !(softened_squared > 0)) {
+		return ofVec3f();
+	}
+
+	// F = GmM * r / (r^2 + softening^2)^(3/2)
+	float inverse_distance = 1 / std::sqrt(softened_squared);
+	return displacement * (PhysicsBody::GRAVITATIONAL_CONSTANT * store.masses[body] * store.masses[other] * inverse_distance * inverse_distance * inverse_distance);
+}
+
+ofVec3f GravitySolver::treeForce(uint32_t body) const {
+	ofVec3f force;
+	float max_ratio_squared = opening_angle * opening_angle;
+	uint32_t index = 0;
+	while (index < nodes.size()) {
+		const Node& node = nodes[index];
+		ofVec3f displacement = node.center_of_mass - store.position(body);
+		float distance_squared = displacement.lengthSquared();
+
+		//A node the body isn't inside, small enough from where the body is, pulls like a single mass at its center of mass. It also has to
+		//be too far away for any body inside to touch this one, since touching bodies don't pull on each other. The center of mass can sit
+		//in one corner of the cube with a body in the opposite one, so a body inside can be up to the cube's whole diagonal from it
+		bool holds_body = body >= node.first && body < node.first + node.count;
+		float reach = store.radii[body] + node.max_radius + node.size * 1.732f;
+		if (!holds_body && node.size * node.size < max_ratio_squared * distance_squared && reach * reach < distance_squared) {
+			float inverse_distance = 1 / std::sqrt(distance_squared + softening * softening);
+			force += displacement * (PhysicsBody::GRAVITATIONAL_CONSTANT * store.masses[body] * node.mass * inverse_distance * inverse_distance * inverse_distance);
+			index = node.next;
+		}
+		//Otherwise a leaf's bodies pull one at a time, and any other node is opened by moving on to its first child
+		else if (node.leaf) {
+			for (uint32_t other = node.first; other < node.first + node.count; other++) {
+				force += bodyForce(body, other);
+			}
+			index = node.next;
+		}
+		else {
+			index++;
+		}
+	}
+	return force;
+}
@@ -0,0 +1,79 @@
+// GRAVITY SOLVER - Defines the GravitySolver class - computes the gravity between every physics body, either directly or with a Barnes-Hut octree
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "ofMain.h"
+#include "physics_body.h"
+#include "body_store.h"
+#include "gravity_kernel.h"
+#include "worker_pool.h"
+
+class GravitySolver {
+
+private:
+	static const int MAX_DEPTH = 21;		/* Levels of the octree below the root. Each level takes one bit of a body's 63 bit Morton code per axis */
+	static const uint32_t LEAF_SIZE = 8;		/* Nodes with this many bodies or fewer aren't split any further */
+	static const size_t PARALLEL_BODIES = 1024;	/* Fewer bodies than this aren't worth the cost of handing work to other threads */
+
+	/* A cube of space in the octree. Nodes are stored depth first, so a node's children directly follow it */
+	struct Node {
+		ofVec3f center_of_mass;		/* Mass weighted average position of the bodies inside */
+		float mass = 0;			/* Total mass of the bodies inside */
+		float size = 0;			/* Width of the cube */
+		float max_radius = 0;		/* Radius of the largest body inside */
+		uint32_t first = 0;		/* Index into the sorted bodies of the first body inside. The bodies inside are contiguous */
+		uint32_t count = 0;		/* Number of bodies inside */
+		uint32_t next = 0;		/* Index of the first node after this node's children, where a walk goes when it doesn't open this node */
+		bool leaf = true;		/* Whether the node has no children, and its bodies are visited one at a time */
+	};
+
+	std::vector<Node> nodes;		/* The octree from the last Barnes-Hut step, with the root first */
+	std::vector<std::pair<uint64_t, uint32_t>> sorted_codes;	/* Morton code and index of each body, sorted by code so nearby bodies are next to each other */
+	BodyStore store;			/* Position, mass, radius and force of each body, in sorted order */
+
+	/* Copies the positions, masses and radii of the bodies into the store, in sorted order */
+	void gatherBodies(const BodyStore& bodies);
+
+	/* Sorts the bodies along a Morton curve through their bounding cube, and builds the octree over them */
+	void buildTree(const BodyStore& bodies);
+
+	/* Appends the node holding the sorted bodies from first to first + count, and then its children, to a list of nodes */
+	void buildNode(std::vector<Node>& node_list, uint32_t first, uint32_t count, int level, float size) const;
+
+	/* Returns the force pulling one sorted body toward another, or no force if they are the same body or touching */
+	ofVec3f bodyForce(uint32_t body, uint32_t other) const;
+
+	/* Returns the force on one sorted body from the octree, treating nodes that look small enough from the body as a single mass */
+	ofVec3f treeForce(uint32_t body) const;
+
+	/* Calls work(i) for every i below count, on up to thread_count threads when count is at least min_count. Threads take block_size
+	   values of i at a time */
+	template <typename Work>
+	void parallelFor(size_t count, size_t min_count, size_t block_size, const Work& work) const;
+
+public:
+	/* Ways of computing gravity. DIRECT adds up every pair exactly with GravityKernel, in O(N^2) time. BARNES_HUT groups far away bodies in an octree,
+	   in O(N log N) time, with an error controlled by opening_angle */
+	enum Method {
+		DIRECT, BARNES_HUT
+	};
+
+	Method method = DIRECT;		/* How gravity is computed */
+	float opening_angle = 0.5f;	/* Largest ratio of a node's width to its distance at which it is treated as a single mass. 0 opens every node, matching DIRECT */
+	float softening = 0;		/* Length added in quadrature to every distance, so close passes don't produce huge forces. 0 is plain Newtonian gravity */
+	unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());	/* Number of threads the tree build and force sums are split across */
+	ProjectionKernel::Path path = ProjectionKernel::bestPath();	/* Instruction set the DIRECT sum uses */
+
+	/* Sets the force of each body in a store to the gravitational force from every other body in it. Like PhysicsBody::gravitateWith,
+	   touching bodies don't pull on each other */
+	void applyForces(BodyStore& bodies);
+
+	/* Returns the number of nodes in the octree from the last Barnes-Hut step */
+	size_t nodeCount() const;
+};
@@ -0,0 +1,156 @@
+#include "headless_options.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+/* Reads a whole argument as an integer of at least min_value. Returns false if it is anything else */
+static bool parseInt(const std::string& text, int min_value, int& value) {
+	char* end = nullptr;
+	long parsed = std::strtol(text.c_str(), &end, 10);
+	if (text.empty() || *end != '\0' || parsed < min_value || parsed > 1000000000) {
+		return false;
+	}
+	value = (int)parsed;
+	return true;
+}
+
+bool HeadlessOptions::parse(const std::vector<std::string>& args, HeadlessOptions& options, std::string& error) {
+	for (size_t i = 0; i < args.size(); i++) {
+		const std::string& arg = args[i];
+
+		//Options without a value
+		if (arg == "--headless") {
+			options.enabled = true;
+			continue;
+		}
+		if (arg == "--aa") {
+			options.anti_aliasing = true;
+			continue;
+		}
+		if (arg == "--floor") {
+			options.show_floor = true;
+			continue;
+		}
+		if (arg == "--hidden-lines") {
+			options.hidden_lines = true;
+			continue;
+		}
+		if (arg == "--outlines") {
+			options.outlines_only = true;
+			continue;
+		}
+
+		//Every other option takes the next argument as its value
+		if (i + 1 >= args.size()) {
+			error = "Unknown option or missing value: " + arg;
+			return false;
+		}
+		const std::string& value = args[++i];
+
+		if (arg == "--demo") {
+			if (value != "none" && value != "planets" && value != "models" && value != "box") {
+				error = "Unknown demo: " + value;
+				return false;
+			}
+			options.demo = value;
+		}
+		else if (arg == "--frames") {
+			if (!parseInt(value, 1, options.frame_count)) {
+				error = "--frames needs a whole number of at least 1";
+				return false;
+			}
+		}
+		else if (arg == "--size") {
+			size_t separator = value.find('x');
+			if (separator == std::string::npos || !parseInt(value.substr(0, separator), 1, options.width)
+				|| !parseInt(value.substr(separator + 1), 1, options.height)) {
+				error = "--size needs a resolution like 1920x1080";
+				return false;
+			}
+		}
+		else if (arg == "--every") {
+			if (!parseInt(value, 0, options.save_every)) {
+				error = "--every needs a whole number of at least 0";
+				return false;
+			}
+		}
+		else if (arg == "--output") {
+			options.output_prefix = value;
+		}
+		else if (arg == "--format") {
+			if (value != "ppm" && value != "png") {
+				error = "--format needs ppm or png";
+				return false;
+			}
+			options.format = value;
+		}
+		else if (arg == "--frame-time") {
+			char* end = nullptr;
+			options.frame_time = std::strtof(value.c_str(), &end);
+			if (value.empty() || *end != '\0' || !(options.frame_time > 0)) {
+				error = "--frame-time needs a number of seconds greater than 0";
+				return false;
+			}
+		}
+		else if (arg == "--physics-rate") {
+			if (!parseInt(value, 1, options.physics_rate)) {
+				error = "--physics-rate needs a whole number of steps per second of at least 1";
+				return false;
+			}
+		}
+		else if (arg == "--gravity") {
+			if (value != "direct" && value != "barnes-hut") {
+				error = "--gravity needs direct or barnes-hut";
+				return false;
+			}
+			options.gravity = value;
+		}
+		else if (arg == "--seed") {
+			int seed = 0;
+			if (!parseInt(value, 0, seed)) {
+				error = "--seed needs a whole number of at least 0";
+				return false;
+			}
+			options.seed = (unsigned)seed;
+		}
+		else {
+			error = "Unknown option: " + arg;
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string HeadlessOptions::usage() {
+	return
+		"Options:\n"
+		"  --headless            Run without a window, drawing frames on the CPU and saving them to files\n"
+		"  --demo NAME           Demo to run: none, planets, models (default) or box\n"
+		"  --frames N            Number of frames to run before exiting (default 60)\n"
+		"  --size WxH            Resolution of the frames (default 1920x1080)\n"
+		"  --every N             Save every Nth frame, or only the last one if N is 0 (default 1)\n"
+		"  --output PREFIX       Start of each frame's file name (default frame_)\n"
+		"  --format ppm|png      Image format of the frames (default ppm)\n"
+		"  --frame-time SECONDS  Simulated time per frame (default 1/60)\n"
+		"  --physics-rate HZ     Physics steps per second of simulated time (default 120)\n"
+		"  --aa                  Draw anti-aliased lines\n"
+		"  --floor               Draw the floor\n"
+		"  --hidden-lines        Hide the parts of lines that are behind faces\n"
+		"  --outlines            Draw only the silhouette and crease edges of models\n"
+		"  --gravity METHOD      Gravity in the planets demo: direct (default) or barnes-hut\n"
+		"  --seed N              Seed for the random numbers used by the box demo (default 0)\n";
+}
+
+bool HeadlessOptions::shouldSave(int frame) const {
+	if (save_every == 0) {
+		return frame == frame_count - 1;
+	}
+	return frame % save_every == 0;
+}
+
+std::string HeadlessOptions::framePath(int frame) const {
+	//Zero padded so the files sort in frame order
+	char number[16];
+	std::snprintf(number, sizeof(number), "%05d", frame);
+	return output_prefix + number + "." + format;
+}
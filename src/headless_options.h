@@ -0,0 +1,40 @@
+// HEADLESS OPTIONS - Defines the HeadlessOptions class - the command line settings for running the renderer without a window, for automated runs
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class HeadlessOptions {
+
+public:
+	bool enabled = false;			/* Whether to run without a window. Set by --headless */
+	std::string demo = "models";		/* Demo to show: none, planets, models or box. Set by --demo */
+	int frame_count = 60;			/* Number of frames to run before exiting. Set by --frames */
+	int width = 1920;			/* Width of the frames in pixels. Set by --size WIDTHxHEIGHT */
+	int height = 1080;			/* Height of the frames in pixels */
+	int save_every = 1;			/* Save every nth frame, starting with the first. 0 saves only the last one. Set by --every */
+	std::string output_prefix = "frame_";	/* Start of each frame's file name, which may include a folder. Set by --output */
+	std::string format = "ppm";		/* Image format of the frames, ppm or png. Set by --format */
+	float frame_time = 1.0f / 60;		/* Seconds of simulated time per frame, fixed so runs are repeatable. Set by --frame-time */
+	bool anti_aliasing = false;		/* Whether to draw smooth lines. Set by --aa */
+	bool show_floor = false;		/* Whether to draw the floor. Set by --floor */
+	bool hidden_lines = false;		/* Whether to hide lines behind faces. Set by --hidden-lines */
+	bool outlines_only = false;		/* Whether to draw only the silhouette and crease edges of models. Set by --outlines */
+	int physics_rate = 120;			/* Physics steps per second of simulated time. Set by --physics-rate */
+	std::string gravity = "direct";		/* How the planets demo computes gravity, direct or barnes-hut. Set by --gravity */
+	unsigned seed = 0;			/* Seed for the random numbers used by the box demo. Set by --seed */
+
+	/* Fills options from the command line arguments (not including the program name). Returns false and describes the problem in error
+	   if an argument is unknown or a value is missing or invalid */
+	static bool parse(const std::vector<std::string>& args, HeadlessOptions& options, std::string& error);
+
+	/* Returns a description of every command line option */
+	static std::string usage();
+
+	/* Returns whether the given frame (counting from 0) is one that should be saved */
+	bool shouldSave(int frame) const;
+
+	/* Returns the file name the given frame (counting from 0) is saved to */
+	std::string framePath(int frame) const;
+};
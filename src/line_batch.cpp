@@ -0,0 +1,58 @@
+#include "line_batch.h"
+
+#include <algorithm>
+
+void LineBatch::clear() {
+	//clear() keeps the vectors' capacity
+	points.clear();
+	colors.clear();
+}
+
+void LineBatch::reserve(size_t segment_count) {
+	points.reserve(segment_count * 2);
+	colors.reserve(segment_count * 2);
+}
+
+void LineBatch::addSegment(const ofVec2f& point0, const ofVec2f& point1, const ofFloatColor& color) {
+	points.push_back(point0);
+	points.push_back(point1);
+	colors.push_back(color);
+	colors.push_back(color);
+}
+
+size_t LineBatch::segmentCount() const {
+	return points.size() / 2;
+}
+
+size_t LineBatch::segmentCapacity() const {
+	return std::min(points.capacity(), colors.capacity()) / 2;
+}
+
+const std::vector<ofVec2f>& LineBatch::getPoints() const {
+	return points;
+}
+
+const std::vector<ofFloatColor>& LineBatch::getColors() const {
+	return colors;
+}
+
+void LineBatch::draw() {
+	if (points.empty()) {
+		return;
+	}
+	int total = (int)points.size();
+
+	//Only reallocate the vertex buffer when this frame has more endpoints than it can hold. Otherwise overwrite the start of it
+	if (points.size() > vbo_capacity) {
+		vbo.setVertexData(&points[0].x, 2, total, GL_DYNAMIC_DRAW, sizeof(ofVec2f));
+		vbo.setColorData(&colors[0], total, GL_DYNAMIC_DRAW);
+		vbo_capacity = points.size();
+	}
+	else {
+		vbo.updateVertexData(&points[0].x, total);
+		vbo.updateColorData(&colors[0], total);
+	}
+
+	//Each pair of endpoints is one line
+	vbo.draw(GL_LINES, 0, total);
+}
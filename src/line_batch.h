@@ -0,0 +1,42 @@
+// LINE BATCH - Defines the LineBatch class - for collecting every line segment of a frame and drawing them all with a single draw call
+
+#pragma once
+
+#include <vector>
+
+#include "ofMain.h"
+
+class LineBatch {
+
+private:
+	std::vector<ofVec2f> points;		/* Screen coordinates of both endpoints of every segment, in the order they were added */
+	std::vector<ofFloatColor> colors;	/* Color of every endpoint, so each segment can have its own color */
+	ofVbo vbo;				/* Vertex buffer the segments are uploaded to when drawn */
+	size_t vbo_capacity = 0;		/* Number of endpoints the vertex buffer currently has room for */
+
+public:
+
+	/* Removes all segments but keeps the memory, so a frame with no more segments than the last one doesn't allocate */
+	void clear();
+
+	/* Makes room for at least segment_count segments */
+	void reserve(size_t segment_count);
+
+	/* Adds a segment from point0 to point1 */
+	void addSegment(const ofVec2f& point0, const ofVec2f& point1, const ofFloatColor& color);
+
+	/* Returns the number of segments added since the last clear() */
+	size_t segmentCount() const;
+
+	/* Returns the number of segments the batch can hold before it has to allocate */
+	size_t segmentCapacity() const;
+
+	/* Returns the endpoints of every segment, two per segment */
+	const std::vector<ofVec2f>& getPoints() const;
+
+	/* Returns the color of every endpoint, two per segment */
+	const std::vector<ofFloatColor>& getColors() const;
+
+	/* Uploads all segments to the vertex buffer and draws them as lines in one call */
+	void draw();
+};
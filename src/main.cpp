@@ -2,11 +2,29 @@
 
 #include "ofMain.h"
 #include "renderer.h"
+#include "headless_options.h"
 
 const int WIDTH = 1920;
 const int HEIGHT = 1080;
     //========================================================================
-int main( ){
+int main(int argc, char* argv[]){
+
+	//Read the command line. With no arguments the renderer opens in a fullscreen window as usual
+	HeadlessOptions options;
+	std::string error;
+	if (!HeadlessOptions::parse(std::vector<std::string>(argv + 1, argv + argc), options, error)) {
+		std::cout << error << std::endl << HeadlessOptions::usage();
+		return 1;
+	}
+
+	if (options.enabled) {
+		//No window and no GL context. Every frame is drawn by the software rasterizer and saved to a file
+		ofAppNoWindow window;
+		ofSetupOpenGL(&window, options.width, options.height, OF_WINDOW);
+		ofRunApp(new Renderer(options));
+		return 0;
+	}
+
 	ofSetupOpenGL(WIDTH,HEIGHT, OF_FULLSCREEN);			// <-------- setup the GL context
 
 	// this kicks off the running of my app
@@ -0,0 +1,111 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& file_path) {
+	file_handle = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		file_handle = nullptr;
+		return;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file_handle, &file_size)) {
+		return;
+	}
+	length = (size_t)file_size.QuadPart;
+	open = true;
+
+	//Empty files cannot be mapped, but are still valid
+	if (length == 0) {
+		return;
+	}
+
+	mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_handle != nullptr) {
+		data = (const char*)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (data == nullptr) {
+		open = false;
+		length = 0;
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (mapping_handle != nullptr) {
+		CloseHandle(mapping_handle);
+	}
+	if (file_handle != nullptr) {
+		CloseHandle(file_handle);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& file_path) {
+	int file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+	if (file_descriptor < 0) {
+		return;
+	}
+
+	struct stat file_stats;
+	if (fstat(file_descriptor, &file_stats) == 0) {
+		length = (size_t)file_stats.st_size;
+		open = true;
+
+		//Empty files cannot be mapped, but are still valid
+		if (length > 0) {
+			void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+			if (mapping == MAP_FAILED) {
+				open = false;
+				length = 0;
+			}
+			else {
+				data = (const char*)mapping;
+				//The whole file is read front to back
+				madvise(mapping, length, MADV_SEQUENTIAL);
+			}
+		}
+	}
+
+	//The mapping stays valid after the descriptor is closed
+	close(file_descriptor);
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		munmap((void*)data, length);
+	}
+}
+
+#endif
+
+bool MappedFile::isOpen() const {
+	return open;
+}
+
+const char* MappedFile::begin() const {
+	return data;
+}
+
+const char* MappedFile::end() const {
+	return data + length;
+}
+
+size_t MappedFile::size() const {
+	return length;
+}
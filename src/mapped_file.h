@@ -0,0 +1,43 @@
+// MAPPED FILE - Defines the MappedFile class - a read-only view of a whole file mapped into memory
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+
+private:
+	const char* data = nullptr;	/* Start of the mapped bytes, or nullptr if the file is empty or could not be opened */
+	size_t length = 0;		/* Number of bytes in the file */
+	bool open = false;		/* Whether the file was opened successfully */
+
+#ifdef _WIN32
+	void* file_handle = nullptr;	/* Win32 handle of the open file */
+	void* mapping_handle = nullptr;	/* Win32 handle of the file mapping object */
+#endif
+
+public:
+
+	//MappedFile constructor - maps the whole file at the given path
+	MappedFile(const std::string& file_path);
+
+	//MappedFile destructor - unmaps the file
+	~MappedFile();
+
+	//Mapped files own their mapping and cannot be copied
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/* Returns whether the file was opened and mapped */
+	bool isOpen() const;
+
+	/* Returns the first byte of the file */
+	const char* begin() const;
+
+	/* Returns one past the last byte of the file */
+	const char* end() const;
+
+	/* Returns the size of the file in bytes */
+	size_t size() const;
+};
@@ -0,0 +1,300 @@
+#include "mesh.h"
+
+void Mesh::readFromOBJ(std::string file_path) {
+
+	//Map the whole file into memory instead of streaming it token by token
+	MappedFile obj_file(file_path);
+
+	//Check for invalid opening
+	if (!obj_file.isOpen()) {
+		std::cout << "Unable to open " << file_path;
+		exit(0);
+	}
+
+	//Use the binary cache if it was built from this file. The mapping is only read if the cache has to check the contents
+	MeshCacheSource source;
+	source.data = obj_file.begin();
+	source.size = obj_file.size();
+	source.modified_time = MeshCache::modifiedTime(file_path);
+	std::string cache_path = MeshCache::cachePath(file_path);
+	if (MeshCache::load(cache_path, source, vertices, edges, triangles)) {
+		splitVertexComponents();
+		computeBoundingRadius();
+		computeEdgeFaces();
+		computeEdgePriority();
+		return;
+	}
+
+	//Only large files are worth the cost of starting threads
+	unsigned thread_count = 1;
+	if (obj_file.size() >= PARALLEL_IMPORT_BYTES) {
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+	importOBJ(obj_file, thread_count);
+	centerVertices();
+
+	//Save the result for next time. If the folder can't be written to, the OBJ will just be parsed again
+	MeshCache::save(cache_path, source, vertices, edges, triangles);
+	splitVertexComponents();
+	computeBoundingRadius();
+	computeEdgeFaces();
+	computeEdgePriority();
+}
+
+void Mesh::importOBJ(const MappedFile& obj_file, unsigned thread_count) {
+
+	//Read every vertex and triangle in the file, one chunk of lines per thread
+	std::vector<ObjContents> chunks = ObjParser::parseChunks(obj_file.begin(), obj_file.end(), thread_count);
+
+	//Join the chunks' vertices in file order. Face indices are absolute, so they need no adjustment
+	size_t vertex_count = 0;
+	size_t triangle_count = 0;
+	for (const ObjContents& chunk : chunks) {
+		vertex_count += chunk.vertices.size();
+		triangle_count += chunk.triangles.size() / 3;
+	}
+	vertices.reserve(vertex_count);
+	for (ObjContents& chunk : chunks) {
+		vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+		std::vector<ofVec3f>().swap(chunk.vertices);
+	}
+
+	//Keep the faces for hidden-line drawing, skipping any that refer to vertices that don't exist
+	triangles.reserve(triangle_count * 3);
+	for (const ObjContents& chunk : chunks) {
+		for (size_t i = 0; i + 3 <= chunk.triangles.size(); i += 3) {
+			const uint32_t* triangle_verts = &chunk.triangles[i];
+			if (triangle_verts[0] < vertex_count && triangle_verts[1] < vertex_count && triangle_verts[2] < vertex_count) {
+				triangles.insert(triangles.end(), triangle_verts, triangle_verts + 3);
+			}
+		}
+	}
+
+	//A closed triangle mesh has about 1.5 edges per triangle
+	edges.reserve(triangle_count * 3 / 2);
+
+	//With a single chunk, its distinct edges are the model's edges
+	if (chunks.size() == 1) {
+		for (const Edge& edge : uniqueEdges(chunks[0].triangles, vertex_count)) {
+			edges.push_back(edge);
+		}
+		return;
+	}
+
+	//Otherwise deduplicate each chunk's edges on its own thread...
+	std::vector<std::vector<Edge>> chunk_edges(chunks.size());
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < chunks.size(); i++) {
+		workers.push_back(std::thread([&, i]() {
+			chunk_edges[i] = uniqueEdges(chunks[i].triangles, vertex_count);
+		}));
+	}
+	chunk_edges[0] = uniqueEdges(chunks[0].triangles, vertex_count);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	//...then merge them in chunk order. Each edge keeps its first occurrence in the file, so the result
+	//is the same as importing on a single thread no matter how the file was split
+	EdgeSet edge_set(triangle_count * 3 / 2);
+	for (const std::vector<Edge>& unique_edges : chunk_edges) {
+		for (const Edge& edge : unique_edges) {
+			addEdge(edge.v0, edge.v1, edge_set);
+		}
+	}
+}
+
+std::vector<Edge> Mesh::uniqueEdges(const std::vector<uint32_t>& triangles, size_t vertex_count) {
+	std::vector<Edge> unique_edges;
+	EdgeSet edge_set(triangles.size() / 2);
+	unique_edges.reserve(triangles.size() / 2);
+
+	for (size_t i = 0; i < triangles.size(); i += 3) {
+		const uint32_t* triangle_verts = &triangles[i];
+
+		//Skip faces that refer to vertices that don't exist
+		if (triangle_verts[0] >= vertex_count || triangle_verts[1] >= vertex_count || triangle_verts[2] >= vertex_count) {
+			continue;
+		}
+
+		//Keep only the first occurrence of an edge or its reverse
+		for (int j = 0; j < 3; j++) {
+			uint32_t vert0 = triangle_verts[j];
+			uint32_t vert1 = triangle_verts[(j + 1) % 3];
+			if (edge_set.insert(vert0, vert1)) {
+				unique_edges.push_back(Edge(vert0, vert1));
+			}
+		}
+	}
+	return unique_edges;
+}
+
+void Mesh::addEdge(int vert0, int vert1, EdgeSet& edge_set) {
+	// The edge set stores (vert0, vert1) and (vert1, vert0) under the same key, so only the first occurrence is kept
+	if (edge_set.insert(vert0, vert1)) {
+		edges.push_back(Edge(vert0, vert1));
+	}
+}
+
+void Mesh::centerVertices() {
+	if (vertices.empty()) {
+		return;
+	}
+
+	//Use the std::accumulate function to compute the "center" of the model by averaging its verticies
+	ofVec3f relative_center = std::accumulate(vertices.begin(), vertices.end(), ofVec3f(0, 0, 0)) / vertices.size();
+
+	//Change the basis of the local coordinate system so that the center is the new origin of the local coordinate system
+	for (ofVec3f &vertex : vertices) {
+		vertex -= relative_center;
+	}
+}
+
+void Mesh::splitVertexComponents() {
+	vertex_xs.resize(vertices.size());
+	vertex_ys.resize(vertices.size());
+	vertex_zs.resize(vertices.size());
+	for (size_t i = 0; i < vertices.size(); i++) {
+		vertex_xs[i] = vertices[i].x;
+		vertex_ys[i] = vertices[i].y;
+		vertex_zs[i] = vertices[i].z;
+	}
+}
+
+void Mesh::computeBoundingRadius() {
+	//Compare squared lengths and take the square root once at the end
+	float max_squared_length = 0;
+	for (const ofVec3f& vertex : vertices) {
+		max_squared_length = std::max(max_squared_length, vertex.lengthSquared());
+	}
+	bounding_radius = std::sqrt(max_squared_length);
+}
+
+void Mesh::computeEdgeFaces() {
+	edge_faces.clear();
+	face_normals.clear();
+	face_offsets.clear();
+	crease_edges.clear();
+	smooth_edges.clear();
+	if (triangles.empty()) {
+		return;
+	}
+
+	//Each face's plane, so a point's side of it is one dot product away
+	size_t triangle_count = triangles.size() / 3;
+	face_normals.resize(triangle_count);
+	face_offsets.resize(triangle_count);
+	for (size_t face = 0; face < triangle_count; face++) {
+		const ofVec3f& corner0 = vertices[triangles[face * 3]];
+		ofVec3f normal = (vertices[triangles[face * 3 + 1]] - corner0).getCrossed(vertices[triangles[face * 3 + 2]] - corner0);
+		float length = normal.length();
+		face_normals[face] = length > 0 ? normal / length : ofVec3f(0, 0, 0);
+		face_offsets[face] = face_normals[face].dot(corner0);
+	}
+
+	//OBJ files often repeat a vertex along texture seams, which would leave the faces on either side unconnected.
+	//Sort the vertices by position and give every copy the index of the first one
+	std::vector<uint32_t> order(vertices.size());
+	std::iota(order.begin(), order.end(), 0);
+	auto position_less = [&](uint32_t index0, uint32_t index1) {
+		const ofVec3f& vertex0 = vertices[index0];
+		const ofVec3f& vertex1 = vertices[index1];
+		return vertex0.x != vertex1.x ? vertex0.x < vertex1.x : vertex0.y != vertex1.y ? vertex0.y < vertex1.y : vertex0.z < vertex1.z;
+	};
+	std::sort(order.begin(), order.end(), [&](uint32_t index0, uint32_t index1) {
+		return position_less(index0, index1) || (!position_less(index1, index0) && index0 < index1);
+	});
+	std::vector<uint32_t> welded(vertices.size());
+	for (size_t i = 0; i < order.size(); i++) {
+		bool copy = i > 0 && vertices[order[i]] == vertices[order[i - 1]];
+		welded[order[i]] = copy ? welded[order[i - 1]] : order[i];
+	}
+	auto weldedKey = [&](uint32_t vert0, uint32_t vert1) {
+		uint32_t welded0 = welded[vert0];
+		uint32_t welded1 = welded[vert1];
+		return ((uint64_t)std::min(welded0, welded1) << 32) | std::max(welded0, welded1);
+	};
+
+	//Sort the edges by their welded vertices, so each side of a triangle can find its edges with a binary search. Copies of an edge end up side by side
+	std::vector<std::pair<uint64_t, uint32_t>> edge_keys;
+	edge_keys.reserve(edges.size());
+	for (size_t i = 0; i < edges.size(); i++) {
+		Edge edge = edges[i];
+		edge_keys.push_back(std::make_pair(weldedKey(edge.v0, edge.v1), (uint32_t)i));
+	}
+	std::sort(edge_keys.begin(), edge_keys.end());
+
+	//Find the first two faces with area on each welded edge. Faces with no area have no facing, so they would make false silhouettes
+	std::vector<uint32_t> key_faces(edge_keys.size() * 2, NO_FACE);
+	std::vector<uint8_t> face_counts(edge_keys.size(), 0);
+	for (size_t face = 0; face < triangle_count; face++) {
+		if (face_normals[face] == ofVec3f(0, 0, 0)) {
+			continue;
+		}
+		for (int j = 0; j < 3; j++) {
+			uint64_t key = weldedKey(triangles[face * 3 + j], triangles[face * 3 + (j + 1) % 3]);
+			auto found = std::lower_bound(edge_keys.begin(), edge_keys.end(), std::make_pair(key, (uint32_t)0));
+			if (found == edge_keys.end() || found->first != key) {
+				continue;
+			}
+			size_t slot = found - edge_keys.begin();
+			if (face_counts[slot] < 2) {
+				key_faces[slot * 2 + face_counts[slot]] = (uint32_t)face;
+			}
+			face_counts[slot] = std::min(face_counts[slot] + 1, 3);
+		}
+	}
+
+	//Every copy of an edge gets the same faces, but only the first is drawn.
+	//Edges with one face outline a hole, and edges with none or more than two are where separate surfaces meet, so those are always drawn.
+	//So are edges whose faces bend away from each other by more than the crease angle
+	edge_faces.assign(edges.size() * 2, NO_FACE);
+	float crease_cosine = std::cos(ofDegToRad(CREASE_ANGLE));
+	size_t first_slot = 0;
+	for (size_t slot = 0; slot < edge_keys.size(); slot++) {
+		if (edge_keys[slot].first != edge_keys[first_slot].first) {
+			first_slot = slot;
+		}
+		uint32_t edge = edge_keys[slot].second;
+		edge_faces[edge * 2] = key_faces[first_slot * 2];
+		edge_faces[edge * 2 + 1] = key_faces[first_slot * 2 + 1];
+		if (slot != first_slot) {
+			continue;
+		}
+		if (face_counts[slot] != 2 || face_normals[key_faces[slot * 2]].dot(face_normals[key_faces[slot * 2 + 1]]) < crease_cosine) {
+			crease_edges.push_back(edge);
+		}
+		else {
+			smooth_edges.push_back(edge);
+		}
+	}
+	std::sort(crease_edges.begin(), crease_edges.end());
+	std::sort(smooth_edges.begin(), smooth_edges.end());
+}
+
+void Mesh::computeEdgePriority() {
+	//An edge's weight is its length, doubled for an edge between faces at right angles and tripled for one with a single face, so the
+	//outline and the big features survive longest. Edges with no face information are ranked by length alone
+	std::vector<float> weights(edges.size());
+	for (uint32_t i = 0; i < edges.size(); i++) {
+		Edge edge = edges[i];
+		float bend = 0;
+		if (!edge_faces.empty()) {
+			uint32_t face0 = edge_faces[i * 2];
+			uint32_t face1 = edge_faces[i * 2 + 1];
+			bend = face1 == NO_FACE ? 2 : 1 - face_normals[face0].dot(face_normals[face1]);
+		}
+		weights[i] = (vertices[edge.v1] - vertices[edge.v0]).length() * (1 + bend);
+	}
+
+	//Ties keep file order, so the ranking is the same on every load
+	edges_by_priority.resize(edges.size());
+	std::iota(edges_by_priority.begin(), edges_by_priority.end(), 0);
+	std::stable_sort(edges_by_priority.begin(), edges_by_priority.end(), [&](uint32_t edge0, uint32_t edge1) {
+		return weights[edge0] > weights[edge1];
+	});
+}
+
+bool Mesh::hasVertexComponents() const {
+	return vertex_xs.size() == vertices.size() && vertex_ys.size() == vertices.size() && vertex_zs.size() == vertices.size();
+}
@@ -0,0 +1,73 @@
+// MESH - Defines the Mesh class - the vertices and edges of a 3D wireframe shape, which may be shared by many models
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "ofMain.h"
+#include "edge_set.h"
+#include "edge_list.h"
+#include "mapped_file.h"
+#include "obj_parser.h"
+#include "mesh_cache.h"
+
+class Mesh {
+
+private:
+	static const size_t PARALLEL_IMPORT_BYTES = 2 * 1024 * 1024;	/* OBJ files at least this large are imported on every available core */
+
+	/* Returns the distinct edges of a list of triangles in the order they first appear, skipping triangles with a vertex index past vertex_count */
+	static std::vector<Edge> uniqueEdges(const std::vector<uint32_t>& triangles, size_t vertex_count);
+
+	/* Adds an edge to the edge vector only if it or its reverse are not already in edge_set, the set of edges imported so far */
+	void addEdge(int vert0, int vert1, EdgeSet& edge_set);
+
+public:
+
+	std::vector<ofVec3f> vertices;		/* Set of verticies defining the shape, relative to its center */
+	EdgeList edges;				/* Set of integer pairs representing the indices of vertices that are connected by an edge */
+	std::vector<uint32_t> triangles;	/* Indices of the vertices of every face, three per triangle, used to hide lines behind other faces */
+	std::vector<float> vertex_xs;		/* x components of the vertices, stored apart for the SIMD projection kernel. Filled by splitVertexComponents() */
+	std::vector<float> vertex_ys;		/* y components of the vertices */
+	std::vector<float> vertex_zs;		/* z components of the vertices */
+	float bounding_radius = 0;		/* Distance from the center to the furthest vertex. Filled by computeBoundingRadius() */
+
+	// Edge adjacency, for drawing only the outline of a model. Filled by computeEdgeFaces()
+	static constexpr uint32_t NO_FACE = UINT32_MAX;		/* Stands in for the missing face of an edge on a boundary */
+	static constexpr float CREASE_ANGLE = 60.0f;		/* Edges whose faces meet at more than this many degrees from flat are always drawn */
+	std::vector<uint32_t> edge_faces;	/* Indices of the two triangles sharing each edge, two per edge, NO_FACE where there are fewer. Vertices
+					   at the same position count as one, so faces meet across seams. Empty for meshes without faces */
+	std::vector<ofVec3f> face_normals;	/* Unit normal of each triangle, following its winding. Zero for triangles with no area */
+	std::vector<float> face_offsets;	/* Distance of each triangle's plane from the center along its normal */
+	std::vector<uint32_t> crease_edges;	/* Indices of the edges drawn from every direction: creases sharper than CREASE_ANGLE, and edges without exactly two faces */
+	std::vector<uint32_t> smooth_edges;	/* Indices of the rest of the edges, drawn only on the silhouette. Copies of an edge along a seam are in neither list */
+	std::vector<uint32_t> edges_by_priority;	/* Indices of every edge, most important first, so a model drawn small can draw just the start of the list.
+						   Filled by computeEdgePriority() */
+
+	/* Fills the vertex, edge and triangle vectors using an OBJ file at the given file path. The vertices are centered on the origin.
+	   A binary cache of the result is kept beside the OBJ file and used instead of the OBJ whenever it is up to date */
+	void readFromOBJ(std::string file_path);
+
+	/* Fills the vertex, edge and triangle vectors from a mapped OBJ file, splitting the work across thread_count threads */
+	void importOBJ(const MappedFile& obj_file, unsigned thread_count);
+
+	/* Modifies the vertex data to be relative to the average of the vertices */
+	void centerVertices();
+
+	/* Copies the vertices into vertex_xs, vertex_ys and vertex_zs. Must be called again whenever the vertices change */
+	void splitVertexComponents();
+
+	/* Sets bounding_radius so that a sphere of that radius around the center contains every vertex. Must be called again whenever the vertices change */
+	void computeBoundingRadius();
+
+	/* Fills edge_faces, face_normals, face_offsets, crease_edges and smooth_edges from the triangles and edges. Must be called again whenever they change */
+	void computeEdgeFaces();
+
+	/* Fills edges_by_priority, ranking long edges and sharply bent ones first. Call it after computeEdgeFaces(), since it uses the face normals */
+	void computeEdgePriority();
+
+	/* Returns whether vertex_xs, vertex_ys and vertex_zs are filled in for every vertex */
+	bool hasVertexComponents() const;
+};
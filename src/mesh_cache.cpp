@@ -0,0 +1,163 @@
+#include "mesh_cache.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "mapped_file.h"
+
+//Vertices are copied to and from the file as plain arrays of floats
+static_assert(sizeof(ofVec3f) == 3 * sizeof(float), "ofVec3f must be three packed floats");
+
+static const char MAGIC[8] = { 'R', 'R', 'M', 'E', 'S', 'H', 0, 0 };
+
+std::string MeshCache::cachePath(const std::string& obj_path) {
+	return obj_path + ".rrmesh";
+}
+
+uint64_t MeshCache::hashBytes(const char* data, size_t size) {
+	//FNV-1a (http://www.isthe.com/chongo/tech/comp/fnv/) applied to 8 byte words instead of single bytes,
+	//with an extra shift so that high bits of each word also reach the low bits of the hash
+	const uint64_t PRIME = 0x100000001b3ULL;
+	uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		uint64_t word;
+		std::memcpy(&word, data + i, 8);
+		hash = (hash ^ word) * PRIME;
+		hash ^= hash >> 32;
+	}
+	for (; i < size; i++) {
+		hash = (hash ^ (unsigned char)data[i]) * PRIME;
+	}
+	return hash;
+}
+
+int64_t MeshCache::modifiedTime(const std::string& file_path) {
+	std::error_code error;
+	std::filesystem::file_time_type time = std::filesystem::last_write_time(file_path, error);
+	return error ? 0 : (int64_t)time.time_since_epoch().count();
+}
+
+bool MeshCache::load(const std::string& cache_path, const MeshCacheSource& source, std::vector<ofVec3f>& vertices, EdgeList& edges,
+	std::vector<uint32_t>& triangles) {
+	bool source_changed = false;
+	if (!read(cache_path, source, vertices, edges, triangles, source_changed)) {
+		return false;
+	}
+
+	//The OBJ was touched without changing, like by copying the folder. Store its new time so it isn't hashed again next time
+	if (source_changed) {
+		std::fstream cache_writer(cache_path, std::ios::in | std::ios::out | std::ios::binary);
+		cache_writer.seekp(offsetof(MeshCacheHeader, source_time));
+		cache_writer.write((const char*)&source.modified_time, sizeof(source.modified_time));
+	}
+	return true;
+}
+
+bool MeshCache::read(const std::string& cache_path, const MeshCacheSource& source, std::vector<ofVec3f>& vertices, EdgeList& edges,
+	std::vector<uint32_t>& triangles, bool& source_changed) {
+	MappedFile cache_file(cache_path);
+	if (!cache_file.isOpen() || cache_file.size() < sizeof(MeshCacheHeader)) {
+		return false;
+	}
+
+	//Check that the header belongs to this version of the format and to an OBJ file of the same size
+	MeshCacheHeader header;
+	std::memcpy(&header, cache_file.begin(), sizeof(header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.source_size != source.size) {
+		return false;
+	}
+
+	//Reading the whole OBJ to hash it costs about as much as parsing it, so only do it when its time has changed
+	source_changed = header.source_time != source.modified_time;
+	if (source_changed && header.source_hash != hashBytes(source.data, source.size)) {
+		return false;
+	}
+	if (header.index_size != 2 && header.index_size != 4) {
+		return false;
+	}
+
+	//Check that the file is exactly as long as the header says, without letting huge counts overflow the sum
+	size_t payload_size = cache_file.size() - sizeof(MeshCacheHeader);
+	if (header.vertex_count > payload_size / sizeof(ofVec3f) || header.edge_count > payload_size / (2 * header.index_size)
+		|| header.triangle_count > payload_size / (3 * sizeof(uint32_t))) {
+		return false;
+	}
+	size_t vertex_bytes = header.vertex_count * 3 * sizeof(float);
+	size_t edge_bytes = header.edge_count * 2 * header.index_size;
+	size_t triangle_bytes = header.triangle_count * 3 * sizeof(uint32_t);
+	if (vertex_bytes + edge_bytes + triangle_bytes != payload_size) {
+		return false;
+	}
+
+	//Check for damage anywhere in the vertex, edge and triangle data
+	const char* payload = cache_file.begin() + sizeof(MeshCacheHeader);
+	if (hashBytes(payload, payload_size) != header.payload_hash) {
+		return false;
+	}
+
+	//Copy the vertices and edges straight out of the mapped file
+	std::vector<ofVec3f> cached_vertices(header.vertex_count);
+	std::memcpy(cached_vertices.data(), payload, vertex_bytes);
+	EdgeList cached_edges;
+	cached_edges.assign(payload + vertex_bytes, header.edge_count, header.index_size == 4);
+
+	//Reject edges that point past the end of the vertex array
+	bool edges_valid = true;
+	cached_edges.forEach([&](uint32_t vert0, uint32_t vert1) {
+		if (vert0 >= header.vertex_count || vert1 >= header.vertex_count) {
+			edges_valid = false;
+		}
+	});
+	if (!edges_valid) {
+		return false;
+	}
+
+	//Same for the triangles
+	std::vector<uint32_t> cached_triangles(header.triangle_count * 3);
+	std::memcpy(cached_triangles.data(), payload + vertex_bytes + edge_bytes, triangle_bytes);
+	for (uint32_t index : cached_triangles) {
+		if (index >= header.vertex_count) {
+			return false;
+		}
+	}
+
+	vertices = std::move(cached_vertices);
+	edges = std::move(cached_edges);
+	triangles = std::move(cached_triangles);
+	return true;
+}
+
+bool MeshCache::save(const std::string& cache_path, const MeshCacheSource& source, const std::vector<ofVec3f>& vertices, const EdgeList& edges,
+	const std::vector<uint32_t>& triangles) {
+	//Build the whole file in memory so that the payload hash can be computed before anything is written
+	size_t vertex_bytes = vertices.size() * 3 * sizeof(float);
+	size_t triangle_bytes = (triangles.size() / 3) * 3 * sizeof(uint32_t);
+	std::vector<char> payload(vertex_bytes + edges.byteSize() + triangle_bytes);
+	std::memcpy(payload.data(), vertices.data(), vertex_bytes);
+	std::memcpy(payload.data() + vertex_bytes, edges.data(), edges.byteSize());
+	std::memcpy(payload.data() + vertex_bytes + edges.byteSize(), triangles.data(), triangle_bytes);
+
+	MeshCacheHeader header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.index_size = edges.isWide() ? 4 : 2;
+	header.source_hash = hashBytes(source.data, source.size);
+	header.source_size = source.size;
+	header.source_time = source.modified_time;
+	header.vertex_count = vertices.size();
+	header.edge_count = edges.size();
+	header.triangle_count = triangles.size() / 3;
+	header.payload_hash = hashBytes(payload.data(), payload.size());
+
+	std::ofstream cache_writer(cache_path, std::ios::binary | std::ios::trunc);
+	if (!cache_writer) {
+		return false;
+	}
+	cache_writer.write((const char*)&header, sizeof(header));
+	cache_writer.write(payload.data(), payload.size());
+	return (bool)cache_writer;
+}
@@ -0,0 +1,65 @@
+// MESH CACHE - Defines the MeshCache class - for saving imported models in a compact binary file that loads much faster than an OBJ
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ofMain.h"
+#include "edge_list.h"
+
+/* Layout of the start of every cache file. All values are stored in the byte order of the machine that wrote it, so a cache
+   from a machine of the other byte order fails the version check and is rebuilt. The header is followed by
+   vertex_count vertices as three floats each, then edge_count edges of index_size bytes per index,
+   then triangle_count triangles of three 4 byte indices each */
+struct MeshCacheHeader {
+	char magic[8];			/* Always "RRMESH" followed by two zero bytes */
+	uint32_t version;		/* Format version, bumped whenever the layout or the meaning of the data changes */
+	uint32_t index_size;		/* Bytes per vertex index in the edge data, 2 or 4 */
+	uint64_t source_hash;		/* Hash of the OBJ file the cache was built from */
+	uint64_t source_size;		/* Size in bytes of the OBJ file the cache was built from */
+	int64_t source_time;		/* Last modification time of the OBJ file the cache was built from, in the file system's units */
+	uint64_t vertex_count;		/* Number of vertices */
+	uint64_t edge_count;		/* Number of edges */
+	uint64_t triangle_count;	/* Number of triangles */
+	uint64_t payload_hash;		/* Hash of the vertex, edge and triangle data, for detecting damaged files */
+};
+
+/* The OBJ file a cache is built from or checked against */
+struct MeshCacheSource {
+	const char* data = nullptr;	/* Contents of the OBJ file. Only read when the cache is saved, or when its size matches but its time doesn't */
+	uint64_t size = 0;		/* Size of the OBJ file in bytes */
+	int64_t modified_time = 0;	/* Last modification time of the OBJ file, from MeshCache::modifiedTime */
+};
+
+class MeshCache {
+
+private:
+	static const uint32_t VERSION = 3;	/* Current format version. Version 2 added the triangles, version 3 the source size and time */
+
+	/* Does the work of load(), setting source_changed if the OBJ file's time no longer matches the cache's even though its contents do */
+	static bool read(const std::string& cache_path, const MeshCacheSource& source, std::vector<ofVec3f>& vertices, EdgeList& edges,
+		std::vector<uint32_t>& triangles, bool& source_changed);
+
+public:
+
+	/* Returns the path of the cache file kept beside the given OBJ file */
+	static std::string cachePath(const std::string& obj_path);
+
+	/* Computes a fast 64 bit hash of a block of memory */
+	static uint64_t hashBytes(const char* data, size_t size);
+
+	/* Returns the last modification time of a file, or 0 if it can't be read */
+	static int64_t modifiedTime(const std::string& file_path);
+
+	/* Fills vertices, edges and triangles from the cache file at cache_path. Returns false, leaving all three untouched,
+	   if the file is missing, was built from a different OBJ, or is damaged. A cache built from an OBJ of the same size and time
+	   is trusted without reading the OBJ. Only when the time differs is the OBJ hashed, and if it still matches, the cache's time is updated */
+	static bool load(const std::string& cache_path, const MeshCacheSource& source, std::vector<ofVec3f>& vertices, EdgeList& edges,
+		std::vector<uint32_t>& triangles);
+
+	/* Writes vertices, edges and triangles to the cache file at cache_path. Returns false if the file could not be written */
+	static bool save(const std::string& cache_path, const MeshCacheSource& source, const std::vector<ofVec3f>& vertices, const EdgeList& edges,
+		const std::vector<uint32_t>& triangles);
+};
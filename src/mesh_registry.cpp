@@ -0,0 +1,75 @@
+#include "mesh_registry.h"
+
+std::map<std::string, std::weak_ptr<const Mesh>> MeshRegistry::meshes;
+std::map<std::string, std::shared_future<std::shared_ptr<const Mesh>>> MeshRegistry::loading;
+std::mutex MeshRegistry::meshes_mutex;
+size_t MeshRegistry::load_count = 0;
+
+std::shared_ptr<const Mesh> MeshRegistry::acquire(const std::string& obj_path) {
+	std::unique_lock<std::mutex> lock(meshes_mutex);
+
+	//Forget the meshes that every model has let go of, so the map doesn't grow with every path ever loaded
+	for (auto entry = meshes.begin(); entry != meshes.end();) {
+		if (entry->second.expired()) {
+			entry = meshes.erase(entry);
+		}
+		else {
+			entry++;
+		}
+	}
+
+	//Hand out the existing mesh if some model is still holding it
+	auto existing = meshes.find(obj_path);
+	if (existing != meshes.end()) {
+		std::shared_ptr<const Mesh> mesh = existing->second.lock();
+		if (mesh) {
+			return mesh;
+		}
+	}
+
+	//If another thread is already reading this file, wait for it instead of reading the file twice
+	auto pending = loading.find(obj_path);
+	if (pending != loading.end()) {
+		std::shared_future<std::shared_ptr<const Mesh>> pending_mesh = pending->second;
+		lock.unlock();
+		return pending_mesh.get();
+	}
+
+	//Otherwise read it from disk without holding the lock, so models of other files don't have to wait
+	std::promise<std::shared_ptr<const Mesh>> promise;
+	loading[obj_path] = promise.get_future().share();
+	load_count++;
+	lock.unlock();
+
+	std::shared_ptr<Mesh> new_mesh = std::make_shared<Mesh>();
+	bool read = true;
+	try {
+		new_mesh->readFromOBJ(obj_path);
+	}
+	catch (const std::exception& error) {
+		//Give this model and any waiting for it an empty mesh, and don't remember it, so the next model tries the file again
+		std::cout << "Unable to read " << obj_path << ": " << error.what() << std::endl;
+		new_mesh = std::make_shared<Mesh>();
+		read = false;
+	}
+
+	//Remember it for the next model, then wake any model waiting for it. The file is no longer being read either way
+	lock.lock();
+	if (read) {
+		meshes[obj_path] = new_mesh;
+	}
+	loading.erase(obj_path);
+	lock.unlock();
+	promise.set_value(new_mesh);
+	return new_mesh;
+}
+
+size_t MeshRegistry::loadCount() {
+	std::lock_guard<std::mutex> lock(meshes_mutex);
+	return load_count;
+}
+
+size_t MeshRegistry::size() {
+	std::lock_guard<std::mutex> lock(meshes_mutex);
+	return meshes.size();
+}
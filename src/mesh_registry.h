@@ -0,0 +1,34 @@
+// MESH REGISTRY - Defines the MeshRegistry class - for loading each mesh file once and sharing it between every model that uses it
+
+#pragma once
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "mesh.h"
+
+class MeshRegistry {
+
+private:
+	static std::map<std::string, std::weak_ptr<const Mesh>> meshes;	/* Every mesh currently in use, keyed by file path */
+	static std::map<std::string, std::shared_future<std::shared_ptr<const Mesh>>> loading;	/* Every mesh being read from disk right now */
+	static std::mutex meshes_mutex;						/* Guards meshes and loading so models can be created from any thread */
+	static size_t load_count;						/* Number of times a mesh has been read from disk */
+
+public:
+
+	/* Returns the mesh for the OBJ file at the given path, reading it only if no model is already using it. Files are read without
+	   holding up models of other files, and a model of a file that is already being read waits for it instead of reading it again.
+	   The mesh is released once the last model holding it is destroyed. If reading the file fails, the error is logged and the models get
+	   an empty mesh, and the next acquire reads the file again */
+	static std::shared_ptr<const Mesh> acquire(const std::string& obj_path);
+
+	/* Returns the number of times a mesh has been read from disk since the program started */
+	static size_t loadCount();
+
+	/* Returns the number of meshes the registry is keeping track of. Meshes no model uses anymore are forgotten on the next acquire */
+	static size_t size();
+};
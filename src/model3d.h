@@ -1,25 +1,28 @@
 // MODEL3D - Defines the Model3D class - for storing state and behavior for all 3D wireframe objects
 
 #pragma once
-#include <fstream>
+
+#include <memory>
 
 #include "ofMain.h"
+#include "mesh.h"
+#include "mesh_registry.h"
+#include "quaternion.h"
+
+/* The placement and color of one copy of a mesh. Many instances can share a mesh and be drawn together with Camera::drawInstances(),
+   without any per-instance vertices */
+struct ModelInstance {
+	ofVec3f position;		/* Position of the copy in world coordinates */
+	Quaternion orientation;		/* Rotation applied to the mesh */
+	float scale = 1.0f;		/* Size scale applied to the mesh */
+	ofColor color;			/* Color of the copy */
+
+	/* Returns the matrix combining the instance's scale and orientation */
+	ofMatrix3x3 modelMatrix() const;
+};
 
 class Model3D {
 
-protected:
-	/* Fills the model's vertex and edge vectors using an OBJ file at the given file path */
-	void readFromOBJ(std::string file_path);
-
-	/* Adds an edge to the edge vector only if it or its reverse are not already in the edge vector */
-	void addEdge(int vert0, int vert1);
-
-	/* Modifies the model's vertex data to be relative to the object's relative center. Also scales the object by the given size scale */
-	void fixVertices(float size_scale);
-
-	/* Rotates a given 3D vector about a given axis by an angle given by the magnitude of that axis */
-	void rotateVector(ofVec3f& vector, ofVec3f rotation_vector);
-
 public:
 
 	//Default Model3D constructor
@@ -31,11 +34,27 @@ public:
 	//Model3D destructor (needed a virtual method in order for other classes to inherit properly from this one)
 	virtual ~Model3D();
 
+	std::shared_ptr<const Mesh> mesh;	/* Vertices and edges defining the shape of the object, shared with every other model using the same file */
 	ofVec3f position;			/* Position of the model in world coordinates */
+	Quaternion orientation;			/* Rotation applied to the mesh */
+	float scale = 1.0f;			/* Size scale applied to the mesh */
 	ofColor color;				/* Color of the model */
-	std::vector<ofVec3f> vertices;		/* Set of verticies defining the shape of the object */
-	std::vector<ofVec2f> edges;		/* Set of integer pairs representing the indices of vertices that are connected by an edge */
 
 	/* Rotates the entire model about a given axis by an angle given by the magnitude of that axis */
 	void rotate(ofVec3f rotation_vector);
-};
\ No newline at end of file
+
+	/* Returns the matrix combining the model's scale and orientation. Build it once, then apply it to every vertex */
+	ofMatrix3x3 modelMatrix() const;
+
+	/* Returns the model's position, orientation, scale and color, for drawing it as an instance of its mesh */
+	ModelInstance instance() const;
+
+	/* Returns the radius of a sphere around the model's position that contains the whole model */
+	float boundingRadius() const;
+
+	/* Returns the vertex at the given index after the model's scale and orientation are applied, relative to the model's position */
+	ofVec3f transformedVertex(size_t index) const;
+
+	/* Multiplies a vector by a 3x3 matrix */
+	static ofVec3f applyMatrix(const ofMatrix3x3& matrix, const ofVec3f& vector);
+};
@@ -0,0 +1,202 @@
+#include "obj_parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+//Powers of ten that are exactly representable as doubles
+static const double POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+//The helpers below are only called from this file. They are inline so each line is parsed without a function call per number
+inline int ObjParser::readDigits(const char* cursor, const char* end, uint64_t& value) {
+	const char* start = cursor;
+	while (cursor < end && (unsigned)(*cursor - '0') < 10) {
+		value = value * 10 + (unsigned)(*cursor - '0');
+		cursor++;
+	}
+	return (int)(cursor - start);
+}
+
+inline const char* ObjParser::skipSpaces(const char* cursor, const char* line_end) {
+	while (cursor < line_end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+		cursor++;
+	}
+	return cursor;
+}
+
+inline const char* ObjParser::parseFloat(const char* cursor, const char* line_end, float& value) {
+	cursor = skipSpaces(cursor, line_end);
+
+	//std::from_chars does not accept a leading '+'
+	if (cursor < line_end && *cursor == '+') {
+		cursor++;
+	}
+
+	//Fast path for plain decimals like "-12.345678", which is nearly every number in an OBJ file.
+	//The digits on both sides of the point are gathered into a single integer mantissa in one pass,
+	//so the value is only rounded by one division before narrowing to float
+	const char* number_begin = cursor;
+	bool negative = (cursor < line_end && *cursor == '-');
+	if (negative) {
+		cursor++;
+	}
+	uint64_t mantissa = 0;
+	int digits = readDigits(cursor, line_end, mantissa);
+	int fraction_digits = 0;
+	cursor += digits;
+	if (cursor < line_end && *cursor == '.') {
+		cursor++;
+		fraction_digits = readDigits(cursor, line_end, mantissa);
+		digits += fraction_digits;
+		cursor += fraction_digits;
+	}
+
+	//Exponents, very long numbers and things that aren't plain decimals take the general path below
+	if (digits > 0 && digits <= MAX_FAST_DIGITS && (cursor == line_end || (*cursor != 'e' && *cursor != 'E'))) {
+		double magnitude = (double)mantissa / POWERS_OF_TEN[fraction_digits];
+		value = (float)(negative ? -magnitude : magnitude);
+		return cursor;
+	}
+
+	std::from_chars_result result = std::from_chars(number_begin, line_end, value);
+	if (result.ec != std::errc()) {
+		return nullptr;
+	}
+	return result.ptr;
+}
+
+inline const char* ObjParser::parseVertexReference(const char* cursor, const char* line_end, long& index) {
+	cursor = skipSpaces(cursor, line_end);
+
+	//Read the digits by hand. A minus sign makes the reference relative, which the caller rejects by its index
+	bool negative = (cursor < line_end && *cursor == '-');
+	if (negative) {
+		cursor++;
+	}
+	uint64_t value = 0;
+	int digits = readDigits(cursor, line_end, value);
+	cursor += digits;
+
+	//No digits, or more than a long holds on every platform
+	if (digits == 0 || digits > MAX_INDEX_DIGITS) {
+		return nullptr;
+	}
+	index = negative ? -(long)value : (long)value;
+
+	//Skip the texture and normal indices that may follow the vertex index
+	while (cursor < line_end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') {
+		cursor++;
+	}
+	return cursor;
+}
+
+inline const char* ObjParser::parseLine(const char* line_begin, const char* end, ObjContents& contents) {
+	const char* cursor = skipSpaces(line_begin, end);
+
+	//Every line we care about is a single letter followed by a space: 'v ' for vertices and 'f ' for faces
+	if (end - cursor < 2 || (cursor[1] != ' ' && cursor[1] != '\t')) {
+		return cursor;
+	}
+
+	//Vertices
+	if (cursor[0] == 'v') {
+		//Read the first three floats. Anything after them (such as vertex colors) is ignored
+		ofVec3f new_vector;
+		cursor += 1;
+		for (int i = 0; i < 3; i++) {
+			cursor = parseFloat(cursor, end, new_vector[i]);
+
+			//Faces refer to vertices by their place in the file, so an unreadable one still takes its place, at the origin
+			if (cursor == nullptr) {
+				contents.vertices.push_back(ofVec3f(0, 0, 0));
+				return line_begin;
+			}
+		}
+		contents.vertices.push_back(new_vector);
+	}
+
+	//Faces
+	else if (cursor[0] == 'f') {
+		//Subtract 1 from each index, since all OBJ face indices are one too large by convention
+		long first_vert = 0;
+		long previous_vert = 0;
+		long index = 0;
+		int count = 0;
+		size_t face_start = contents.triangles.size();
+		cursor += 1;
+		while ((cursor = skipSpaces(cursor, end)) < end && *cursor != '\n') {
+			//Relative (negative), zero and unreadable indices are not supported, so the whole face is dropped, including triangles already emitted for it
+			cursor = parseVertexReference(cursor, end, index);
+			if (cursor == nullptr || index <= 0) {
+				contents.triangles.resize(face_start);
+				return line_begin;
+			}
+			long vert = index - 1;
+
+			//Emit a fan of triangles around the first vertex
+			if (count == 0) {
+				first_vert = vert;
+			}
+			else if (count >= 2) {
+				contents.triangles.push_back((uint32_t)first_vert);
+				contents.triangles.push_back((uint32_t)previous_vert);
+				contents.triangles.push_back((uint32_t)vert);
+			}
+			previous_vert = vert;
+			count++;
+		}
+	}
+	return cursor;
+}
+
+void ObjParser::parse(const char* begin, const char* end, ObjContents& contents) {
+	//Reserve from the length of the text so most files never grow the lists: room for a vertex every 32 characters and a face index every 8
+	contents.vertices.reserve(contents.vertices.size() + (end - begin) / 32);
+	contents.triangles.reserve(contents.triangles.size() + (end - begin) / 8);
+
+	const char* cursor = begin;
+	while (cursor < end) {
+		//Parse the line in place, reading up to its line break rather than finding the break first
+		cursor = parseLine(cursor, end, contents);
+
+		//Then skip whatever the line has left, like a comment or values past the ones read
+		if (cursor < end && *cursor != '\n') {
+			cursor = (const char*)std::memchr(cursor, '\n', end - cursor);
+			if (cursor == nullptr) {
+				return;
+			}
+		}
+		cursor++;
+	}
+}
+
+std::vector<ObjContents> ObjParser::parseChunks(const char* begin, const char* end, unsigned chunk_count) {
+	if (chunk_count < 1) {
+		chunk_count = 1;
+	}
+
+	//Place each boundary just after the first line break following an even split of the text
+	std::vector<const char*> boundaries;
+	boundaries.push_back(begin);
+	size_t length = end - begin;
+	for (unsigned i = 1; i < chunk_count; i++) {
+		const char* boundary = std::max(begin + length * i / chunk_count, boundaries.back());
+		const char* line_break = (const char*)std::memchr(boundary, '\n', end - boundary);
+		boundaries.push_back(line_break == nullptr ? end : line_break + 1);
+	}
+	boundaries.push_back(end);
+
+	//Parse the first chunk on this thread and every other chunk on a worker thread
+	std::vector<ObjContents> chunks(chunk_count);
+	std::vector<std::thread> workers;
+	for (unsigned i = 1; i < chunk_count; i++) {
+		workers.push_back(std::thread(parse, boundaries[i], boundaries[i + 1], std::ref(chunks[i])));
+	}
+	parse(boundaries[0], boundaries[1], chunks[0]);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+	return chunks;
+}
@@ -0,0 +1,48 @@
+// OBJ PARSER - Defines the ObjParser class - a fast, allocation-free reader for the vertex and face lines of OBJ files
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ofMain.h"
+
+/* Raw geometry read from an OBJ file, before any edges are built */
+struct ObjContents {
+	std::vector<ofVec3f> vertices;		/* Every 'v' line, in file order */
+	std::vector<uint32_t> triangles;	/* Zero-based vertex indices, three per triangle, in file order */
+};
+
+class ObjParser {
+
+private:
+	static const int MAX_FAST_DIGITS = 15;	/* Most digits a decimal can have and still be read exactly as an integer mantissa */
+	static const int MAX_INDEX_DIGITS = 9;	/* Most digits a face index can have, so it fits in a 32 bit long */
+
+	/* Returns the first character at or after cursor that is not a space, tab or carriage return */
+	static const char* skipSpaces(const char* cursor, const char* line_end);
+
+	/* Reads the run of decimal digits starting at cursor, appending them to value, which overflows past 19 digits. Returns the number of digits */
+	static int readDigits(const char* cursor, const char* end, uint64_t& value);
+
+	/* Reads one float starting at cursor into value. Returns the character after it, or nullptr if there is no number */
+	static const char* parseFloat(const char* cursor, const char* line_end, float& value);
+
+	/* Reads one face vertex reference (v, v/vt, v//vn or v/vt/vn) starting at cursor and keeps only the vertex index.
+	   Returns the character after the reference, or nullptr if it does not start with a number */
+	static const char* parseVertexReference(const char* cursor, const char* line_end, long& index);
+
+	/* Parses the line starting at line_begin into contents, reading no further than its line break or end. Returns where it stopped
+	   reading, which is at or before the line break */
+	static const char* parseLine(const char* line_begin, const char* end, ObjContents& contents);
+
+public:
+
+	/* Parses every vertex and face line between begin and end, appending them to contents.
+	   Comments and all other line types are skipped. Faces with more than three vertices are split into a fan of triangles */
+	static void parse(const char* begin, const char* end, ObjContents& contents);
+
+	/* Splits the text between begin and end into chunk_count pieces that each end on a line break, and parses each piece
+	   on its own thread. The returned chunks are in file order, so concatenating them gives the same result as parse() */
+	static std::vector<ObjContents> parseChunks(const char* begin, const char* end, unsigned chunk_count);
+};
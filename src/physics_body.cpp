@@ -27,69 +27,89 @@ void PhysicsBody::collideWith(Model3D* other) {
 	
 	//Handle collision with other PhysicsBody
 	if (PhysicsBody* other_body = dynamic_cast<PhysicsBody*>(other)) {
-		ofVec3f displacement = (position - other_body->position);
-		ofVec3f norm_ba = displacement.getNormalized();
-		ofVec3f norm_ab = -norm_ba;
+		collideWithBody(other_body);
+	}
 
-		//Don't collide if the two bodies aren't close enough or aren't moving towards each other
-		if (displacement.length() > radius + other_body->radius || (velocity.dot(norm_ab) < 0 && other_body->velocity.dot(norm_ba) < 0)) {
-			return;
-		}
+	//Handle Collision with a Plane
+	else if (Plane* other_plane = dynamic_cast<Plane*>(other)) {
+		collideWithPlane(other_plane);
+	}
+}
 
-		//Method below for computing new velocities derived from https://studiofreya.com/3d-math-and-physics/simple-sphere-sphere-collision-detection-and-collision-response/
+void PhysicsBody::collideWithBody(PhysicsBody* other_body) {
+	bounceBodies(position, velocity, mass, radius, other_body->position, other_body->velocity, other_body->mass, other_body->radius);
+}
 
-		//Find Unit vector tangental to the object's displacement
-		ofVec3f tan_unit = displacement.getNormalized();
+void PhysicsBody::collideWithPlane(Plane* other_plane) {
+	ofVec3f local_basis0, local_basis1;
+	planeBasis(other_plane, local_basis0, local_basis1);
+	bounceOffPlane(position, velocity, radius, other_plane->position, other_plane->normal.getNormalized(), local_basis0, local_basis1, other_plane->size / 2.0f);
+}
 
-		//Find tangental velocities
-		ofVec3f tan_vel0 = velocity.dot(tan_unit) * tan_unit;
-		ofVec3f tan_vel1 = other_body->velocity.dot(tan_unit) * tan_unit;
+void PhysicsBody::bounceBodies(const ofVec3f& position0, ofVec3f& velocity0, float mass0, float radius0,
+	const ofVec3f& position1, ofVec3f& velocity1, float mass1, float radius1) {
+	ofVec3f displacement = (position0 - position1);
+	ofVec3f norm_ba = displacement.getNormalized();
+	ofVec3f norm_ab = -norm_ba;
 
-		//Find perpendicular velocities
-		ofVec3f perp_vel0 = velocity - tan_vel0;
-		ofVec3f perp_vel1 = other_body->velocity - tan_vel1;
+	//Don't collide if the two bodies aren't close enough or aren't moving towards each other
+	if (displacement.length() > radius0 + radius1 || (velocity0.dot(norm_ab) < 0 && velocity1.dot(norm_ba) < 0)) {
+		return;
+	}
 
-		velocity = ELASTICITY * (tan_vel0 * (mass - other_body->mass) / (mass + other_body->mass) + tan_vel1 * (2 * other_body->mass) / (mass + other_body->mass) + perp_vel0);
-		other_body->velocity = ELASTICITY * (tan_vel0 * (2 * mass) / (mass + other_body->mass) + tan_vel1 * (other_body->mass - mass) / (mass + other_body->mass) + perp_vel1);
+	//Method below for computing new velocities derived from https://studiofreya.com/3d-math-and-physics/simple-sphere-sphere-collision-detection-and-collision-response/
 
-		ofVec3f center = (mass / other_body->mass) * position + (other_body->mass / mass) * other->position;
-	}
+	//Find Unit vector tangental to the object's displacement
+	ofVec3f tan_unit = displacement.getNormalized();
 
-	//Handle Collision with a Plane
-	else if (Plane* other_plane = dynamic_cast<Plane*>(other)) {
-		//Derived by me :)
+	//Find tangental velocities
+	ofVec3f tan_vel0 = velocity0.dot(tan_unit) * tan_unit;
+	ofVec3f tan_vel1 = velocity1.dot(tan_unit) * tan_unit;
 
-		//Find the distance from the body's center to the plane
-		ofVec3f normal = other_plane->normal.getNormalized();
-		ofVec3f displacement = position - other_plane->position;
-		float normal_displacement_angle = std::acosf(displacement.dot(normal) / displacement.length());
-		float distance_to_plane = displacement.length() * std::cosf(normal_displacement_angle);
+	//Find perpendicular velocities
+	ofVec3f perp_vel0 = velocity0 - tan_vel0;
+	ofVec3f perp_vel1 = velocity1 - tan_vel1;
 
-		//Project the object's body's center onto the plane to find out if it's within bounds 
-		ofVec3f projected_center = position - distance_to_plane * normal;
-		ofVec3f displacement_from_projection = projected_center - other_plane->position;
+	velocity0 = ELASTICITY * (tan_vel0 * (mass0 - mass1) / (mass0 + mass1) + tan_vel1 * (2 * mass1) / (mass0 + mass1) + perp_vel0);
+	velocity1 = ELASTICITY * (tan_vel0 * (2 * mass0) / (mass0 + mass1) + tan_vel1 * (mass1 - mass0) / (mass0 + mass1) + perp_vel1);
+}
 
-		ofVec3f local_basis0 = ((other_plane->vertices[0] + other_plane->vertices[other_plane->size - 1]) / 2 - other_plane->position).getNormalized();
-		ofVec3f local_basis1 = (local_basis0.getCrossed(normal)).getNormalized();
-	
-		float x = std::abs(displacement_from_projection.dot(local_basis0));
-		float y = std::abs(displacement_from_projection.dot(local_basis1));
+void PhysicsBody::bounceOffPlane(ofVec3f& position, ofVec3f& velocity, float radius,
+	const ofVec3f& plane_position, const ofVec3f& normal, const ofVec3f& basis0, const ofVec3f& basis1, float half_size) {
+	//Derived by me :)
 
-		//If the body isn't close enough to the plane or it's projected point is not in the square, don't collide
-		if (distance_to_plane > radius || x > other_plane->size / 2.0f || y > other_plane->size / 2.0f) {
-			return;
-		}
+	//Find the distance from the body's center to the plane
+	ofVec3f displacement = position - plane_position;
+	float normal_displacement_angle = std::acosf(displacement.dot(normal) / displacement.length());
+	float distance_to_plane = displacement.length() * std::cosf(normal_displacement_angle);
 
-		//Decompose velocity into tangental and normal components
-		ofVec3f normal_vel = velocity.dot(normal) * normal;
-		ofVec3f tangental_vel = velocity - normal_vel;
+	//Project the object's body's center onto the plane to find out if it's within bounds 
+	ofVec3f projected_center = position - distance_to_plane * normal;
+	ofVec3f displacement_from_projection = projected_center - plane_position;
 
-		//Flip the normal component while keeping the tangental component the same
-		velocity = -1*normal_vel + tangental_vel;
+	float x = std::abs(displacement_from_projection.dot(basis0));
+	float y = std::abs(displacement_from_projection.dot(basis1));
 
-		//Set the position to one radius away from the plane so it is no longer colliding
-		position = projected_center + radius * normal;
+	//If the body isn't close enough to the plane or it's projected point is not in the square, don't collide
+	if (distance_to_plane > radius || x > half_size || y > half_size) {
+		return;
 	}
+
+	//Decompose velocity into tangental and normal components
+	ofVec3f normal_vel = velocity.dot(normal) * normal;
+	ofVec3f tangental_vel = velocity - normal_vel;
+
+	//Flip the normal component while keeping the tangental component the same
+	velocity = -1*normal_vel + tangental_vel;
+
+	//Set the position to one radius away from the plane so it is no longer colliding
+	position = projected_center + radius * normal;
+}
+
+void PhysicsBody::planeBasis(Plane* plane, ofVec3f& basis0, ofVec3f& basis1) {
+	//From the center of the plane to the middle of one of its edges, then along that edge
+	basis0 = ((plane->transformedVertex(0) + plane->transformedVertex(plane->size - 1)) / 2 - plane->position).getNormalized();
+	basis1 = (basis0.getCrossed(plane->normal.getNormalized())).getNormalized();
 }
 
 float PhysicsBody::average_radius() {
@@ -97,8 +117,8 @@ float PhysicsBody::average_radius() {
 	//Find the average length of all vectors in the object
 	float sum = 0.0f;
 
-	for (ofVec3f vert : vertices) {
+	for (ofVec3f vert : mesh->vertices) {
 		sum += vert.length();
 	}
-	return sum / vertices.size();
+	return sum * scale / mesh->vertices.size();
 }
@@ -6,13 +6,13 @@
 
 class PhysicsBody : public Model3D {
 private:
-	const float GRAVITATIONAL_CONSTANT = 0.002; 	/* How much things gravitate with each other (6.67408e-11 in real life) */
-	const float ELASTICITY = 1;			/* How much speed objects retain after a collision */
+	static constexpr float ELASTICITY = 1;			/* How much speed objects retain after a collision */
 
 	/* Computes the approximate radius of the body for treating it like a sphere in collisions */
 	float average_radius();
 
 public:
+	static constexpr float GRAVITATIONAL_CONSTANT = 0.002f; 	/* How much things gravitate with each other (6.67408e-11 in real life) */
 
 	//PhysicsBody constructor
 	PhysicsBody(std::string obj_path_, ofColor color_, float mass_, ofVec3f initial_pos_, ofVec3f initial_vel_, ofVec3f initial_angular_vel_, float size_scale_)
@@ -39,4 +39,23 @@ public:
 	/* Handles collisions between this PhysicsBody, and another PhysicsBody or Plane */
 	void collideWith(Model3D* other);
 
+	/* Bounces this PhysicsBody and another off each other if they are touching and moving towards each other */
+	void collideWithBody(PhysicsBody* other_body);
+
+	/* Bounces this PhysicsBody off a Plane if it is touching the plane's square */
+	void collideWithPlane(Plane* other_plane);
+
+	/* Bounces two bodies off each other if they are touching and moving towards each other, by changing their velocities.
+	   Shared by collideWithBody and PhysicsWorld */
+	static void bounceBodies(const ofVec3f& position0, ofVec3f& velocity0, float mass0, float radius0,
+		const ofVec3f& position1, ofVec3f& velocity1, float mass1, float radius1);
+
+	/* Bounces a body off the square of a plane if it is touching it, moving it back out to the plane's surface. The plane is given by its
+	   center, unit normal, unit vectors along two of its sides and half its width. Shared by collideWithPlane and PhysicsWorld */
+	static void bounceOffPlane(ofVec3f& position, ofVec3f& velocity, float radius,
+		const ofVec3f& plane_position, const ofVec3f& normal, const ofVec3f& basis0, const ofVec3f& basis1, float half_size);
+
+	/* Returns the unit vectors along two sides of a plane's square, as used by bounceOffPlane */
+	static void planeBasis(Plane* plane, ofVec3f& basis0, ofVec3f& basis1);
+
 };
\ No newline at end of file
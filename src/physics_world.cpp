@@ -0,0 +1,149 @@
+#include "physics_world.h"
+
+PhysicsWorld::Collider PhysicsWorld::makeCollider(Plane* plane) {
+	Collider collider;
+	collider.position = plane->position;
+	collider.normal = plane->normal.getNormalized();
+	PhysicsBody::planeBasis(plane, collider.basis0, collider.basis1);
+	collider.half_size = plane->size / 2.0f;
+	return collider;
+}
+
+void PhysicsWorld::readBody(uint32_t body) {
+	PhysicsBody* model = body_models[body];
+	bodies.setBody(body, model->position, model->mass, model->radius);
+	previous_positions[body] = model->position;
+	velocities[body] = model->velocity;
+	angular_velocities[body] = model->angular_vel;
+}
+
+void PhysicsWorld::addBody(PhysicsBody* body) {
+	uint32_t index = (uint32_t)body_models.size();
+	body_indices[body] = index;
+	body_models.push_back(body);
+	bodies.resize(index + 1);
+	velocities.push_back(ofVec3f());
+	angular_velocities.push_back(ofVec3f());
+	previous_positions.push_back(ofVec3f());
+	step_rotations.push_back(ofVec3f());
+	readBody(index);
+}
+
+void PhysicsWorld::addCollider(Plane* plane) {
+	collider_indices[plane] = (uint32_t)colliders.size();
+	colliders.push_back(makeCollider(plane));
+	collider_models.push_back(plane);
+}
+
+void PhysicsWorld::clear() {
+	bodies.resize(0);
+	velocities.clear();
+	angular_velocities.clear();
+	previous_positions.clear();
+	step_rotations.clear();
+	body_models.clear();
+	body_indices.clear();
+	colliders.clear();
+	collider_models.clear();
+	collider_indices.clear();
+}
+
+void PhysicsWorld::syncFromModel(const Model3D* model) {
+	auto body = body_indices.find(model);
+	if (body != body_indices.end()) {
+		readBody(body->second);
+	}
+	auto collider = collider_indices.find(model);
+	if (collider != collider_indices.end()) {
+		colliders[collider->second] = makeCollider(collider_models[collider->second]);
+	}
+}
+
+void PhysicsWorld::step(float time_interval, bool gravity, const Model3D* held_model) {
+	//Remember where every body was, to draw between here and where it ends up
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		previous_positions[i] = bodies.position(i);
+	}
+
+	//Every step's forces start from nothing, plus gravity if it's on
+	if (gravity) {
+		gravity_solver.applyForces(bodies);
+	}
+	else {
+		std::fill(bodies.fxs.begin(), bodies.fxs.end(), 0.0f);
+		std::fill(bodies.fys.begin(), bodies.fys.end(), 0.0f);
+		std::fill(bodies.fzs.begin(), bodies.fzs.end(), 0.0f);
+	}
+
+	//Handle collisions only between bodies the grid finds touching, in the same order as checking every pair
+	collision_grid.build(bodies);
+	collision_grid.findPairs(bodies, collision_pairs);
+	for (const std::pair<uint32_t, uint32_t>& pair : collision_pairs) {
+		PhysicsBody::bounceBodies(bodies.position(pair.first), velocities[pair.first], bodies.masses[pair.first], bodies.radii[pair.first],
+			bodies.position(pair.second), velocities[pair.second], bodies.masses[pair.second], bodies.radii[pair.second]);
+	}
+
+	//Handle collisions with planes
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		ofVec3f position = bodies.position(i);
+		for (const Collider& collider : colliders) {
+			PhysicsBody::bounceOffPlane(position, velocities[i], bodies.radii[i], collider.position, collider.normal, collider.basis0, collider.basis1, collider.half_size);
+		}
+		bodies.setBody(i, position, bodies.masses[i], bodies.radii[i]);
+	}
+
+	//Move every body except the held one, so that it can still be "grabbed"
+	auto held = body_indices.find(held_model);
+	uint32_t held_index = held != body_indices.end() ? held->second : UINT32_MAX;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		if (i == held_index) {
+			continue;
+		}
+		ofVec3f acceleration = bodies.force(i) / bodies.masses[i];	/* F = ma */
+		velocities[i] += acceleration * time_interval;			/* delta v = a * delta t */
+		bodies.setBody(i, bodies.position(i) + velocities[i] * time_interval, bodies.masses[i], bodies.radii[i]);	/* delta r = v * delta t */
+		step_rotations[i] += angular_velocities[i] * time_interval;	/* delta theta = omega * delta t */
+	}
+}
+
+void PhysicsWorld::writeToModels(float interpolation) {
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		PhysicsBody* model = body_models[i];
+		model->position = previous_positions[i].getInterpolated(bodies.position(i), interpolation);
+		model->velocity = velocities[i];
+		model->angular_vel = angular_velocities[i];
+		model->acceleration = bodies.force(i) / bodies.masses[i];
+		model->force = ofVec3f(0, 0, 0);
+		if (step_rotations[i] != ofVec3f()) {
+			model->rotate(step_rotations[i]);
+			step_rotations[i] = ofVec3f();
+		}
+	}
+}
+
+size_t PhysicsWorld::bodyCount() const {
+	return body_models.size();
+}
+
+size_t PhysicsWorld::colliderCount() const {
+	return colliders.size();
+}
+
+PhysicsBody* PhysicsWorld::bodyModel(size_t body) const {
+	return body_models[body];
+}
+
+ofVec3f PhysicsWorld::bodyPosition(size_t body) const {
+	return bodies.position(body);
+}
+
+void PhysicsWorld::bodyInstances(const Mesh* mesh, std::vector<ModelInstance>& instances, std::vector<uint32_t>& others) const {
+	for (uint32_t i = 0; i < body_models.size(); i++) {
+		if (body_models[i]->mesh.get() == mesh) {
+			instances.push_back(body_models[i]->instance());
+		}
+		else {
+			others.push_back(i);
+		}
+	}
+}
@@ -0,0 +1,87 @@
+// PHYSICS WORLD - Defines the PhysicsWorld class - the physics state of every body and plane in the scene, kept in contiguous arrays and stepped without touching the models
+
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ofMain.h"
+#include "physics_body.h"
+#include "plane.h"
+#include "body_store.h"
+#include "collision_grid.h"
+#include "gravity_solver.h"
+
+class PhysicsWorld {
+
+private:
+	/* A static Plane's square, with everything PhysicsBody::bounceOffPlane needs worked out when it is added */
+	struct Collider {
+		ofVec3f position;	/* Center of the square */
+		ofVec3f normal;		/* Unit normal of the plane */
+		ofVec3f basis0;		/* Unit vector along one side of the square */
+		ofVec3f basis1;		/* Unit vector along the other side */
+		float half_size = 0;	/* Half the width of the square */
+	};
+
+	BodyStore bodies;					/* Position, mass, radius and force of every body */
+	std::vector<ofVec3f> velocities;			/* Velocity of every body */
+	std::vector<ofVec3f> angular_velocities;		/* Angular velocity of every body */
+	std::vector<ofVec3f> previous_positions;		/* Position of every body before the last step, for drawing between steps */
+	std::vector<ofVec3f> step_rotations;			/* Rotation of every body over the steps not yet written to its model */
+	std::vector<PhysicsBody*> body_models;			/* The model of every body, which its pose is written back to */
+	std::unordered_map<const Model3D*, uint32_t> body_indices;	/* Index of the body of each model */
+
+	std::vector<Collider> colliders;			/* Every plane the bodies bounce off */
+	std::vector<Plane*> collider_models;			/* The model of every collider */
+	std::unordered_map<const Model3D*, uint32_t> collider_indices;	/* Index of the collider of each model */
+
+	CollisionGrid collision_grid;				/* Finds the bodies close enough to collide, rebuilt every step */
+	std::vector<std::pair<uint32_t, uint32_t>> collision_pairs;	/* Indices of each pair of touching bodies. Reused every step */
+
+	/* Returns the collider of a plane where it is now */
+	static Collider makeCollider(Plane* plane);
+
+	/* Copies a body's position, velocity and angular velocity from its model. The body starts over from there, with no previous position to draw from */
+	void readBody(uint32_t body);
+
+public:
+	GravitySolver gravity_solver;		/* Pulls the bodies toward each other when a step asks for gravity */
+
+	/* Adds a body, copying its position, velocity, mass and radius from the model. The model must outlive its place in the world */
+	void addBody(PhysicsBody* body);
+
+	/* Adds a static plane for the bodies to bounce off, where it is now */
+	void addCollider(Plane* plane);
+
+	/* Removes every body and collider */
+	void clear();
+
+	/* Copies a model's position and velocities into the world after something other than a step moved it, like the mouse */
+	void syncFromModel(const Model3D* model);
+
+	/* Advances every body by a time interval: gravity if asked for, collisions between bodies, bouncing off planes, then movement.
+	   The held model's body still collides but doesn't move, so it can be dragged. Only reads and writes the world's own arrays */
+	void step(float time_interval, bool gravity, const Model3D* held_model = nullptr);
+
+	/* Writes every body's velocities and the rotation of the steps since the last write back to its model, and clears its force.
+	   The model is drawn an interpolation from 0 to 1 of the way from the body's position before the last step to its position now */
+	void writeToModels(float interpolation = 1);
+
+	/* Returns the number of bodies */
+	size_t bodyCount() const;
+
+	/* Returns the number of colliders */
+	size_t colliderCount() const;
+
+	/* Returns the model of a body */
+	PhysicsBody* bodyModel(size_t body) const;
+
+	/* Returns the position of a body */
+	ofVec3f bodyPosition(size_t body) const;
+
+	/* Appends the pose last written to the model of every body whose mesh is the given one, for drawing those bodies as instances of it.
+	   Appends the index of every other body to others */
+	void bodyInstances(const Mesh* mesh, std::vector<ModelInstance>& instances, std::vector<uint32_t>& others) const;
+};
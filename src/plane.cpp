@@ -6,17 +6,26 @@ Plane::Plane(ofVec3f position_, ofVec3f normal_, ofColor color_, int size_) {
 	normal = normal_;
 	color = color_;
 	size = size_;
-	generatePlane(size);
-	fixVertices(1.0f);
+
+	//Planes are generated instead of read from a file, so each one owns its mesh
+	std::shared_ptr<Mesh> plane_mesh = std::make_shared<Mesh>();
+	generatePlane(*plane_mesh, size);
+	plane_mesh->centerVertices();
+	plane_mesh->splitVertexComponents();
+	plane_mesh->computeBoundingRadius();
+
+	//No edge adjacency, since the outline of a flat grid is only its border. Without it, outline mode still draws the whole grid
+	mesh = plane_mesh;
+
 	rotateToNormal(normal);
 }
 
-void Plane::generatePlane(int size) {
+void Plane::generatePlane(Mesh& plane_mesh, int size) {
 
 	//Generate vertices
 	for (int row = 0; row < size; row++) {
 		for (int col = 0; col < size; col++) {
-			vertices.push_back(ofVec3f(row, 0, col));
+			plane_mesh.vertices.push_back(ofVec3f(row, 0, col));
 		}
 	}
 
@@ -25,7 +34,16 @@ void Plane::generatePlane(int size) {
 		for (int j = 0; j < size - 1; j++) {
 			int top = i + size * j;
 			int bottom = i + size * (j+1);
-			edges.push_back(ofVec2f(top, bottom));
+			plane_mesh.edges.push_back(Edge(top, bottom));
+		}
+	}
+
+	//Generate faces, two triangles per square, so the plane can hide lines behind it
+	for (int row = 0; row < size - 1; row++) {
+		for (int col = 0; col < size - 1; col++) {
+			uint32_t corner = row * size + col;
+			plane_mesh.triangles.insert(plane_mesh.triangles.end(), { corner, corner + size, corner + 1 });
+			plane_mesh.triangles.insert(plane_mesh.triangles.end(), { corner + 1, corner + size, corner + size + 1 });
 		}
 	}
 
@@ -34,7 +52,7 @@ void Plane::generatePlane(int size) {
 		for (int j = 0; j < size - 1; j++) {
 			int left = i + j;
 			int right = i + j + 1;
-			edges.push_back(ofVec2f(left, right));
+			plane_mesh.edges.push_back(Edge(left, right));
 		}
 	}
 
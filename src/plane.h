@@ -7,8 +7,8 @@
 class Plane : public Model3D {
 
 private:
-	/* Given a size, generates the set of size*size vertices and edges connecting them to define a square-shaped plane */
-	void generatePlane(int size);
+	/* Given a size, fills plane_mesh with the set of size*size vertices and edges connecting them to define a square-shaped plane */
+	void generatePlane(Mesh& plane_mesh, int size);
 
 	/* Rotates the plane so that the given vector is its normal vector */
 	void rotateToNormal(ofVec3f normal);
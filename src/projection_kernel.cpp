@@ -0,0 +1,235 @@
+#include "projection_kernel.h"
+#include "simd_target.h"
+
+//The SIMD paths write two floats per vertex straight into the output array
+static_assert(sizeof(ofVec2f) == 2 * sizeof(float), "ofVec2f must be two packed floats");
+
+static bool cpuSupportsAVX2() {
+#if !defined(SIMD_TARGET_X64)
+	return false;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+
+	//The OS also has to save the upper halves of the registers on a context switch (OSXSAVE, then the YMM bits of XCR0)
+	__cpuid(info, 1);
+	bool avx = (info[2] & (1 << 28)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	if (!avx || !osxsave || (_xgetbv(0) & 6) != 6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+ProjectionKernel::Path ProjectionKernel::bestPath() {
+	static const Path best_path = supports(AVX2) ? AVX2 : (supports(SSE) ? SSE : SCALAR);
+	return best_path;
+}
+
+bool ProjectionKernel::supports(Path path) {
+	switch (path) {
+	case AVX2:
+		return cpuSupportsAVX2();
+	case SSE:
+#ifdef SIMD_TARGET_X64
+		//SSE2 is part of x86-64 itself
+		return true;
+#else
+		return false;
+#endif
+	default:
+		return true;
+	}
+}
+
+void ProjectionKernel::project(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params,
+	ofVec2f* out, uint8_t* outcodes, Path path) {
+
+	//Fall back on the fastest path this CPU can actually run
+	if (!supports(path)) {
+		path = bestPath();
+	}
+
+	switch (path) {
+	case AVX2:
+		projectAVX2(xs, ys, zs, n, params, out, outcodes);
+		break;
+	case SSE:
+		projectSSE(xs, ys, zs, n, params, out, outcodes);
+		break;
+	default:
+		projectScalar(xs, ys, zs, n, params, out, outcodes);
+		break;
+	}
+}
+
+uint8_t ProjectionKernel::outcode(float view_z, ofVec2f point, const ProjectionParams& params) {
+	if (!(view_z < params.near_z)) {
+		return BEHIND;
+	}
+
+	//Written as "not inside" so that a coordinate that is not a number counts as outside
+	uint8_t code = 0;
+	code |= !(point.x >= params.min_x) ? LEFT : 0;
+	code |= !(point.x <= params.max_x) ? RIGHT : 0;
+	code |= !(point.y >= params.min_y) ? ABOVE : 0;
+	code |= !(point.y <= params.max_y) ? BELOW : 0;
+	return code;
+}
+
+void ProjectionKernel::projectScalar(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes) {
+	const float* m = params.matrix;
+	for (size_t i = 0; i < n; i++) {
+		//Same operations in the same order as Camera::project(Model3D::applyMatrix(matrix, vertex) + offset), so the results match exactly
+		float x = m[0] * xs[i] + m[1] * ys[i] + m[2] * zs[i] + params.offset[0];
+		float y = m[3] * xs[i] + m[4] * ys[i] + m[5] * zs[i] + params.offset[1];
+		float z = m[6] * xs[i] + m[7] * ys[i] + m[8] * zs[i] + params.offset[2];
+
+		//Points behind the near plane get the out of bounds point
+		if (z < params.near_z) {
+			float depth_scale = 1.0f / z;
+			out[i] = ofVec2f(params.center_x - x * depth_scale, params.center_y + y * depth_scale);
+		}
+		else {
+			out[i] = ofVec2f(params.out_x, params.out_y);
+		}
+		outcodes[i] = outcode(z, out[i], params);
+	}
+}
+
+#ifdef SIMD_TARGET_X64
+
+void ProjectionKernel::projectSSE(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes) {
+	const float* m = params.matrix;
+	__m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+	__m128 m3 = _mm_set1_ps(m[3]), m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]);
+	__m128 m6 = _mm_set1_ps(m[6]), m7 = _mm_set1_ps(m[7]), m8 = _mm_set1_ps(m[8]);
+	__m128 offset_x = _mm_set1_ps(params.offset[0]), offset_y = _mm_set1_ps(params.offset[1]), offset_z = _mm_set1_ps(params.offset[2]);
+	__m128 center_x = _mm_set1_ps(params.center_x), center_y = _mm_set1_ps(params.center_y);
+	__m128 min_x = _mm_set1_ps(params.min_x), max_x = _mm_set1_ps(params.max_x);
+	__m128 min_y = _mm_set1_ps(params.min_y), max_y = _mm_set1_ps(params.max_y);
+	__m128 out_x = _mm_set1_ps(params.out_x), out_y = _mm_set1_ps(params.out_y);
+	__m128 near_z = _mm_set1_ps(params.near_z);
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128i behind_bit = _mm_set1_epi32(BEHIND), left_bit = _mm_set1_epi32(LEFT), right_bit = _mm_set1_epi32(RIGHT);
+	__m128i above_bit = _mm_set1_epi32(ABOVE), below_bit = _mm_set1_epi32(BELOW);
+
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(xs + i);
+		__m128 vy = _mm_loadu_ps(ys + i);
+		__m128 vz = _mm_loadu_ps(zs + i);
+
+		__m128 x = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, vx), _mm_mul_ps(m1, vy)), _mm_mul_ps(m2, vz)), offset_x);
+		__m128 y = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, vx), _mm_mul_ps(m4, vy)), _mm_mul_ps(m5, vz)), offset_y);
+		__m128 z = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m6, vx), _mm_mul_ps(m7, vy)), _mm_mul_ps(m8, vz)), offset_z);
+
+		//Project every lane, then swap in the out of bounds point wherever the vertex was behind the near plane
+		__m128 in_front = _mm_cmplt_ps(z, near_z);
+		__m128 depth_scale = _mm_div_ps(one, z);
+		__m128 screen_x = _mm_sub_ps(center_x, _mm_mul_ps(x, depth_scale));
+		__m128 screen_y = _mm_add_ps(center_y, _mm_mul_ps(y, depth_scale));
+		screen_x = _mm_or_ps(_mm_and_ps(in_front, screen_x), _mm_andnot_ps(in_front, out_x));
+		screen_y = _mm_or_ps(_mm_and_ps(in_front, screen_y), _mm_andnot_ps(in_front, out_y));
+
+		//Build the outcodes 32 bits per lane. The side bits only apply in front of the camera, and "not inside" catches not-a-numbers
+		__m128i behind = _mm_andnot_si128(_mm_castps_si128(in_front), behind_bit);
+		__m128i left = _mm_and_si128(_mm_castps_si128(_mm_andnot_ps(_mm_cmpge_ps(screen_x, min_x), in_front)), left_bit);
+		__m128i right = _mm_and_si128(_mm_castps_si128(_mm_andnot_ps(_mm_cmple_ps(screen_x, max_x), in_front)), right_bit);
+		__m128i above = _mm_and_si128(_mm_castps_si128(_mm_andnot_ps(_mm_cmpge_ps(screen_y, min_y), in_front)), above_bit);
+		__m128i below = _mm_and_si128(_mm_castps_si128(_mm_andnot_ps(_mm_cmple_ps(screen_y, max_y), in_front)), below_bit);
+		__m128i codes = _mm_or_si128(_mm_or_si128(_mm_or_si128(behind, left), _mm_or_si128(right, above)), below);
+
+		//Interleave x and y into four ofVec2fs
+		_mm_storeu_ps(reinterpret_cast<float*>(out + i), _mm_unpacklo_ps(screen_x, screen_y));
+		_mm_storeu_ps(reinterpret_cast<float*>(out + i + 2), _mm_unpackhi_ps(screen_x, screen_y));
+
+		//Every code fits in the lowest byte of its lane
+		int32_t lane_codes[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lane_codes), codes);
+		for (int lane = 0; lane < 4; lane++) {
+			outcodes[i + lane] = (uint8_t)lane_codes[lane];
+		}
+	}
+
+	//Finish off the vertices that don't fill a whole register
+	projectScalar(xs + i, ys + i, zs + i, n - i, params, out + i, outcodes + i);
+}
+
+AVX2_FUNCTION void ProjectionKernel::projectAVX2(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes) {
+	const float* m = params.matrix;
+	__m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+	__m256 m3 = _mm256_set1_ps(m[3]), m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]);
+	__m256 m6 = _mm256_set1_ps(m[6]), m7 = _mm256_set1_ps(m[7]), m8 = _mm256_set1_ps(m[8]);
+	__m256 offset_x = _mm256_set1_ps(params.offset[0]), offset_y = _mm256_set1_ps(params.offset[1]), offset_z = _mm256_set1_ps(params.offset[2]);
+	__m256 center_x = _mm256_set1_ps(params.center_x), center_y = _mm256_set1_ps(params.center_y);
+	__m256 min_x = _mm256_set1_ps(params.min_x), max_x = _mm256_set1_ps(params.max_x);
+	__m256 min_y = _mm256_set1_ps(params.min_y), max_y = _mm256_set1_ps(params.max_y);
+	__m256 out_x = _mm256_set1_ps(params.out_x), out_y = _mm256_set1_ps(params.out_y);
+	__m256 near_z = _mm256_set1_ps(params.near_z);
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256i behind_bit = _mm256_set1_epi32(BEHIND), left_bit = _mm256_set1_epi32(LEFT), right_bit = _mm256_set1_epi32(RIGHT);
+	__m256i above_bit = _mm256_set1_epi32(ABOVE), below_bit = _mm256_set1_epi32(BELOW);
+
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(xs + i);
+		__m256 vy = _mm256_loadu_ps(ys + i);
+		__m256 vz = _mm256_loadu_ps(zs + i);
+
+		//Separate multiplies and adds rather than FMA, so the results round exactly like the scalar path
+		__m256 x = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, vx), _mm256_mul_ps(m1, vy)), _mm256_mul_ps(m2, vz)), offset_x);
+		__m256 y = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m3, vx), _mm256_mul_ps(m4, vy)), _mm256_mul_ps(m5, vz)), offset_y);
+		__m256 z = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m6, vx), _mm256_mul_ps(m7, vy)), _mm256_mul_ps(m8, vz)), offset_z);
+
+		//Project every lane, then swap in the out of bounds point wherever the vertex was behind the near plane
+		__m256 in_front = _mm256_cmp_ps(z, near_z, _CMP_LT_OQ);
+		__m256 depth_scale = _mm256_div_ps(one, z);
+		__m256 screen_x = _mm256_blendv_ps(out_x, _mm256_sub_ps(center_x, _mm256_mul_ps(x, depth_scale)), in_front);
+		__m256 screen_y = _mm256_blendv_ps(out_y, _mm256_add_ps(center_y, _mm256_mul_ps(y, depth_scale)), in_front);
+
+		//Build the outcodes 32 bits per lane. The side bits only apply in front of the camera, and "not inside" catches not-a-numbers
+		__m256i behind = _mm256_andnot_si256(_mm256_castps_si256(in_front), behind_bit);
+		__m256i left = _mm256_and_si256(_mm256_castps_si256(_mm256_andnot_ps(_mm256_cmp_ps(screen_x, min_x, _CMP_GE_OQ), in_front)), left_bit);
+		__m256i right = _mm256_and_si256(_mm256_castps_si256(_mm256_andnot_ps(_mm256_cmp_ps(screen_x, max_x, _CMP_LE_OQ), in_front)), right_bit);
+		__m256i above = _mm256_and_si256(_mm256_castps_si256(_mm256_andnot_ps(_mm256_cmp_ps(screen_y, min_y, _CMP_GE_OQ), in_front)), above_bit);
+		__m256i below = _mm256_and_si256(_mm256_castps_si256(_mm256_andnot_ps(_mm256_cmp_ps(screen_y, max_y, _CMP_LE_OQ), in_front)), below_bit);
+		__m256i codes = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(behind, left), _mm256_or_si256(right, above)), below);
+
+		//Interleave x and y. The unpacks work within each 128 bit half, so the halves are put back in order afterwards
+		__m256 low = _mm256_unpacklo_ps(screen_x, screen_y);
+		__m256 high = _mm256_unpackhi_ps(screen_x, screen_y);
+		_mm256_storeu_ps(reinterpret_cast<float*>(out + i), _mm256_permute2f128_ps(low, high, 0x20));
+		_mm256_storeu_ps(reinterpret_cast<float*>(out + i + 4), _mm256_permute2f128_ps(low, high, 0x31));
+
+		//Every code fits in the lowest byte of its lane
+		int32_t lane_codes[8];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_codes), codes);
+		for (int lane = 0; lane < 8; lane++) {
+			outcodes[i + lane] = (uint8_t)lane_codes[lane];
+		}
+	}
+
+	//Finish off the vertices that don't fill a whole register
+	projectScalar(xs + i, ys + i, zs + i, n - i, params, out + i, outcodes + i);
+}
+
+#else
+
+//No SIMD paths outside x86-64. supports() returns false for both, so project() never gets here, but keep them callable
+void ProjectionKernel::projectSSE(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes) {
+	projectScalar(xs, ys, zs, n, params, out, outcodes);
+}
+
+void ProjectionKernel::projectAVX2(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes) {
+	projectScalar(xs, ys, zs, n, params, out, outcodes);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+// PROJECTION KERNEL - Defines the ProjectionKernel class - for projecting many vertices to the screen at once using SIMD instructions
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ofMain.h"
+
+/* Everything the kernel needs to know about the camera and the model being projected. Built by Camera::projectionParams() */
+struct ProjectionParams {
+	float matrix[9];		/* Row-major model-view matrix, with the camera's field_of_view folded into the first two rows */
+	float offset[3];		/* Added to every vertex after the matrix. The model's position relative to the camera, in view space */
+	float near_z;			/* View space z of the near plane. Only vertices with a smaller (more negative) z are in front of the camera */
+	float center_x, center_y;	/* Center of the screen */
+	float min_x, max_x;		/* Horizontal limits of the viewport */
+	float min_y, max_y;		/* Vertical limits of the viewport */
+	float out_x, out_y;		/* Camera::out_of_bounds_point, returned for vertices behind the near plane */
+};
+
+class ProjectionKernel {
+
+public:
+
+	// Outcode bits, saying which sides of the view a vertex is outside of. A vertex with an outcode of 0 is visible
+	static constexpr uint8_t BEHIND = 1;	/* Behind the near plane. None of the other bits are set, since the screen coordinate is meaningless */
+	static constexpr uint8_t LEFT = 2;		/* Left of the viewport (or not a number) */
+	static constexpr uint8_t RIGHT = 4;		/* Right of the viewport (or not a number) */
+	static constexpr uint8_t ABOVE = 8;		/* Above the viewport (or not a number) */
+	static constexpr uint8_t BELOW = 16;	/* Below the viewport (or not a number) */
+
+	/* Instruction sets the kernel can use, from slowest to fastest */
+	enum Path {
+		SCALAR, SSE, AVX2
+	};
+
+	/* Returns the fastest path this CPU supports. Detected once, the first time it is called */
+	static Path bestPath();
+
+	/* Returns whether this CPU and build can run the given path */
+	static bool supports(Path path);
+
+	/* Returns the outcode of a vertex with the given view space z and screen coordinate */
+	static uint8_t outcode(float view_z, ofVec2f point, const ProjectionParams& params);
+
+	/* Projects n vertices, given as separate arrays of x, y and z components, with the same results as Camera::transform.
+	   Writes a screen coordinate to out and an outcode to outcodes */
+	static void project(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params,
+		ofVec2f* out, uint8_t* outcodes, Path path = bestPath());
+
+	/* Projects vertices one at a time. Used for any path the CPU doesn't support and for the last few vertices of the SIMD paths */
+	static void projectScalar(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes);
+
+	/* Projects vertices four at a time with SSE. Only available in x86-64 builds */
+	static void projectSSE(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes);
+
+	/* Projects vertices eight at a time with AVX2. Only call this if supports(AVX2) */
+	static void projectAVX2(const float* xs, const float* ys, const float* zs, size_t n, const ProjectionParams& params, ofVec2f* out, uint8_t* outcodes);
+};
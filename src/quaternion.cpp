@@ -0,0 +1,54 @@
+#include "quaternion.h"
+
+Quaternion::Quaternion() {
+	//Default values are the identity rotation
+}
+
+Quaternion::Quaternion(float w_, float x_, float y_, float z_) {
+	w = w_;
+	x = x_;
+	y = y_;
+	z = z_;
+}
+
+Quaternion Quaternion::fromRotationVector(ofVec3f rotation_vector) {
+	//Rotation angle is the magnitude of the rotation vector. A zero vector is no rotation at all
+	float angle = rotation_vector.length();
+	if (angle == 0.0f) {
+		return Quaternion();
+	}
+
+	//Axis-angle to quaternion from https://en.wikipedia.org/wiki/Quaternions_and_spatial_rotation#Using_quaternion_as_rotations
+	ofVec3f axis = rotation_vector / angle;
+	float sin = std::sinf(angle / 2);
+	return Quaternion(std::cosf(angle / 2), axis.x * sin, axis.y * sin, axis.z * sin);
+}
+
+Quaternion Quaternion::operator*(const Quaternion& other) const {
+	//Hamilton product
+	return Quaternion(
+		w * other.w - x * other.x - y * other.y - z * other.z,
+		w * other.x + x * other.w + y * other.z - z * other.y,
+		w * other.y - x * other.z + y * other.w + z * other.x,
+		w * other.z + x * other.y - y * other.x + z * other.w
+	);
+}
+
+void Quaternion::normalize() {
+	float length = std::sqrt(w * w + x * x + y * y + z * z);
+	if (length > 0.0f) {
+		w /= length;
+		x /= length;
+		y /= length;
+		z /= length;
+	}
+}
+
+ofMatrix3x3 Quaternion::toMatrix() const {
+	//Quaternion to rotation matrix from https://en.wikipedia.org/wiki/Quaternions_and_spatial_rotation#Quaternion-derived_rotation_matrix
+	return ofMatrix3x3(
+		1 - 2*(y*y + z*z),   2*(x*y - z*w),       2*(x*z + y*w),
+		2*(x*y + z*w),       1 - 2*(x*x + z*z),   2*(y*z - x*w),
+		2*(x*z - y*w),       2*(y*z + x*w),       1 - 2*(x*x + y*y)
+	);
+}
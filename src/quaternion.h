@@ -0,0 +1,32 @@
+// QUATERNION - Defines the Quaternion class - a unit quaternion for storing the orientation of a 3D model without drift
+
+#pragma once
+
+#include "ofMain.h"
+
+class Quaternion {
+
+public:
+	float w = 1.0f;		/* Real part */
+	float x = 0.0f;		/* i component */
+	float y = 0.0f;		/* j component */
+	float z = 0.0f;		/* k component */
+
+	//Default Quaternion constructor - the identity rotation
+	Quaternion();
+
+	//Quaternion constructor
+	Quaternion(float w_, float x_, float y_, float z_);
+
+	/* Returns the rotation about a given axis by an angle given by the magnitude of that axis */
+	static Quaternion fromRotationVector(ofVec3f rotation_vector);
+
+	/* Returns the rotation that applies other first, then this one */
+	Quaternion operator*(const Quaternion& other) const;
+
+	/* Rescales the quaternion to unit length, undoing any floating point error picked up from repeated multiplication */
+	void normalize();
+
+	/* Returns the 3x3 rotation matrix for this quaternion */
+	ofMatrix3x3 toMatrix() const;
+};
@@ -87,47 +87,23 @@ void Renderer::updateCamera() {
 
 void Renderer::updatePhysics() {
 
-	//If the frame time is too large, don't update anything. This keeps large chaotic velocities from breaking the program
-	if (frame_time <= 0.2) {
-
-		
-		if (scene_models.size() > 0) {
-			//Exert gravity and handle collision between every two PhysicsBodies in the scene
-			for (int i = 0; i < scene_models.size() - 1; i++) {
-				if (PhysicsBody* body0 = dynamic_cast<PhysicsBody*>(scene_models[i])) {
-					for (int j = i + 1; j < scene_models.size(); j++) {
-						if (PhysicsBody* body1 = dynamic_cast<PhysicsBody*>(scene_models[j])) {
-							if (current_demo == PLANETS) {
-								body0->gravitateWith(body1);
-							}
-							body0->collideWith(body1);
-						}
-					}
-				}
-			}
-			//Handle collisions with planes
-			for (int i = 0; i < scene_models.size(); i++) {
-				if (PhysicsBody* body0 = dynamic_cast<PhysicsBody*>(scene_models[i])) {
-					for (int j = 0; j < scene_models.size(); j++) {
-						if (Plane* plane = dynamic_cast<Plane*>(scene_models[j])) {
-							body0->collideWith(plane);
-						}
-					}
-				}
-			}
-		}
-
-		//Update bodies and reset all force vectors
-		for (Model3D* model : scene_models) {
-			if (PhysicsBody* body = dynamic_cast<PhysicsBody*>(model)) {
-				//If in edit mode, don't move the object, so that it can still be "grabbed"
-				if (edit_mode_model != model) {
-					body->update(frame_time);
-				}
-				body->force = ofVec3f(0, 0, 0);
-			}
-		}
-	}
+	//Pull with gravity between every two PhysicsBodies in the planets demo, exactly or with the octree
+	physics_world.gravity_solver.method = barnes_hut_toggle ? GravitySolver::BARNES_HUT : GravitySolver::DIRECT;
+	physics_world.gravity_solver.opening_angle = opening_angle_slider;
+	physics_world.gravity_solver.softening = softening_slider;
+
+	//Step the simulation at a fixed rate no matter the frame rate, so it behaves the same on every computer. A frame that takes
+	//longer than the most steps allowed slows the simulation down for that frame instead of stopping it or piling up steps
+	physics_timestep.step_time = 1.0f / physics_rate_slider;
+	physics_timestep.max_steps = max_physics_steps_slider;
+	physics_step_count = physics_timestep.advance(frame_time);
+	for (int i = 0; i < physics_step_count; i++) {
+		//If in edit mode, the grabbed body doesn't move, so that it can still be "grabbed"
+		physics_world.step(physics_timestep.step_time, current_demo == PLANETS, edit_mode_model);
+	}
+
+	//Draw the models between the last two steps, by how far this frame is into the next one, so motion is smooth between steps
+	physics_world.writeToModels(physics_timestep.interpolation());
 }
 
 void Renderer::clearScene() {
@@ -136,6 +112,38 @@ void Renderer::clearScene() {
 		delete scene_models[i];
 	}
 	scene_models.clear();
+	static_models.clear();
+	physics_world.clear();
+	physics_timestep.reset();	/* A new scene doesn't inherit the old one's leftover time */
+	scene_bvh_dirty = true;
+}
+
+void Renderer::addModel(Model3D* model) {
+	scene_models.push_back(model);
+	static_models.push_back(model);
+	scene_bvh_dirty = true;
+}
+
+void Renderer::addPhysicsBody(PhysicsBody* body) {
+	scene_models.push_back(body);
+	physics_world.addBody(body);
+}
+
+void Renderer::addPlane(Plane* plane) {
+	addModel(plane);
+	physics_world.addCollider(plane);
+}
+
+void Renderer::updateSceneBVH() {
+	//The structure only has to change when the set of models does. Moving models just stretch the boxes around them
+	if (scene_bvh_dirty) {
+		scene_bvh.build(static_models);
+		scene_bvh_dirty = false;
+	}
+	else if (scene_bvh_moved) {
+		scene_bvh.refit();
+	}
+	scene_bvh_moved = false;
 }
 
 void Renderer::updateHead() {
@@ -178,6 +186,70 @@ Renderer::Renderer(int width, int height) {
     win_height = height;
 }
 
+Renderer::Renderer(const HeadlessOptions& options) {
+	headless_options = options;
+	win_width = options.width;
+	win_height = options.height;
+}
+
+void Renderer::setupHeadless() {
+	//Use the given seed rather than the time, so the box demo is the same on every run
+	std::srand(headless_options.seed);
+
+	//Draw frames as fast as possible instead of in real time
+	ofSetFrameRate(0);
+
+	//Settings that are normally chosen in the GUI. Head control needs the webcam, so it stays off
+	walk_mode_toggle = false;
+	osd_toggle = false;
+	head_control_toggle = false;
+	software_raster_toggle = true;
+	anti_aliasing_toggle = headless_options.anti_aliasing;
+	hidden_line_toggle = headless_options.hidden_lines;
+	outline_toggle = headless_options.outlines_only;
+	decimation_radius_slider = 40;
+	marker_radius_slider = 2;
+	min_edge_length_slider = 0.5f;
+	physics_rate_slider = headless_options.physics_rate;
+	max_physics_steps_slider = 8;
+	barnes_hut_toggle = headless_options.gravity == "barnes-hut";
+	opening_angle_slider = 0.5f;
+	softening_slider = 0;
+	floor_toggle = headless_options.show_floor;
+	box_size_slider = 20;
+	num_balls_slider = 20;
+
+	//Start the chosen demo
+	if (headless_options.demo == "planets") {
+		initPlanetsDemo();
+	}
+	else if (headless_options.demo == "models") {
+		initModelsDemo();
+	}
+	else if (headless_options.demo == "box") {
+		initBoxDemo();
+	}
+}
+
+void Renderer::drawHeadless() {
+	//There is no GL context, so the frame only ever exists in the software rasterizer's framebuffer
+	software_rasterizer.anti_aliasing = headless_options.anti_aliasing;
+	software_rasterizer.rasterize(line_batch);
+
+	if (headless_options.shouldSave(headless_frame)) {
+		std::string frame_path = headless_options.framePath(headless_frame);
+		if (!software_rasterizer.save(frame_path)) {
+			std::cout << "Unable to save " << frame_path << std::endl;
+		}
+	}
+
+	//Stop once every frame has been drawn
+	headless_frame++;
+	if (headless_frame >= headless_options.frame_count) {
+		ofExit(0);
+	}
+}
+
 
 ///////////////// GUI BUTTON PRESSES \\\\\\\\\\\\\\\\\\\\\\\\\\\
 
@@ -185,20 +257,20 @@ void Renderer::initPlanetsDemo() {
 	//Clear models and add demo planet set
 	current_demo = PLANETS;
 	clearScene();
-	scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 100, ofVec3f(10, 0, 0), ofVec3f(0, 5, 0), ofVec3f(0.5, -0.5, 0.5), 0.1)); /* "Planet" */
-	scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::green, 200, ofVec3f(0, 0, 8), ofVec3f(0, -5, 0), ofVec3f(-0.5, -0.5, 0.5), 0.12)); /* "Planet" */
-	scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::blue, 150, ofVec3f(6, 0, 6), ofVec3f(0, -5, 0), ofVec3f(-0.5, -0.5, 0.5), 0.2)); /* "Planet" */
-	scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::red, 100, ofVec3f(0, 0, -10), ofVec3f(4, 0, 0), ofVec3f(-0.5, -0.5, 0.5), 0.1)); /* "Planet" */
-	scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::yellow, 300000, ofVec3f(0, 0, 0), ofVec3f(0, 0, 0), ofVec3f(0, 1, 0), 0.2)); /* "Sun" */
+	addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 100, ofVec3f(10, 0, 0), ofVec3f(0, 5, 0), ofVec3f(0.5, -0.5, 0.5), 0.1)); /* "Planet" */
+	addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", ofColor::green, 200, ofVec3f(0, 0, 8), ofVec3f(0, -5, 0), ofVec3f(-0.5, -0.5, 0.5), 0.12)); /* "Planet" */
+	addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", ofColor::blue, 150, ofVec3f(6, 0, 6), ofVec3f(0, -5, 0), ofVec3f(-0.5, -0.5, 0.5), 0.2)); /* "Planet" */
+	addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", ofColor::red, 100, ofVec3f(0, 0, -10), ofVec3f(4, 0, 0), ofVec3f(-0.5, -0.5, 0.5), 0.1)); /* "Planet" */
+	addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", ofColor::yellow, 300000, ofVec3f(0, 0, 0), ofVec3f(0, 0, 0), ofVec3f(0, 1, 0), 0.2)); /* "Sun" */
 }
 
 void Renderer::initModelsDemo() {
 	//Clear models and add demo models set
 	current_demo = MODELS;
 	clearScene();
-	scene_models.push_back(new Model3D("..\\models\\cow.obj", ofColor::white, ofVec3f(0, 0, -1), 0.2));
-	scene_models.push_back(new Model3D("..\\models\\teapot.obj", ofColor::lightBlue, ofVec3f(2, 0, 0), 0.4));
-	scene_models.push_back(new Model3D("..\\models\\cube.obj", ofColor::green, ofVec3f(-2, 0, 0), 1));
+	addModel(new Model3D("..\\models\\cow.obj", ofColor::white, ofVec3f(0, 0, -1), 0.2));
+	addModel(new Model3D("..\\models\\teapot.obj", ofColor::lightBlue, ofVec3f(2, 0, 0), 0.4));
+	addModel(new Model3D("..\\models\\cube.obj", ofColor::green, ofVec3f(-2, 0, 0), 1));
 
 }
 
@@ -211,12 +283,12 @@ void Renderer::initBoxDemo() {
 	int wall_offset = (box_size_slider+1) / 2;
 
 	//Add floor, walls, and ceiling
-	scene_models.push_back(new Plane(ofVec3f(0, -wall_offset, 0), ofVec3f(0, 1, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
-	scene_models.push_back(new Plane(ofVec3f(0, wall_offset, 0), ofVec3f(0, -1, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
-	scene_models.push_back(new Plane(ofVec3f(wall_offset, 0, 0), ofVec3f(-1, 0, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
-	scene_models.push_back(new Plane(ofVec3f(-wall_offset, 0, 0), ofVec3f(1, 0, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
-	scene_models.push_back(new Plane(ofVec3f(0, 0, wall_offset), ofVec3f(0, 0, -1), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
-	scene_models.push_back(new Plane(ofVec3f(0, 0, -wall_offset), ofVec3f(0, 0, 1), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
+	addPlane(new Plane(ofVec3f(0, -wall_offset, 0), ofVec3f(0, 1, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
+	addPlane(new Plane(ofVec3f(0, wall_offset, 0), ofVec3f(0, -1, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
+	addPlane(new Plane(ofVec3f(wall_offset, 0, 0), ofVec3f(-1, 0, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
+	addPlane(new Plane(ofVec3f(-wall_offset, 0, 0), ofVec3f(1, 0, 0), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
+	addPlane(new Plane(ofVec3f(0, 0, wall_offset), ofVec3f(0, 0, -1), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
+	addPlane(new Plane(ofVec3f(0, 0, -wall_offset), ofVec3f(0, 0, 1), ofColor::gray, 2*((box_size_slider+1)/2) + 1));
 
 
 	//Add random balls with random velocities
@@ -256,7 +328,7 @@ void Renderer::initBoxDemo() {
 		//Size of balls depends on size of box
 		float size = (0.05 + static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / (0.5)))) * box_size_slider / 20;
 
-		scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", new_ball_color, new_ball_mass, new_ball_position, new_ball_velocity, new_ball_angular_vel, size));
+		addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", new_ball_color, new_ball_mass, new_ball_position, new_ball_velocity, new_ball_angular_vel, size));
 	}
 
 }
@@ -264,14 +336,14 @@ void Renderer::initBoxDemo() {
 void Renderer::createNewPlanet() {
 	//Create a new planet if there aren't too many already
 	if (scene_models.size() < MAX_MODEL_COUNT) {
-		scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", (ofColor)new_planet_color, (float)new_planet_mass, (ofVec3f)new_planet_pos, (ofVec3f)new_planet_vel, ofVec3f(), (float)new_planet_size));
+		addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", (ofColor)new_planet_color, (float)new_planet_mass, (ofVec3f)new_planet_pos, (ofVec3f)new_planet_vel, ofVec3f(), (float)new_planet_size));
 	}
 }
 
 void Renderer::deletePlanets() {
 	//Clear the scene, then add the "sun" back
 	clearScene();
-	scene_models.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::yellow, 300000, ofVec3f(0, 0, 0), ofVec3f(0, 0, 0), ofVec3f(0, 1, 0), 0.2)); /* "Sun" */
+	addPhysicsBody(new PhysicsBody("..\\models\\sphere.obj", ofColor::yellow, 300000, ofVec3f(0, 0, 0), ofVec3f(0, 0, 0), ofVec3f(0, 1, 0), 0.2)); /* "Sun" */
 }
 
 void Renderer::createNewModel() {
@@ -280,7 +352,7 @@ void Renderer::createNewModel() {
 		//Based on instructions at https://openframeworks.cc/documentation/utils/ofSystemUtils/#show_ofSystemLoadDialog
 		ofFileDialogResult read_file = ofSystemLoadDialog("Choose File");
 		if (read_file.bSuccess) {
-			scene_models.push_back(new Model3D(read_file.getPath(), (ofColor)new_model_color, (ofVec3f)new_model_pos, (float)new_model_size));
+			addModel(new Model3D(read_file.getPath(), (ofColor)new_model_color, (ofVec3f)new_model_pos, (float)new_model_size));
 		}
 	}
 }
@@ -295,16 +367,27 @@ void Renderer::setup() {
 
 	//Seed random number generator
 	std::srand(static_cast <unsigned> (time(0)));
-	
-	//Initialize the webcam
-	webcam.setup(1024, 576);
 
-	//Initialize th camera
+	//Initialize th camera. draw() culls the scene before handing models to it, so it doesn't test them again
 	camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, win_width, win_height);
+	camera.frustum_culling = false;
+
+	//Initialize the CPU rasterizer and the depth buffer at the size of the window
+	software_rasterizer.resize(win_width, win_height);
+	depth_buffer.resize(win_width, win_height);
 
 	//Initialize the background
 	ofSetBackgroundColor(ofColor::black);
 
+	//Without a window there is no GUI, webcam or face tracking to set up
+	if (headless_options.enabled) {
+		setupHeadless();
+		return;
+	}
+
+	//Initialize the webcam
+	webcam.setup(1024, 576);
+
 	//Initialize the face tracker. Face tracking code based on examples provided with the ofxCv addon
 	face_finder.setup("haarcascade_frontalface_default.xml");
 	face_finder.setPreset(ofxCv::ObjectFinder::Fast);
@@ -320,6 +403,15 @@ void Renderer::setup() {
 	main_panel.add(osd_toggle.setup("Show OSD", false));
 	main_panel.add(floor_toggle.setup("Show floor", false));
 	main_panel.add(head_control_toggle.setup("Head Control", false));
+	main_panel.add(software_raster_toggle.setup("CPU Rasterizer", false));
+	main_panel.add(anti_aliasing_toggle.setup("Anti-aliasing", false));
+	main_panel.add(hidden_line_toggle.setup("Hidden Lines", false));
+	main_panel.add(outline_toggle.setup("Outlines Only", false));
+	main_panel.add(decimation_radius_slider.setup("LOD Radius (px)", 40, 0, 200));
+	main_panel.add(marker_radius_slider.setup("Marker Radius (px)", 2, 0, 20));
+	main_panel.add(min_edge_length_slider.setup("Min Edge (px)", 0.5f, 0, 4));
+	main_panel.add(physics_rate_slider.setup("Physics Rate (Hz)", 120, 30, 480));
+	main_panel.add(max_physics_steps_slider.setup("Max Physics Steps", 8, 1, 32));
 	main_panel.add(demos_label.setup("Demos", ""));
 	main_panel.add(models_demo_button.setup("Models"));
 	main_panel.add(planets_demo_button.setup("Planets"));
@@ -336,6 +428,9 @@ void Renderer::setup() {
 	new_planet_panel.add(new_planet_size.setup(0.1));
 	new_planet_panel.add(create_planet_button.setup("Create Planet"));
 	new_planet_panel.add(delete_planets_button.setup("Reset"));
+	new_planet_panel.add(barnes_hut_toggle.setup("Barnes-Hut Gravity", false));
+	new_planet_panel.add(opening_angle_slider.setup("Opening Angle", 0.5f, 0, 1.5f));
+	new_planet_panel.add(softening_slider.setup("Softening", 0, 0, 2));
 
 	//New Model Panel
 	new_model_panel.setup();
@@ -352,7 +447,7 @@ void Renderer::setup() {
 	box_panel.setName("Box Parameters");
 	box_panel.setPosition(win_width - box_panel.getWidth() - 5, 0);
 	box_panel.add(box_size_slider.setup("Box Size", 20, 5, 40));
-	box_panel.add(num_balls_slider.setup("Number of Balls", 20, 5, 40));
+	box_panel.add(num_balls_slider.setup("Number of Balls", 20, 5, MAX_MODEL_COUNT));
 	box_panel.add(box_run_button.setup("Rerun"));
 
 
@@ -372,8 +467,9 @@ void Renderer::setup() {
 //--------------------------------------------------------------
 void Renderer::update(){
 
-	//Get the last frame time in seconds. This will be used to maintain speeds regardless of framerate consistency
-	frame_time = ofGetLastFrameTime();
+	//Get the last frame time in seconds. This will be used to maintain speeds regardless of framerate consistency.
+	//Headless runs use a fixed frame time instead, so the same options always produce the same frames
+	frame_time = headless_options.enabled ? headless_options.frame_time : ofGetLastFrameTime();
 
 	//Update the camera position and rotation
 	updateCamera();
@@ -393,14 +489,110 @@ void Renderer::update(){
 
 //--------------------------------------------------------------
 void Renderer::draw() { 
-	//Draw the floor if enabled
-	if (floor_toggle) {
-		camera.drawModel(&floor);
+	//Start a new frame of lines. The batch keeps last frame's memory
+	line_batch.clear();
+
+	//Models small on screen draw fewer edges. Count what they leave out this frame
+	camera.decimation_radius = decimation_radius_slider;
+	camera.marker_radius = marker_radius_slider;
+	camera.min_edge_length = min_edge_length_slider;
+	camera.resetDrawCounters();
+
+	//Find the static models in view. In large scenes the hierarchy culls whole groups of models at once. Small scenes test every model,
+	//which is as fast and leaves the hierarchy alone until a grab needs it
+	visible_models.clear();
+	if (static_models.size() >= BVH_CULL_MIN_MODELS) {
+		updateSceneBVH();
+		scene_bvh.cullFrustum(camera, visible_models);
+	}
+	else {
+		for (uint32_t i = 0; i < static_models.size(); i++) {
+			if (camera.inFrustum(static_models[i]->position, static_models[i]->boundingRadius())) {
+				visible_models.push_back(i);
+			}
+		}
 	}
 
-	//Draw all scene models
-	for (Model3D* model : scene_models) {
-		camera.drawModel(model);
+	//Physics bodies sharing a mesh, like the balls of the planets and box demos, are drawn together as instances of it. Their poses are
+	//gathered in one pass over the physics world's bodies, and the ones in view kept
+	const Mesh* body_mesh = physics_world.bodyCount() > 0 ? physics_world.bodyModel(0)->mesh.get() : nullptr;
+	body_instances.clear();
+	other_bodies.clear();
+	physics_world.bodyInstances(body_mesh, body_instances, other_bodies);
+	size_t visible_count = 0;
+	for (const ModelInstance& instance : body_instances) {
+		if (camera.inFrustum(instance.position, body_mesh->bounding_radius * std::abs(instance.scale))) {
+			body_instances[visible_count++] = instance;
+		}
+	}
+	body_instances.resize(visible_count);
+
+	//Bodies with any other mesh are drawn one at a time
+	visible_count = 0;
+	for (uint32_t body : other_bodies) {
+		PhysicsBody* model = physics_world.bodyModel(body);
+		if (camera.inFrustum(model->position, model->boundingRadius())) {
+			other_bodies[visible_count++] = body;
+		}
+	}
+	other_bodies.resize(visible_count);
+	culled_model_count = scene_models.size() - visible_models.size() - body_instances.size() - other_bodies.size();
+
+	//The floor is culled the same way, and counted for the OSD as well
+	bool floor_visible = floor_toggle && camera.inFrustum(floor.position, floor.boundingRadius());
+	if (floor_toggle && !floor_visible) {
+		culled_model_count++;
+	}
+
+	//In hidden-line mode, draw the depth of every face first, so that each model's lines can be hidden by any model in front of it
+	DepthBuffer* line_depth_buffer = nullptr;
+	if (hidden_line_toggle) {
+		depth_buffer.clear();
+		if (floor_visible) {
+			camera.drawModelDepth(&floor, depth_buffer);
+		}
+		for (uint32_t index : visible_models) {
+			camera.drawModelDepth(static_models[index], depth_buffer);
+		}
+		if (body_mesh != nullptr) {
+			camera.drawInstancesDepth(*body_mesh, body_instances, depth_buffer);
+		}
+		for (uint32_t body : other_bodies) {
+			camera.drawModelDepth(physics_world.bodyModel(body), depth_buffer);
+		}
+		depth_buffer.updateTiles();
+		line_depth_buffer = &depth_buffer;
+	}
+
+	//Draw the floor if it's in view, then the scene models
+	camera.outline_only = outline_toggle;
+	if (floor_visible) {
+		camera.drawModel(&floor, line_batch, line_depth_buffer);
+	}
+	for (uint32_t index : visible_models) {
+		camera.drawModel(static_models[index], line_batch, line_depth_buffer);
+	}
+	if (body_mesh != nullptr) {
+		camera.drawInstances(*body_mesh, body_instances, line_batch, line_depth_buffer);
+	}
+	for (uint32_t body : other_bodies) {
+		camera.drawModel(physics_world.bodyModel(body), line_batch, line_depth_buffer);
+	}
+
+	//Headless runs draw into memory and save the frame instead
+	if (headless_options.enabled) {
+		drawHeadless();
+		return;
+	}
+
+	//Send every line of the scene to the GPU at once, or draw them on the CPU and show the result as one texture. Either way, underneath the GUI
+	if (software_raster_toggle) {
+		software_rasterizer.anti_aliasing = anti_aliasing_toggle;
+		software_rasterizer.rasterize(line_batch);
+		software_rasterizer.draw();
+	}
+	else {
+		line_batch.draw();
 	}
 
 	//Draw the GUI
@@ -415,7 +607,7 @@ void Renderer::draw() {
 		box_panel.draw();
 	}
 
-	// Draw the OSD - Display frame rate, frame time, camera position/rotation, field of view, and the local basis vectors
+	// Draw the OSD - Display frame rate, frame time, camera position/rotation, field of view, the local basis vectors, and how much of the scene was drawn
 	if (osd_toggle) {
 		ofSetColor(ofColor::white);
 		ofDrawBitmapString("fps: " + ofToString(ofGetFrameRate()) , ofVec2f(10, 10));
@@ -426,6 +618,14 @@ void Renderer::draw() {
 		ofDrawBitmapString("camera.local_basis: (" + ofToString(camera.local_basis[0].x) + ", " + ofToString(camera.local_basis[0].y) + ", " + ofToString(camera.local_basis[0].z)
 			+ "), (" + ofToString(camera.local_basis[1].x) + ", " + ofToString(camera.local_basis[1].y)	+ ", " + ofToString(camera.local_basis[1].z)
 			+ "), (" + ofToString(camera.local_basis[2].x) + ", " + ofToString(camera.local_basis[2].y) + ", " + ofToString(camera.local_basis[2].z) + ")", ofVec2f(10, 60));
+		ofDrawBitmapString("line segments: " + ofToString(line_batch.segmentCount()) + " (room for " + ofToString(line_batch.segmentCapacity()) + ")", ofVec2f(10, 70));
+		ofDrawBitmapString("models culled: " + ofToString(culled_model_count) + " of " + ofToString(scene_models.size() + (floor_toggle ? 1 : 0)), ofVec2f(10, 80));
+		ofDrawBitmapString("edges skipped: " + ofToString(camera.edges_decimated) + " on small models (" + ofToString(camera.marker_count) + " drawn as markers), "
+			+ ofToString(camera.edges_subpixel) + " sub-pixel", ofVec2f(10, 90));
+		ofDrawBitmapString("physics steps: " + ofToString(physics_step_count) + " at " + ofToString((int)physics_rate_slider) + " Hz", ofVec2f(10, 100));
+		if (hidden_line_toggle) {
+			ofDrawBitmapString("hidden edges rejected by tiles: " + ofToString(depth_buffer.edges_rejected) + " of " + ofToString(depth_buffer.edges_tested), ofVec2f(10, 110));
+		}
 	}
 
 }
@@ -474,10 +674,10 @@ void Renderer::keyPressed(int key){
 
 	// Keys that don't need to be held
 	if (key == '=') {
-		camera.field_of_view *= 1.1;
+		camera.zoom(1.0f);
 	}
 	if (key == '-') {
-		camera.field_of_view /= 1.1;
+		camera.zoom(-1.0f);
 	}
 	if (key == OF_KEY_ESC) {
 		exit();
@@ -547,15 +747,29 @@ void Renderer::mouseDragged(int x, int y, int button) {
 			//Entering edit-mode:	Find the object whose projected center is closest to the mouse
 			float min_mouse_dist = std::numeric_limits<float>::max();
 			float mouse_dist;
-			for (Model3D* model : scene_models) {
+
+			auto consider = [&](Model3D* model) {
 				// Compute the distance between the object's projected center and the mouse location, and
 				// point edit_mode_model to the current closest model
 				mouse_dist = (ofVec2f(x, y) - camera.transform(model->position)).length();
 				//Divide the grab range by the object's distance, since a smaller looking object should have a smaller grab range
-				if (mouse_dist < grab_range / (camera.position - model->position).length() && edit_mode_model_dist < min_mouse_dist) {
+				if (mouse_dist < grab_range / (camera.position - model->position).length() && mouse_dist < min_mouse_dist) {
 					edit_mode_model = model;
-					min_mouse_dist = edit_mode_model_dist;
+					min_mouse_dist = mouse_dist;
 				}
+			};
+
+			//A center in grab range is never further than grab_range / field_of_view from the ray through the mouse, so only those static models need checking
+			updateSceneBVH();
+			grab_candidates.clear();
+			scene_bvh.queryRay(camera.position, camera.screenRay(ofVec2f(x, y)), grab_range / camera.field_of_view, grab_candidates);
+			for (uint32_t index : grab_candidates) {
+				consider(static_models[index]);
+			}
+
+			//Bodies move every frame, so they aren't in the hierarchy. Every one is checked
+			for (size_t body = 0; body < physics_world.bodyCount(); body++) {
+				consider(physics_world.bodyModel(body));
 			}
 			//Now edit_mode_model points to whatever object, if any, is within grab range and whose projected center is closest to the mouse.
 			if (edit_mode_model != nullptr) {
@@ -578,6 +792,7 @@ void Renderer::mouseDragged(int x, int y, int button) {
 		ofVec2f mouse_difference = current_mouse_pos - last_mouse_pos;
 		ofVec3f position_change = (mouse_difference.x * camera.local_basis[1] + mouse_difference.y * camera.local_basis[2]) * edit_mode_model_dist * edit_translation_speed;
 		edit_mode_model->position += position_change;
+		scene_bvh_moved = true;
 		//If the model is a PhysicsBody, give it the velocity determined by the mouse
 		if (PhysicsBody* body = dynamic_cast<PhysicsBody*>(edit_mode_model)) {
 			//...But only control the body's velocity with the mouse if it's large enough, otherwise set it to zero
@@ -588,6 +803,7 @@ void Renderer::mouseDragged(int x, int y, int button) {
 				body->velocity = ofVec3f(0, 0, 0);
 			}
 		}
+		physics_world.syncFromModel(edit_mode_model);
 		last_mouse_pos = current_mouse_pos;
 	
 	}
@@ -599,10 +815,12 @@ void Renderer::mouseDragged(int x, int y, int button) {
 		//Use multiples of the rightward and upward local basis vectors to rotate the selected object
 		ofVec3f rotation_vector = (mouse_difference.x * camera.local_basis[2] - mouse_difference.y * camera.local_basis[1]) * edit_rotation_speed;
 		edit_mode_model->rotate(rotation_vector);
+		scene_bvh_moved = true;
 		//If the model is a PhysicsBody, give it the angular velocity of the mouse
 		if (PhysicsBody* body = dynamic_cast<PhysicsBody*>(edit_mode_model)) {
 			body->angular_vel = rotation_vector / frame_time;
 		}
+		physics_world.syncFromModel(edit_mode_model);
 		last_mouse_pos = current_mouse_pos;
 	}
 }
@@ -631,6 +849,8 @@ void Renderer::mouseScrolled(ofMouseEventArgs& mouse) {
 	// If currently in edit mode and right click is held, use the local basis to move the selected model towards or away from the camera
 	if (edit_mode && mouse.button == 2) {
 		edit_mode_model->position += mouse.scrollY * camera.local_basis[0] * edit_mode_model_dist* edit_translation_speed * 10;
+		scene_bvh_moved = true;
+		physics_world.syncFromModel(edit_mode_model);
 	}
 	// Otherwise, change the FOV
 	else {
@@ -10,6 +10,11 @@
 #include "physics_body.h"	/* Also includes model3d.h */
 #include "plane.h"
 #include "camera.h"
+#include "scene_bvh.h"
+#include "physics_world.h"
+#include "fixed_timestep.h"
+#include "software_rasterizer.h"
+#include "headless_options.h"
 
 #include <vector>
 #include <sstream>
@@ -29,6 +34,15 @@ private:
 	ofxToggle osd_toggle;
 	ofxToggle floor_toggle;
 	ofxToggle head_control_toggle;
+	ofxToggle software_raster_toggle;
+	ofxToggle anti_aliasing_toggle;
+	ofxToggle hidden_line_toggle;
+	ofxToggle outline_toggle;
+	ofxFloatSlider decimation_radius_slider;
+	ofxFloatSlider marker_radius_slider;
+	ofxFloatSlider min_edge_length_slider;
+	ofxIntSlider physics_rate_slider;
+	ofxIntSlider max_physics_steps_slider;
 	ofxLabel demos_label;
 	ofxButton planets_demo_button;
 	ofxButton models_demo_button;
@@ -43,6 +57,9 @@ private:
 	ofxFloatSlider new_planet_size;
 	ofxButton create_planet_button;
 	ofxButton delete_planets_button;
+	ofxToggle barnes_hut_toggle;
+	ofxFloatSlider opening_angle_slider;
+	ofxFloatSlider softening_slider;
 
 	//New model panel - Provides interface for creating and removing models in the MODELS demo
 	ofxPanel new_model_panel;
@@ -69,12 +86,29 @@ private:
 	ofxCv::ObjectFinder face_finder;			/* ObjectFinder used to find and track faces */
 	ofRectangle face_rect = ofRectangle(-10, -10, 0, 0);	/* The current record of the rectangle surrounding the user's face */
 
+	// Headless parameters
+	HeadlessOptions headless_options;			/* Command line settings. When headless_options.enabled, there is no window, GUI, webcam or GL context */
+	int headless_frame = 0;					/* Number of frames drawn so far in headless mode */
+
 	// Application parameters
 	float frame_time = 0;					/* frametime in seconds, updated with every call of the update() method */
 	bool edit_mode = false;					/* indicates whether the user is currently manipulating objects in the scene */
 	std::vector<Model3D*> scene_models;			/* Collection of all models in the scene */
-	const int MAX_MODEL_COUNT = 10;				/* The maximum number of models allowed in the scene */
+	std::vector<Model3D*> static_models;			/* The scene models that aren't physics bodies. Bodies move every frame, so they are culled and drawn straight from physics_world */
+	const int MAX_MODEL_COUNT = 10000;			/* The maximum number of models allowed in the scene */
+	SceneBVH scene_bvh;					/* Bounding volume hierarchy over static_models, for culling and grabbing models */
+	bool scene_bvh_dirty = true;				/* Whether models were added or removed since scene_bvh was last built */
+	bool scene_bvh_moved = true;				/* Whether static models have moved since scene_bvh was last refit */
+	const size_t BVH_CULL_MIN_MODELS = 256;			/* Scenes with fewer models than this are culled by testing every model, which measured as fast as the hierarchy */
+	std::vector<uint32_t> visible_models;			/* Indices of the static models in view this frame. Reused every frame */
+	std::vector<ModelInstance> body_instances;		/* Poses of the physics bodies in view this frame that share the first body's mesh. Reused every frame */
+	std::vector<uint32_t> other_bodies;			/* Indices of the physics bodies with any other mesh, and then of those in view this frame. Reused every frame */
+	std::vector<uint32_t> grab_candidates;			/* Indices of the static models near the mouse when entering edit mode */
+	PhysicsWorld physics_world;				/* The physics state of the scene's bodies and planes, which updatePhysics steps */
+	FixedTimestep physics_timestep;				/* Splits each frame's time into steps of the same length for physics_world */
+	int physics_step_count = 0;				/* Number of physics steps run in the last frame */
 	DemoMode current_demo = NONE;				/* The current demo mode */
+	int culled_model_count = 0;				/* Number of models (including the floor) skipped by frustum culling in the last frame */
 
 	// Edit Mode parameters
 	Model3D* edit_mode_model = nullptr;			/* the current model being manipulated in edit-mode */
@@ -97,6 +131,9 @@ private:
 	int win_width;					/* width of the screen */
 	int win_height;					/* height of the screen */
 	Camera camera;					/* Camera object used to view the scene and draw to the screen */
+	LineBatch line_batch;				/* Every line of the scene for the current frame, drawn in one call. Reused every frame */
+	SoftwareRasterizer software_rasterizer;		/* Draws line_batch on the CPU instead of the GPU when "CPU Rasterizer" is enabled */
+	DepthBuffer depth_buffer;			/* Depth of the nearest face at each pixel, for hiding lines when "Hidden Lines" is enabled */
 	ofVec2f last_mouse_pos = ofVec2f(-1, -1);	/* last recorded screen coordinates of the mouse */
 
 
@@ -112,6 +149,9 @@ public:
 	/* Renderer Constructor */
 	Renderer(int width, int height);
 
+	/* Renderer Constructor for running without a window, at the resolution given in the options */
+	Renderer(const HeadlessOptions& options);
+
 	/* Updates the camera position and rotation based on user controls */
 	void updateCamera();
 
@@ -121,9 +161,27 @@ public:
 	/* Clears the scene_models vector and deletes all objects in it */
 	void clearScene();
 
+	/* Adds a model that isn't part of the physics simulation to the scene */
+	void addModel(Model3D* model);
+
+	/* Adds a PhysicsBody to the scene and to physics_world */
+	void addPhysicsBody(PhysicsBody* body);
+
+	/* Adds a Plane to the scene and to physics_world as something for bodies to bounce off */
+	void addPlane(Plane* plane);
+
+	/* Rebuilds scene_bvh if models were added or removed, otherwise refits it if models have moved since the last refit */
+	void updateSceneBVH();
+
 	/* Updates the position of the camera for head control */
 	void updateHead();
 
+	/* Sets up the scene and the settings normally controlled by the GUI for a headless run */
+	void setupHeadless();
+
+	/* Draws the current frame on the CPU, saves it if it is due, and exits after the last frame */
+	void drawHeadless();
+
 	//////////////////// GUI BUTTON PRESSES \\\\\\\\\\\\\\\\\
 
 	// Demo initializers
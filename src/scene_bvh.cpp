@@ -0,0 +1,195 @@
+#include "scene_bvh.h"
+
+void SceneBVH::build(const std::vector<Model3D*>& scene_models) {
+	models = scene_models;
+	items.resize(models.size());
+	centers.resize(models.size());
+	for (uint32_t i = 0; i < models.size(); i++) {
+		items[i] = i;
+		centers[i] = models[i]->position;
+	}
+
+	//A binary tree with at least one model per leaf has fewer than twice as many nodes as models
+	nodes.clear();
+	nodes.reserve(std::max<size_t>(1, 2 * models.size()));
+	nodes.push_back(Node());
+	buildNode(0, 0, models.size());
+}
+
+void SceneBVH::buildNode(uint32_t node_index, uint32_t first, uint32_t count) {
+	nodes[node_index].first = first;
+	nodes[node_index].count = count;
+
+	//Small enough to be a leaf
+	if (count <= LEAF_SIZE) {
+		fitLeaf(nodes[node_index]);
+		return;
+	}
+
+	//Split along the axis the model centers are most spread out on
+	ofVec3f min_center = centers[items[first]];
+	ofVec3f max_center = min_center;
+	for (uint32_t i = first; i < first + count; i++) {
+		const ofVec3f& center = centers[items[i]];
+		min_center = ofVec3f(std::min(min_center.x, center.x), std::min(min_center.y, center.y), std::min(min_center.z, center.z));
+		max_center = ofVec3f(std::max(max_center.x, center.x), std::max(max_center.y, center.y), std::max(max_center.z, center.z));
+	}
+	ofVec3f extent = max_center - min_center;
+	int axis = 0;
+	if (extent.y > extent.x) {
+		axis = 1;
+	}
+	if (extent.z > extent[axis]) {
+		axis = 2;
+	}
+
+	//Put the half of the models with the smaller centers on the left. Ties are broken by index, so the tree is the same on every platform
+	uint32_t half = count / 2;
+	std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count, [&](uint32_t a, uint32_t b) {
+		if (centers[a][axis] != centers[b][axis]) {
+			return centers[a][axis] < centers[b][axis];
+		}
+		return a < b;
+	});
+
+	//Children go next to each other at the end, so building them can't move this node
+	uint32_t left = nodes.size();
+	nodes.push_back(Node());
+	nodes.push_back(Node());
+	nodes[node_index].left = left;
+	buildNode(left, first, half);
+	buildNode(left + 1, first + half, count - half);
+	fitParent(nodes[node_index]);
+}
+
+void SceneBVH::fitLeaf(Node& node) const {
+	//An empty leaf (only possible for an empty scene) gets an inside-out box that nothing can hit
+	float largest = std::numeric_limits<float>::max();
+	node.min_corner = ofVec3f(largest, largest, largest);
+	node.max_corner = ofVec3f(-largest, -largest, -largest);
+	for (uint32_t i = node.first; i < node.first + node.count; i++) {
+		const Model3D* model = models[items[i]];
+		float radius = model->boundingRadius();
+		node.min_corner = ofVec3f(std::min(node.min_corner.x, model->position.x - radius), std::min(node.min_corner.y, model->position.y - radius), std::min(node.min_corner.z, model->position.z - radius));
+		node.max_corner = ofVec3f(std::max(node.max_corner.x, model->position.x + radius), std::max(node.max_corner.y, model->position.y + radius), std::max(node.max_corner.z, model->position.z + radius));
+	}
+}
+
+void SceneBVH::fitParent(Node& node) const {
+	const Node& left = nodes[node.left];
+	const Node& right = nodes[node.left + 1];
+	node.min_corner = ofVec3f(std::min(left.min_corner.x, right.min_corner.x), std::min(left.min_corner.y, right.min_corner.y), std::min(left.min_corner.z, right.min_corner.z));
+	node.max_corner = ofVec3f(std::max(left.max_corner.x, right.max_corner.x), std::max(left.max_corner.y, right.max_corner.y), std::max(left.max_corner.z, right.max_corner.z));
+}
+
+void SceneBVH::refit() {
+	//Children come after their parents, so going backwards fits every child before its parent
+	for (size_t i = nodes.size(); i-- > 0;) {
+		Node& node = nodes[i];
+		if (node.left == 0) {
+			fitLeaf(node);
+		}
+		else {
+			fitParent(node);
+		}
+	}
+}
+
+void SceneBVH::cullFrustum(const Camera& camera, std::vector<uint32_t>& visible) const {
+	if (models.empty()) {
+		return;
+	}
+	size_t first_result = visible.size();
+
+	//Walk the tree with a stack instead of recursion
+	uint32_t stack[MAX_STACK];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+	while (stack_size > 0) {
+		const Node& node = nodes[stack[--stack_size]];
+
+		//Test the sphere around the node's box, which is as conservative as the model spheres themselves
+		ofVec3f center = (node.min_corner + node.max_corner) * 0.5f;
+		Camera::FrustumOverlap overlap = camera.frustumOverlap(center, (node.max_corner - center).length());
+		if (overlap == Camera::OUTSIDE) {
+			continue;
+		}
+
+		//Everything below a node entirely in view is visible, with no more tests
+		if (overlap == Camera::INSIDE) {
+			visible.insert(visible.end(), items.begin() + node.first, items.begin() + node.first + node.count);
+			continue;
+		}
+		if (node.left != 0) {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.left + 1;
+			continue;
+		}
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			const Model3D* model = models[items[i]];
+			if (camera.inFrustum(model->position, model->boundingRadius())) {
+				visible.push_back(items[i]);
+			}
+		}
+	}
+
+	//Later models are drawn over earlier ones, so keep the scene's order
+	std::sort(visible.begin() + first_result, visible.end());
+}
+
+void SceneBVH::queryRay(ofVec3f origin, ofVec3f direction, float radius, std::vector<uint32_t>& hits) const {
+	if (models.empty()) {
+		return;
+	}
+	size_t first_result = hits.size();
+
+	uint32_t stack[MAX_STACK];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+	while (stack_size > 0) {
+		const Node& node = nodes[stack[--stack_size]];
+
+		//Slab test against the box grown by the radius. The ray only counts in front of the origin
+		float t_near = 0;
+		float t_far = std::numeric_limits<float>::max();
+		bool missed = false;
+		for (int axis = 0; axis < 3 && !missed; axis++) {
+			float low = node.min_corner[axis] - radius - origin[axis];
+			float high = node.max_corner[axis] + radius - origin[axis];
+			if (direction[axis] == 0) {
+				missed = low > 0 || high < 0;
+				continue;
+			}
+			float t0 = low / direction[axis];
+			float t1 = high / direction[axis];
+			t_near = std::max(t_near, std::min(t0, t1));
+			t_far = std::min(t_far, std::max(t0, t1));
+			missed = t_near > t_far;
+		}
+		if (missed) {
+			continue;
+		}
+
+		if (node.left != 0) {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.left + 1;
+			continue;
+		}
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			ofVec3f offset = models[items[i]]->position - origin;
+			float t = offset.dot(direction);
+			if (t >= 0 && (offset - direction * t).lengthSquared() <= radius * radius) {
+				hits.push_back(items[i]);
+			}
+		}
+	}
+	std::sort(hits.begin() + first_result, hits.end());
+}
+
+size_t SceneBVH::modelCount() const {
+	return models.size();
+}
+
+size_t SceneBVH::nodeCount() const {
+	return nodes.size();
+}
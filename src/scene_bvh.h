@@ -0,0 +1,61 @@
+// SCENE BVH - Defines the SceneBVH class - a bounding volume hierarchy over the models of a scene, for culling and picking without visiting every model
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "ofMain.h"
+#include "camera.h"
+
+class SceneBVH {
+
+private:
+	/* A box around every model below it. Every node's models are next to each other in items */
+	struct Node {
+		ofVec3f min_corner;		/* Lowest x, y and z of any model bound below this node */
+		ofVec3f max_corner;		/* Highest x, y and z of any model bound below this node */
+		uint32_t first = 0;		/* Index into items of the first model below this node */
+		uint32_t count = 0;		/* Number of models below this node */
+		uint32_t left = 0;		/* Index of the left child. The right child follows it. 0 for leaves, since the root is never a child */
+	};
+
+	static const uint32_t LEAF_SIZE = 4;	/* Most models a leaf holds before it is split */
+	static const int MAX_STACK = 128;	/* Room for the nodes waiting to be visited. Splitting at the median keeps the depth near log2 of the model count */
+
+	std::vector<Model3D*> models;		/* The models the hierarchy was built over, in scene order */
+	std::vector<uint32_t> items;		/* Indices into models, ordered so every leaf's models are next to each other */
+	std::vector<Node> nodes;		/* Every node, root first. Children always come after their parent */
+	std::vector<ofVec3f> centers;		/* Scratch space for build(), the center of each model's bounds */
+
+	/* Builds the subtree for items[first, first + count) into nodes[node_index], splitting at the median of the longest axis */
+	void buildNode(uint32_t node_index, uint32_t first, uint32_t count);
+
+	/* Sets a leaf's box to fit the bounding spheres of its models */
+	void fitLeaf(Node& node) const;
+
+	/* Sets a node's box to fit the boxes of its two children */
+	void fitParent(Node& node) const;
+
+public:
+
+	/* Throws away the old hierarchy and builds a new one over the given models. Call this whenever models are added or removed */
+	void build(const std::vector<Model3D*>& scene_models);
+
+	/* Updates every box for models that have moved, without changing the structure. Cheap enough to call every frame */
+	void refit();
+
+	/* Appends the index of every model whose bounding sphere is at least partly in the camera's view, in scene order */
+	void cullFrustum(const Camera& camera, std::vector<uint32_t>& visible) const;
+
+	/* Appends the index of every model whose position is in front of origin and within radius of the ray along direction, in scene order.
+	   direction must be normalized */
+	void queryRay(ofVec3f origin, ofVec3f direction, float radius, std::vector<uint32_t>& hits) const;
+
+	/* Returns the number of models the hierarchy was built over */
+	size_t modelCount() const;
+
+	/* Returns the number of nodes in the hierarchy */
+	size_t nodeCount() const;
+};
@@ -0,0 +1,19 @@
+// SIMD TARGET - Defines SIMD_TARGET_X64 and AVX2_FUNCTION, for the kernels that pick between scalar, SSE and AVX2 code at run time
+
+#pragma once
+
+//Only x86-64 builds have the SSE and AVX2 paths
+#if defined(_M_X64) || defined(__x86_64__)
+#define SIMD_TARGET_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+//GCC and Clang only emit AVX2 instructions inside functions marked for it. MSVC allows them anywhere
+#if defined(__GNUC__)
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#else
+#define AVX2_FUNCTION
+#endif
@@ -0,0 +1,247 @@
+#include "software_rasterizer.h"
+
+#include <cmath>
+
+SoftwareRasterizer::SoftwareRasterizer() {
+	//Default constructor leaves an empty framebuffer. Call resize() before rasterizing
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width_, int height_, int tile_size_) {
+	tile_size = std::max(1, tile_size_);
+	resize(width_, height_);
+}
+
+void SoftwareRasterizer::resize(int width_, int height_) {
+	width = std::max(0, width_);
+	height = std::max(0, height_);
+	tiles_x = (width + tile_size - 1) / tile_size;
+	tiles_y = (height + tile_size - 1) / tile_size;
+	framebuffer.assign((size_t)width * height * 4, 0);
+	tile_bins.assign((size_t)tiles_x * tiles_y, std::vector<uint32_t>());
+}
+
+void SoftwareRasterizer::rasterize(const LineBatch& lines) {
+	binSegments(lines);
+
+	//Tiles don't share any pixels, so threads can take them in any order without locking. Each thread takes the next tile nobody has started
+	int tile_count = tiles_x * tiles_y;
+	std::atomic<int> next_tile(0);
+	std::function<void()> rasterizeTiles = [&]() {
+		for (int tile = next_tile++; tile < tile_count; tile = next_tile++) {
+			rasterizeTile(tile, lines);
+		}
+	};
+
+	//Run on the threads the whole program shares, since starting new ones every frame would cost more than small frames take to draw
+	WorkerPool::shared().run(std::min(thread_count, (unsigned)std::max(1, tile_count)), rasterizeTiles);
+}
+
+void SoftwareRasterizer::binSegments(const LineBatch& lines) {
+	//clear() keeps each bin's memory from the last frame
+	for (std::vector<uint32_t>& bin : tile_bins) {
+		bin.clear();
+	}
+
+	const std::vector<ofVec2f>& points = lines.getPoints();
+	for (size_t segment = 0; segment < lines.segmentCount(); segment++) {
+		ofVec2f point0 = points[segment * 2];
+		ofVec2f point1 = points[segment * 2 + 1];
+
+		//Pixels the segment could touch, with a pixel of room on each side for anti-aliasing. Skip segments entirely off the screen
+		float left = std::min(point0.x, point1.x) - 1;
+		float right = std::max(point0.x, point1.x) + 1;
+		float top = std::min(point0.y, point1.y) - 1;
+		float bottom = std::max(point0.y, point1.y) + 1;
+		if (!(right >= 0 && left < width && bottom >= 0 && top < height)) {
+			continue;
+		}
+		int first_tile_x = (int)std::max(left, 0.0f) / tile_size;
+		int last_tile_x = (int)std::min(right, width - 1.0f) / tile_size;
+		int first_tile_y = (int)std::max(top, 0.0f) / tile_size;
+		int last_tile_y = (int)std::min(bottom, height - 1.0f) / tile_size;
+
+		//A long diagonal segment's bounding box covers many tiles it never passes through. Only bin the tiles whose corners
+		//(again with a pixel of room) aren't all on the same side of the line
+		float dx = point1.x - point0.x;
+		float dy = point1.y - point0.y;
+		for (int tile_y = first_tile_y; tile_y <= last_tile_y; tile_y++) {
+			for (int tile_x = first_tile_x; tile_x <= last_tile_x; tile_x++) {
+				float corners_x[2] = { tile_x * tile_size - 1.0f, (tile_x + 1) * tile_size + 1.0f };
+				float corners_y[2] = { tile_y * tile_size - 1.0f, (tile_y + 1) * tile_size + 1.0f };
+				bool any_above = false;
+				bool any_below = false;
+				for (float corner_x : corners_x) {
+					for (float corner_y : corners_y) {
+						float side = dx * (corner_y - point0.y) - dy * (corner_x - point0.x);
+						any_above = any_above || side >= 0;
+						any_below = any_below || side <= 0;
+					}
+				}
+				if (any_above && any_below) {
+					tile_bins[tile_y * tiles_x + tile_x].push_back((uint32_t)segment);
+				}
+			}
+		}
+	}
+}
+
+void SoftwareRasterizer::rasterizeTile(int tile, const LineBatch& lines) {
+	int min_x = (tile % tiles_x) * tile_size;
+	int min_y = (tile / tiles_x) * tile_size;
+	int max_x = std::min(min_x + tile_size, width);
+	int max_y = std::min(min_y + tile_size, height);
+
+	//Clear the tile
+	for (int y = min_y; y < max_y; y++) {
+		for (int x = min_x; x < max_x; x++) {
+			uint8_t* pixel = &framebuffer[((size_t)y * width + x) * 4];
+			pixel[0] = background_color.r;
+			pixel[1] = background_color.g;
+			pixel[2] = background_color.b;
+			pixel[3] = 255;
+		}
+	}
+
+	//Draw the segments in batch order, so they overlap the same way they would on the GPU
+	const std::vector<ofVec2f>& points = lines.getPoints();
+	const std::vector<ofFloatColor>& colors = lines.getColors();
+	for (uint32_t segment : tile_bins[tile]) {
+		drawSegment(points[segment * 2], points[segment * 2 + 1], colors[segment * 2], min_x, min_y, max_x, max_y);
+	}
+}
+
+void SoftwareRasterizer::drawSegment(ofVec2f point0, ofVec2f point1, const ofColor& color, int min_x, int min_y, int max_x, int max_y) {
+	//Step one pixel at a time along the major axis (the one the segment is longer in), and work out the position on the minor axis at each step.
+	//"a" is the major axis and "b" the minor one
+	bool x_major = std::abs(point1.x - point0.x) >= std::abs(point1.y - point0.y);
+	float a0 = x_major ? point0.x : point0.y;
+	float b0 = x_major ? point0.y : point0.x;
+	float a1 = x_major ? point1.x : point1.y;
+	float b1 = x_major ? point1.y : point1.x;
+	int min_a = x_major ? min_x : min_y;
+	int max_a = x_major ? max_x : max_y;
+	int min_b = x_major ? min_y : min_x;
+	int max_b = x_major ? max_y : max_x;
+	if (a0 > a1) {
+		std::swap(a0, a1);
+		std::swap(b0, b1);
+	}
+	if (a1 == a0) {
+		//Zero length segments draw nothing
+		return;
+	}
+	float slope = (b1 - b0) / (a1 - a0);
+
+	//Pixels whose centers lie on the segment, limited to the tile. Clamping as floats keeps huge coordinates from overflowing an int
+	int first = (int)std::max(std::ceil(a0 - 0.5f), (float)min_a);
+	int last = (int)std::min(std::floor(a1 - 0.5f), max_a - 1.0f);
+
+	//Each pixel's position only depends on the segment, never on the tile, so segments crossing tile borders join up exactly
+	for (int a = first; a <= last; a++) {
+		float b = b0 + (a + 0.5f - a0) * slope;
+
+		if (anti_aliasing) {
+			//Split the pixel between the two rows (or columns) the line passes between, weighted by how close it is to each
+			float b_center = b - 0.5f;
+			if (b_center < min_b - 1 || b_center >= max_b) {
+				continue;
+			}
+			int b_pixel = (int)std::floor(b_center);
+			float weight = b_center - b_pixel;
+			if (b_pixel >= min_b) {
+				blendPixel(x_major ? a : b_pixel, x_major ? b_pixel : a, color, 1 - weight);
+			}
+			if (b_pixel + 1 < max_b) {
+				blendPixel(x_major ? a : b_pixel + 1, x_major ? b_pixel + 1 : a, color, weight);
+			}
+		}
+		else {
+			//Fill the one pixel the line passes through
+			if (b < min_b || b >= max_b) {
+				continue;
+			}
+			int b_pixel = (int)std::floor(b);
+			blendPixel(x_major ? a : b_pixel, x_major ? b_pixel : a, color, 1);
+		}
+	}
+}
+
+void SoftwareRasterizer::blendPixel(int x, int y, const ofColor& color, float coverage) {
+	uint8_t* pixel = &framebuffer[((size_t)y * width + x) * 4];
+	if (coverage >= 1) {
+		pixel[0] = color.r;
+		pixel[1] = color.g;
+		pixel[2] = color.b;
+		return;
+	}
+
+	//Move each channel part of the way from its current value to the line's color
+	pixel[0] = (uint8_t)(pixel[0] + (color.r - pixel[0]) * coverage + 0.5f);
+	pixel[1] = (uint8_t)(pixel[1] + (color.g - pixel[1]) * coverage + 0.5f);
+	pixel[2] = (uint8_t)(pixel[2] + (color.b - pixel[2]) * coverage + 0.5f);
+}
+
+const std::vector<uint8_t>& SoftwareRasterizer::getFramebuffer() const {
+	return framebuffer;
+}
+
+ofColor SoftwareRasterizer::getPixel(int x, int y) const {
+	const uint8_t* pixel = &framebuffer[((size_t)y * width + x) * 4];
+	return ofColor(pixel[0], pixel[1], pixel[2], pixel[3]);
+}
+
+int SoftwareRasterizer::getWidth() const {
+	return width;
+}
+
+int SoftwareRasterizer::getHeight() const {
+	return height;
+}
+
+void SoftwareRasterizer::draw() {
+	if (width == 0 || height == 0) {
+		return;
+	}
+
+	//Reallocate the texture only when the size changes
+	if (!texture.isAllocated() || texture.getWidth() != width || texture.getHeight() != height) {
+		texture.allocate(width, height, GL_RGBA);
+	}
+	texture.loadData(framebuffer.data(), width, height, GL_RGBA);
+
+	//The texture is tinted by the current color, so reset it to white
+	ofSetColor(ofColor::white);
+	texture.draw(0, 0);
+}
+
+bool SoftwareRasterizer::save(const std::string& file_path) const {
+	//PPM is simple enough to write directly
+	if (file_path.size() >= 4 && file_path.compare(file_path.size() - 4, 4, ".ppm") == 0) {
+		return savePPM(file_path);
+	}
+
+	ofPixels pixels;
+	pixels.setFromPixels(framebuffer.data(), width, height, OF_IMAGE_COLOR_ALPHA);
+	return ofSaveImage(pixels, file_path);
+}
+
+bool SoftwareRasterizer::savePPM(const std::string& file_path) const {
+	std::ofstream file(file_path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	//Header, then three bytes per pixel row by row from the top left
+	file << "P6\n" << width << " " << height << "\n255\n";
+	std::vector<char> row((size_t)width * 3);
+	for (int y = 0; y < height; y++) {
+		const uint8_t* pixel = &framebuffer[(size_t)y * width * 4];
+		for (int x = 0; x < width; x++) {
+			row[x * 3] = pixel[x * 4];
+			row[x * 3 + 1] = pixel[x * 4 + 1];
+			row[x * 3 + 2] = pixel[x * 4 + 2];
+		}
+		file.write(row.data(), row.size());
+	}
+	return (bool)file;
+}
@@ -0,0 +1,74 @@
+// SOFTWARE RASTERIZER - Defines the SoftwareRasterizer class - for drawing a frame's lines into an RGBA image on the CPU, split into tiles across threads
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ofMain.h"
+#include "line_batch.h"
+#include "worker_pool.h"
+
+class SoftwareRasterizer {
+
+private:
+	int width = 0;				/* Width of the framebuffer in pixels */
+	int height = 0;				/* Height of the framebuffer in pixels */
+	int tile_size = 64;			/* Width and height of a tile in pixels */
+	int tiles_x = 0;			/* Number of tile columns */
+	int tiles_y = 0;			/* Number of tile rows */
+	std::vector<uint8_t> framebuffer;	/* Four bytes (red, green, blue, alpha) per pixel, row by row from the top left */
+	std::vector<std::vector<uint32_t>> tile_bins;	/* Indices of the segments touching each tile, in the order they were added to the batch */
+	ofTexture texture;			/* Texture the framebuffer is uploaded to by draw() */
+
+	/* Sorts the segments of a batch into the bins of every tile they pass through */
+	void binSegments(const LineBatch& lines);
+
+	/* Clears one tile to the background color and draws every segment in its bin, only touching pixels inside the tile */
+	void rasterizeTile(int tile, const LineBatch& lines);
+
+	/* Draws the part of a segment that lies between min_x/min_y (inclusive) and max_x/max_y (exclusive) */
+	void drawSegment(ofVec2f point0, ofVec2f point1, const ofColor& color, int min_x, int min_y, int max_x, int max_y);
+
+	/* Blends a color into a pixel. A coverage of 1 replaces the pixel */
+	void blendPixel(int x, int y, const ofColor& color, float coverage);
+
+public:
+	ofColor background_color = ofColor::black;	/* Color every pixel is cleared to before drawing */
+	bool anti_aliasing = false;			/* Whether lines are drawn with smooth, partially covered edges instead of hard pixel steps */
+	unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());	/* Number of threads the tiles are split across */
+
+	//Default SoftwareRasterizer constructor
+	SoftwareRasterizer();
+
+	//SoftwareRasterizer constructor
+	SoftwareRasterizer(int width_, int height_, int tile_size_ = 64);
+
+	/* Changes the size of the framebuffer. Its contents are lost */
+	void resize(int width_, int height_);
+
+	/* Clears the framebuffer and draws every segment of a batch into it, in order, so later segments cover earlier ones */
+	void rasterize(const LineBatch& lines);
+
+	/* Returns the framebuffer, four bytes per pixel */
+	const std::vector<uint8_t>& getFramebuffer() const;
+
+	/* Returns the color of one pixel of the framebuffer */
+	ofColor getPixel(int x, int y) const;
+
+	int getWidth() const;
+	int getHeight() const;
+
+	/* Uploads the framebuffer to a texture and draws it over the whole window */
+	void draw();
+
+	/* Saves the framebuffer as an image file. The format is chosen by the file extension. Returns false if the file couldn't be written */
+	bool save(const std::string& file_path) const;
+
+	/* Saves the framebuffer as a binary PPM file, without alpha. Needs no image library. Returns false if the file couldn't be written */
+	bool savePPM(const std::string& file_path) const;
+};
@@ -0,0 +1,100 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+//Whether this thread is running a job right now, so a job that starts another one runs it inline instead of locking run_mutex again
+static thread_local bool running_job_here = false;
+
+/* Marks the current thread as running a job until it goes out of scope, even if the job throws */
+struct RunningJobScope {
+	RunningJobScope() { running_job_here = true; }
+	~RunningJobScope() { running_job_here = false; }
+};
+
+WorkerPool::WorkerPool(unsigned worker_count) {
+	for (unsigned i = 0; i < worker_count; i++) {
+		workers.push_back(std::thread(&WorkerPool::workerLoop, this));
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	job_ready.notify_all();
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+void WorkerPool::workerLoop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	uint64_t last_job = 0;
+	while (true) {
+		job_ready.wait(lock, [&]() { return stopping || (job_number != last_job && job_threads > 0); });
+		if (stopping) {
+			return;
+		}
+
+		//Join the job, and run it without holding the lock
+		last_job = job_number;
+		job_threads--;
+		busy_threads++;
+		const std::function<void()>* current_job = running_job;
+		lock.unlock();
+		{
+			RunningJobScope scope;
+			(*current_job)();
+		}
+		lock.lock();
+
+		busy_threads--;
+		if (busy_threads == 0) {
+			job_done.notify_all();
+		}
+	}
+}
+
+void WorkerPool::run(unsigned thread_count, const std::function<void()>& job) {
+	//A job started from inside a job runs inline. This thread may already hold run_mutex, which can't be locked twice
+	if (running_job_here) {
+		job();
+		return;
+	}
+	RunningJobScope scope;
+
+	//Run alone when there are no workers to help, or when they are busy with another thread's job
+	std::unique_lock<std::mutex> run_lock(run_mutex, std::try_to_lock);
+	unsigned helpers = std::min(thread_count > 0 ? thread_count - 1 : 0, (unsigned)workers.size());
+	if (!run_lock.owns_lock() || helpers == 0) {
+		job();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running_job = &job;
+		job_number++;
+		job_threads = helpers;
+	}
+	job_ready.notify_all();
+
+	//The calling thread works too, rather than waiting
+	job();
+
+	//Workers that haven't woken up yet would find nothing left to do, so stop them joining, then wait for the ones that did
+	std::unique_lock<std::mutex> lock(mutex);
+	job_threads = 0;
+	job_done.wait(lock, [&]() { return busy_threads == 0; });
+	running_job = nullptr;
+}
+
+unsigned WorkerPool::workerCount() const {
+	return (unsigned)workers.size();
+}
+
+WorkerPool& WorkerPool::shared() {
+	static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+	return pool;
+}
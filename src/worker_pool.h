@@ -0,0 +1,51 @@
+// WORKER POOL - Defines the WorkerPool class - a set of threads started once and reused for every parallel loop, instead of starting new threads each time
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+
+private:
+	std::vector<std::thread> workers;		/* Threads waiting for jobs. They run until the pool is destroyed */
+	std::mutex mutex;				/* Guards every member below */
+	std::condition_variable job_ready;		/* Wakes workers when a job starts or the pool is stopping */
+	std::condition_variable job_done;		/* Wakes run() when the last worker on the job finishes */
+	const std::function<void()>* running_job = nullptr;	/* The job being run, owned by the caller of run() */
+	uint64_t job_number = 0;			/* Counts jobs, so a worker never joins the same job twice */
+	unsigned job_threads = 0;			/* Number of workers that may still join the job */
+	unsigned busy_threads = 0;			/* Number of workers running the job right now */
+	bool stopping = false;				/* Set by the destructor to end every worker */
+	std::mutex run_mutex;				/* Held by run() for the whole job, so only one job runs at a time */
+
+	/* Waits for jobs and runs them until the pool stops */
+	void workerLoop();
+
+public:
+
+	//WorkerPool constructor - starts the given number of worker threads
+	WorkerPool(unsigned worker_count);
+
+	//WorkerPool destructor - stops and joins every worker
+	~WorkerPool();
+
+	//Worker pools own their threads and cannot be copied
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/* Runs a job on the calling thread and on up to thread_count - 1 workers at once, and returns when every one of them has finished.
+	   The job must be safe to run on several threads together, like a loop that takes the next piece of work from an atomic counter.
+	   A job started from inside a job, or while another thread's job is running, runs on the calling thread alone */
+	void run(unsigned thread_count, const std::function<void()>& job);
+
+	/* Returns the number of worker threads */
+	unsigned workerCount() const;
+
+	/* Returns the pool shared by the whole program, with one worker for each hardware thread besides the calling one. Started on first use */
+	static WorkerPool& shared();
+};
@@ -92,4 +92,476 @@ TEST_CASE("Test void zoom(float zoom_scale)") {
 	REQUIRE(test_camera.field_of_view == 600.0f * 1.1f * std::powf(1.1f, -1.0f));
 }
 
-//void drawModel(Model3D* model) cannot be tested directly
\ No newline at end of file
+/* The original per-point transformation, which recomputed the rotation for every point. Only the near plane check has changed since */
+ofVec2f referenceTransform(Camera& camera, ofVec3f point3d) {
+	float x = point3d.x - camera.position.x;
+	float y = point3d.y - camera.position.y;
+	float z = point3d.z - camera.position.z;
+	camera.rotateCoords(x, z, camera.rotation.x);
+	camera.rotateCoords(y, z, camera.rotation.y);
+	if (z < -camera.near_plane) {
+		z = camera.field_of_view / z;
+		return ofVec2f(camera.win_center.x - x * z, camera.win_center.y + y * z);
+	}
+	return camera.out_of_bounds_point;
+}
+
+TEST_CASE("Test view matrix against the original transformation") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+	std::vector<ofVec3f> points;
+	for (int i = 0; i < 1000; i++) {
+		points.push_back(ofVec3f(std::sin(i * 0.37f) * 10, std::cos(i * 0.11f) * 10, std::sin(i * 0.23f) * 10));
+	}
+
+	auto requireMatchesReference = [&]() {
+		std::vector<ofVec2f> batch(points.size());
+		camera.transform(points.data(), batch.data(), points.size());
+		for (size_t i = 0; i < points.size(); i++) {
+			ofVec2f expected = referenceTransform(camera, points[i]);
+			ofVec2f single = camera.transform(points[i]);
+			REQUIRE(single.x == Approx(expected.x).epsilon(1e-4).margin(1e-2));
+			REQUIRE(single.y == Approx(expected.y).epsilon(1e-4).margin(1e-2));
+			REQUIRE(batch[i] == single);
+		}
+	};
+
+	SECTION("Starting view") {
+		requireMatchesReference();
+	}
+
+	SECTION("After turning and moving") {
+		camera.update(ofVec3f(1, 0.5f, -2), ofVec2f(0.7f, -0.4f), false, 1);
+		requireMatchesReference();
+		camera.update(ofVec3f(), ofVec2f(-2.1f, 1.3f), true, 1);
+		requireMatchesReference();
+	}
+
+	SECTION("After zooming") {
+		camera.zoom(3.0f);
+		requireMatchesReference();
+		camera.zoom(-5.0f);
+		requireMatchesReference();
+	}
+
+	SECTION("After moving the position directly") {
+		camera.position += ofVec3f(0.5f, -1, 2);
+		requireMatchesReference();
+	}
+}
+
+TEST_CASE("Test void projectModel(const Model3D* model)") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+	Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(1, 0, 0), 0.4);
+	teapot.rotate(ofVec3f(0.3f, 0.2f, 0.1f));
+
+	camera.projectModel(&teapot);
+	REQUIRE(camera.projected_vertices.size() == teapot.mesh->vertices.size());
+	REQUIRE(camera.vertex_outcodes.size() == teapot.mesh->vertices.size());
+
+	//Every cached vertex should match transforming it on its own, and is visible if it lands in the window
+	for (size_t i = 0; i < teapot.mesh->vertices.size(); i++) {
+		ofVec2f point = camera.transform(teapot.transformedVertex(i) + teapot.position);
+		REQUIRE(camera.projected_vertices[i].x == Approx(point.x));
+		REQUIRE(camera.projected_vertices[i].y == Approx(point.y));
+		bool on_screen = point.x >= 0 && point.x <= test_width && point.y >= 0 && point.y <= test_height;
+		REQUIRE((camera.vertex_outcodes[i] == 0) == on_screen);
+	}
+
+	//A smaller model reuses the same buffers
+	Model3D cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 10), 1);
+	camera.projectModel(&cube);
+	REQUIRE(camera.projected_vertices.size() == cube.mesh->vertices.size());
+
+	//A model behind the camera is entirely behind the near plane
+	for (uint8_t outcode : camera.vertex_outcodes) {
+		REQUIRE(outcode == ProjectionKernel::BEHIND);
+	}
+}
+
+/* Whether a point is inside the window, allowing for rounding */
+static bool inWindow(ofVec2f point) {
+	float tolerance = 1e-2f;
+	return point.x >= -tolerance && point.x <= test_width + tolerance && point.y >= -tolerance && point.y <= test_height + tolerance;
+}
+
+TEST_CASE("Test void drawModel(Model3D* model, LineBatch& lines)") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+	Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::lightBlue, ofVec3f(1, 0, 0), 0.4);
+	LineBatch lines;
+	camera.drawModel(&teapot, lines);
+
+	//Every edge on the screen becomes one segment, in edge order
+	size_t segment = 0;
+	teapot.mesh->edges.forEach([&](uint32_t vert0, uint32_t vert1) {
+		ofVec2f point0 = camera.transform(teapot.transformedVertex(vert0) + teapot.position);
+		ofVec2f point1 = camera.transform(teapot.transformedVertex(vert1) + teapot.position);
+		REQUIRE(inWindow(point0));
+		REQUIRE(inWindow(point1));
+		REQUIRE(lines.getPoints()[segment * 2].x == Approx(point0.x));
+		REQUIRE(lines.getPoints()[segment * 2 + 1].y == Approx(point1.y));
+		REQUIRE(lines.getColors()[segment * 2] == ofFloatColor(ofColor::lightBlue));
+		segment++;
+	});
+	REQUIRE(segment > 0);
+	REQUIRE(lines.segmentCount() == segment);
+
+	//A second model is added after the first
+	Model3D cube = Model3D("..\\models\\cube.obj", ofColor::green, ofVec3f(-2, 0, 0), 1);
+	camera.drawModel(&cube, lines);
+	REQUIRE(lines.segmentCount() == segment + cube.mesh->edges.size());
+	REQUIRE(lines.getColors().back() == ofFloatColor(ofColor::green));
+}
+
+TEST_CASE("Test drawModel clips edges to the near plane and the window") {
+	LineBatch lines;
+
+	SECTION("Only the part of an edge inside the window is kept") {
+		//A long line across the floor, much wider than the screen
+		Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+		Model3D plane = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 0), 50);
+		camera.drawModel(&plane, lines);
+		REQUIRE(lines.segmentCount() > 0);
+		bool touches_edge = false;
+		for (const ofVec2f& point : lines.getPoints()) {
+			REQUIRE(inWindow(point));
+			touches_edge |= point.x < 1 || point.x > test_width - 1 || point.y < 1 || point.y > test_height - 1;
+		}
+		REQUIRE(touches_edge);
+	}
+
+	SECTION("An edge passing under the camera reaches the bottom of the screen") {
+		//Standing inside a cube, close to its floor and one wall, looking straight ahead. The edge between them starts ahead and ends behind the camera
+		Camera camera = Camera(ofVec3f(0.95f, -0.9f, 0), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+		Model3D cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 0), 2);
+		camera.projectModel(&cube);
+		bool some_vertex_behind = false;
+		for (uint8_t outcode : camera.vertex_outcodes) {
+			some_vertex_behind |= (outcode & ProjectionKernel::BEHIND) != 0;
+		}
+		REQUIRE(some_vertex_behind);
+
+		camera.drawModel(&cube, lines);
+		REQUIRE(lines.segmentCount() > 0);
+		bool reaches_bottom = false;
+		for (const ofVec2f& point : lines.getPoints()) {
+			REQUIRE(inWindow(point));
+			reaches_bottom |= point.y > test_height - 1;
+		}
+		REQUIRE(reaches_bottom);
+	}
+
+	SECTION("Nothing is drawn for a model entirely behind the camera") {
+		Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+		Model3D cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 10), 1);
+		camera.drawModel(&cube, lines);
+		REQUIRE(lines.segmentCount() == 0);
+	}
+}
+
+TEST_CASE("Test bool clipToNearPlane(ofVec3f& view_point0, ofVec3f& view_point1)") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+	camera.near_plane = 1;
+
+	SECTION("Both ends in front are unchanged") {
+		ofVec3f point0 = ofVec3f(1, 2, -3);
+		ofVec3f point1 = ofVec3f(-1, 0, -5);
+		REQUIRE(camera.clipToNearPlane(point0, point1));
+		REQUIRE(point0 == ofVec3f(1, 2, -3));
+		REQUIRE(point1 == ofVec3f(-1, 0, -5));
+	}
+
+	SECTION("The end behind is moved onto the plane") {
+		ofVec3f point0 = ofVec3f(0, 0, 1);
+		ofVec3f point1 = ofVec3f(4, 2, -3);
+		REQUIRE(camera.clipToNearPlane(point0, point1));
+		REQUIRE(nearlyEquivalent(point0, ofVec3f(2, 1, -1)));
+		REQUIRE(point1 == ofVec3f(4, 2, -3));
+	}
+
+	SECTION("Both ends behind are rejected") {
+		ofVec3f point0 = ofVec3f(0, 0, 1);
+		ofVec3f point1 = ofVec3f(4, 2, -1);
+		REQUIRE(!camera.clipToNearPlane(point0, point1));
+	}
+}
+
+TEST_CASE("Test bool clipToViewport(ofVec2f& point0, ofVec2f& point1)") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 100, 50);
+
+	SECTION("A segment inside the window is unchanged") {
+		ofVec2f point0 = ofVec2f(10, 10);
+		ofVec2f point1 = ofVec2f(90, 40);
+		REQUIRE(camera.clipToViewport(point0, point1));
+		REQUIRE(point0 == ofVec2f(10, 10));
+		REQUIRE(point1 == ofVec2f(90, 40));
+	}
+
+	SECTION("A segment crossing the window is cut at both sides") {
+		ofVec2f point0 = ofVec2f(-100, 25);
+		ofVec2f point1 = ofVec2f(200, 25);
+		REQUIRE(camera.clipToViewport(point0, point1));
+		REQUIRE(point0 == ofVec2f(0, 25));
+		REQUIRE(point1 == ofVec2f(100, 25));
+	}
+
+	SECTION("A diagonal segment is cut at the corner") {
+		ofVec2f point0 = ofVec2f(-10, -10);
+		ofVec2f point1 = ofVec2f(10, 10);
+		REQUIRE(camera.clipToViewport(point0, point1));
+		REQUIRE(point0 == ofVec2f(0, 0));
+		REQUIRE(point1 == ofVec2f(10, 10));
+	}
+
+	SECTION("Segments outside the window or not numbers are rejected") {
+		ofVec2f point0 = ofVec2f(-10, 60);
+		ofVec2f point1 = ofVec2f(60, 60);
+		REQUIRE(!camera.clipToViewport(point0, point1));
+		point0 = ofVec2f(-10, 30);
+		point1 = ofVec2f(20, -70);
+		REQUIRE(!camera.clipToViewport(point0, point1));
+		point0 = ofVec2f(std::numeric_limits<float>::quiet_NaN(), 10);
+		point1 = ofVec2f(10, 10);
+		REQUIRE(!camera.clipToViewport(point0, point1));
+	}
+}
+
+TEST_CASE("Test bool inFrustum(ofVec3f center, float radius)") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+
+	SECTION("Spheres in front of the camera are visible") {
+		REQUIRE(camera.inFrustum(ofVec3f(0, 0, 0), 1));
+		REQUIRE(camera.inFrustum(ofVec3f(0, 0, 0), 0));
+	}
+
+	SECTION("Spheres behind the camera are culled unless they reach past the near plane") {
+		REQUIRE(!camera.inFrustum(ofVec3f(0, 0, 10), 1));
+		REQUIRE(!camera.inFrustum(ofVec3f(0, 0, 6), 1));
+		REQUIRE(camera.inFrustum(ofVec3f(0, 0, 5.5f), 1));
+	}
+
+	SECTION("The camera is always inside a sphere around it") {
+		REQUIRE(camera.inFrustum(camera.position, 0.5f));
+	}
+
+	SECTION("Spheres beside the view are culled only once they are entirely outside it") {
+		//The right edge of the window is 960 / 600 = 1.6 units to the side for every unit of depth. At a depth of 5 that is 8 units
+		float edge = 1.6f * 5;
+		float radius = 1;
+		float normal_length = std::sqrt(1 + 1.6f * 1.6f);
+		REQUIRE(camera.inFrustum(ofVec3f(edge, 0, 0), radius));
+		REQUIRE(camera.inFrustum(ofVec3f(edge + radius * normal_length * 0.99f, 0, 0), radius));
+		REQUIRE(!camera.inFrustum(ofVec3f(edge + radius * normal_length * 1.01f, 0, 0), radius));
+		REQUIRE(!camera.inFrustum(ofVec3f(-edge - radius * normal_length * 1.01f, 0, 0), radius));
+		REQUIRE(!camera.inFrustum(ofVec3f(0, 20, 0), radius));
+		REQUIRE(!camera.inFrustum(ofVec3f(0, -20, 0), radius));
+	}
+}
+
+TEST_CASE("Test frustum culling only skips models that would draw nothing") {
+	Camera camera = Camera(ofVec3f(0, 0, 0), ofVec2f(0.4f, -0.1f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+	std::vector<Model3D> models;
+	for (int i = 0; i < 64; i++) {
+		float angle = i * TWO_PI / 64;
+		models.push_back(Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(std::cos(angle) * 6, (i % 5 - 2) * 1.5f, std::sin(angle) * 6), 0.4));
+	}
+
+	size_t culled = 0;
+	for (Model3D& model : models) {
+		LineBatch culled_lines;
+		LineBatch all_lines;
+		camera.frustum_culling = true;
+		bool drawn = camera.drawModel(&model, culled_lines);
+		camera.frustum_culling = false;
+		REQUIRE(camera.drawModel(&model, all_lines));
+		if (!drawn) {
+			culled++;
+		}
+		REQUIRE(culled_lines.getPoints() == all_lines.getPoints());
+	}
+
+	//A ring of models around the camera is mostly out of view
+	REQUIRE(culled > models.size() / 2);
+	REQUIRE(culled < models.size());
+}
+
+TEST_CASE("Test ofVec3f screenRay(ofVec2f screen_point)") {
+	Camera camera = Camera(ofVec3f(1, 2, 5), ofVec2f(0.4f, -0.3f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+
+	//Points along the ray through a pixel project back onto that pixel
+	for (ofVec2f screen_point : { ofVec2f(960, 540), ofVec2f(0, 0), ofVec2f(1920, 1080), ofVec2f(100, 900) }) {
+		ofVec3f direction = camera.screenRay(screen_point);
+		REQUIRE(direction.length() == Approx(1));
+		for (float distance : { 1.0f, 10.0f }) {
+			ofVec2f projected = camera.transform(camera.position + direction * distance);
+			REQUIRE(projected.x == Approx(screen_point.x).margin(1e-2));
+			REQUIRE(projected.y == Approx(screen_point.y).margin(1e-2));
+		}
+	}
+}
+
+TEST_CASE("Test void findOutlineEdges(const Mesh& mesh, const ModelInstance& instance)") {
+	Camera camera = Camera(ofVec3f(0.5f, 1.5f, 4), ofVec2f(0.1f, 0.3f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+
+	SECTION("A box seen straight on shows only its creases") {
+		Model3D cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0.5f, 1.5f, 0), 1);
+		camera.findOutlineEdges(*cube.mesh, cube.instance());
+		REQUIRE(camera.outline_edges == cube.mesh->crease_edges);
+	}
+
+	SECTION("Silhouettes match faces turned toward the camera in world space") {
+		Model3D sphere = Model3D("..\\models\\sphere.obj", ofColor::white, ofVec3f(-1, 0, -2), 1.5f);
+		sphere.rotate(ofVec3f(0.3f, 1.2f, -0.4f));
+		const Mesh& mesh = *sphere.mesh;
+		camera.findOutlineEdges(*sphere.mesh, sphere.instance());
+		std::vector<uint32_t> outline = camera.outline_edges;
+		std::sort(outline.begin(), outline.end());
+
+		//Find the same edges the slow way, with every face moved into world space first
+		std::vector<bool> faces_toward(mesh.face_normals.size());
+		for (size_t face = 0; face < faces_toward.size(); face++) {
+			ofVec3f corner0 = sphere.transformedVertex(mesh.triangles[face * 3]) + sphere.position;
+			ofVec3f corner1 = sphere.transformedVertex(mesh.triangles[face * 3 + 1]) + sphere.position;
+			ofVec3f corner2 = sphere.transformedVertex(mesh.triangles[face * 3 + 2]) + sphere.position;
+			faces_toward[face] = (corner1 - corner0).getCrossed(corner2 - corner0).dot(camera.position - corner0) > 0;
+		}
+		std::vector<uint32_t> expected = mesh.crease_edges;
+		for (uint32_t edge : mesh.smooth_edges) {
+			if (faces_toward[mesh.edge_faces[edge * 2]] != faces_toward[mesh.edge_faces[edge * 2 + 1]]) {
+				expected.push_back(edge);
+			}
+		}
+		std::sort(expected.begin(), expected.end());
+		REQUIRE(outline == expected);
+
+		//A smooth sphere's outline is a single ring of edges
+		REQUIRE(outline.size() > 0);
+		REQUIRE(outline.size() < mesh.edges.size() / 5);
+	}
+
+	SECTION("drawModel draws only the outline") {
+		Model3D cow = Model3D("..\\models\\cow.obj", ofColor::white, ofVec3f(0.5f, 1.5f, 0), 0.2f);
+		LineBatch lines;
+		camera.outline_only = true;
+		REQUIRE(camera.drawModel(&cow, lines));
+		REQUIRE(lines.segmentCount() == camera.outline_edges.size());
+		REQUIRE(lines.segmentCount() < cow.mesh->edges.size() / 10);
+	}
+}
+
+TEST_CASE("Test size_t drawInstances(const Mesh& mesh, const std::vector<ModelInstance>& instances, LineBatch& lines, DepthBuffer* depth_buffer)") {
+	Camera camera = Camera(ofVec3f(0, 0, 0), ofVec2f(0.4f, -0.1f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+
+	//A cloud of balls all around the camera, some of them out of view
+	std::vector<Model3D> balls;
+	std::vector<ModelInstance> instances;
+	for (int i = 0; i < 100; i++) {
+		float angle = i * TWO_PI / 100;
+		balls.push_back(Model3D("..\\models\\sphere.obj", ofColor(i, 255 - i, 100), ofVec3f(std::cos(angle) * (4 + i % 7), (i % 5 - 2) * 1.5f, std::sin(angle) * 5), 0.2f + (i % 3) * 0.1f));
+		balls.back().rotate(ofVec3f(0.1f * i, 0.3f, -0.02f * i));
+		instances.push_back(balls.back().instance());
+	}
+	const Mesh& mesh = *balls[0].mesh;
+
+	SECTION("The same lines as drawing each model") {
+		LineBatch model_lines;
+		size_t culled = 0;
+		for (Model3D& ball : balls) {
+			culled += !camera.drawModel(&ball, model_lines);
+		}
+		LineBatch instance_lines;
+		REQUIRE(camera.drawInstances(mesh, instances, instance_lines) == culled);
+		REQUIRE(culled > 0);
+		REQUIRE(instance_lines.getPoints() == model_lines.getPoints());
+		REQUIRE(instance_lines.getColors() == model_lines.getColors());
+	}
+
+	SECTION("The same depth and hidden lines as drawing each model") {
+		DepthBuffer model_depth = DepthBuffer(test_width, test_height);
+		DepthBuffer instance_depth = DepthBuffer(test_width, test_height);
+		for (Model3D& ball : balls) {
+			camera.drawModelDepth(&ball, model_depth);
+		}
+		camera.drawInstancesDepth(mesh, instances, instance_depth);
+		model_depth.updateTiles();
+		instance_depth.updateTiles();
+		for (int y = 0; y < test_height; y += 7) {
+			for (int x = 0; x < test_width; x += 7) {
+				REQUIRE(instance_depth.getDepth(x, y) == model_depth.getDepth(x, y));
+			}
+		}
+
+		LineBatch model_lines;
+		for (Model3D& ball : balls) {
+			camera.drawModel(&ball, model_lines, &model_depth);
+		}
+		LineBatch instance_lines;
+		camera.drawInstances(mesh, instances, instance_lines, &instance_depth);
+		REQUIRE(instance_lines.getPoints() == model_lines.getPoints());
+	}
+}
+
+TEST_CASE("Test float projectedRadius(ofVec3f center, float radius)") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+	REQUIRE(camera.projectedRadius(ofVec3f(0, 0, -5), 1) == Approx(60));
+	REQUIRE(camera.projectedRadius(ofVec3f(3, 2, -15), 2) == Approx(60));
+
+	//Nothing behind the camera or around it has a size
+	REQUIRE(std::isinf(camera.projectedRadius(ofVec3f(0, 0, 5.5f), 1)));
+	REQUIRE(std::isinf(camera.projectedRadius(ofVec3f(0, 0, 10), 1)));
+}
+
+TEST_CASE("Test drawModel decimates models that are small on screen") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, test_width, test_height);
+	Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(0, 0, 0), 0.4f);
+	size_t edge_count = teapot.mesh->edges.size();
+	REQUIRE(teapot.mesh->edges_by_priority.size() == edge_count);
+	float screen_radius = camera.projectedRadius(teapot.position, teapot.boundingRadius());
+	LineBatch lines;
+
+	SECTION("A model larger than the thresholds draws every edge") {
+		camera.decimation_radius = screen_radius * 0.9f;
+		camera.marker_radius = 2;
+		camera.drawModel(&teapot, lines);
+		REQUIRE(lines.segmentCount() == edge_count);
+		REQUIRE(camera.edges_decimated == 0);
+	}
+
+	SECTION("A model smaller than the decimation radius draws its most important edges") {
+		camera.decimation_radius = screen_radius * 2;
+		camera.drawModel(&teapot, lines);
+		REQUIRE(lines.segmentCount() == (size_t)std::ceil(edge_count * 0.25f));
+		REQUIRE(camera.edges_decimated == edge_count - lines.segmentCount());
+
+		//The first edge drawn is the top ranked one
+		Edge first = teapot.mesh->edges[teapot.mesh->edges_by_priority[0]];
+		camera.projectModel(&teapot);
+		REQUIRE(lines.getPoints()[0] == camera.projected_vertices[first.v0]);
+		REQUIRE(lines.getPoints()[1] == camera.projected_vertices[first.v1]);
+	}
+
+	SECTION("A model smaller than the marker radius draws a square") {
+		camera.marker_radius = screen_radius * 1.5f;
+		camera.drawModel(&teapot, lines);
+		REQUIRE(lines.segmentCount() == 4);
+		REQUIRE(camera.marker_count == 1);
+		REQUIRE(camera.edges_decimated == edge_count);
+		REQUIRE(lines.getPoints()[0] == ofVec2f(960 - screen_radius, 540 - screen_radius));
+		REQUIRE(lines.getPoints()[3] == ofVec2f(960 + screen_radius, 540 + screen_radius));
+
+		camera.resetDrawCounters();
+		REQUIRE(camera.marker_count == 0);
+		REQUIRE(camera.edges_decimated == 0);
+	}
+
+	SECTION("Sub-pixel edges are skipped") {
+		Model3D distant = Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(0, 0, -400), 0.4f);
+		camera.min_edge_length = 1;
+		camera.drawModel(&distant, lines);
+		REQUIRE(camera.edges_subpixel > edge_count / 2);
+		REQUIRE(lines.segmentCount() == edge_count - camera.edges_subpixel);
+		for (size_t i = 0; i < lines.getPoints().size(); i += 2) {
+			ofVec2f difference = lines.getPoints()[i + 1] - lines.getPoints()[i];
+			REQUIRE((std::abs(difference.x) >= 1 || std::abs(difference.y) >= 1));
+		}
+	}
+}
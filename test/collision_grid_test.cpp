@@ -0,0 +1,96 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+/* Every pair of overlapping bodies, found by checking every pair */
+static std::vector<std::pair<uint32_t, uint32_t>> linearPairs(const std::vector<PhysicsBody*>& bodies) {
+	std::vector<std::pair<uint32_t, uint32_t>> pairs;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		for (uint32_t j = i + 1; j < bodies.size(); j++) {
+			if ((bodies[j]->position - bodies[i]->position).length() <= bodies[i]->radius + bodies[j]->radius) {
+				pairs.push_back(std::make_pair(i, j));
+			}
+		}
+	}
+	return pairs;
+}
+
+TEST_CASE("Test void findPairs(const BodyStore& bodies, std::vector<std::pair<uint32_t, uint32_t>>& pairs)") {
+	CollisionGrid grid;
+	std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+	SECTION("No bodies") {
+		BodyStore bodies;
+		grid.build(bodies);
+		grid.findPairs(bodies, pairs);
+		REQUIRE(pairs.empty());
+	}
+
+	SECTION("The same pairs as checking every pair") {
+		for (float box_size : { 4.0f, 10.0f, 40.0f }) {
+			std::vector<PhysicsBody*> bodies = boxOfBalls(600, box_size / 2);
+			BodyStore store = storeOf(bodies);
+			grid.build(store);
+			REQUIRE(grid.cellSize() == Approx(bodies[3]->radius * 2));
+			REQUIRE(grid.bucketCount() == 2048);
+			grid.findPairs(store, pairs);
+			std::vector<std::pair<uint32_t, uint32_t>> expected = linearPairs(bodies);
+			REQUIRE(pairs.size() >= expected.size());
+
+			//The grid may keep a pair only a rounding error apart, which collideWithBody() rejects anyway
+			for (const std::pair<uint32_t, uint32_t>& pair : pairs) {
+				if (std::find(expected.begin(), expected.end(), pair) == expected.end()) {
+					float distance = (bodies[pair.second]->position - bodies[pair.first]->position).length();
+					REQUIRE(distance == Approx(bodies[pair.first]->radius + bodies[pair.second]->radius).epsilon(2e-4));
+				}
+			}
+			for (const std::pair<uint32_t, uint32_t>& pair : expected) {
+				REQUIRE(std::binary_search(pairs.begin(), pairs.end(), pair));
+			}
+			deleteModels(bodies);
+		}
+	}
+
+	SECTION("Bodies far from the origin or with no position don't break the grid") {
+		std::vector<PhysicsBody*> bodies = boxOfBalls(50, 2);
+		bodies[0]->position = ofVec3f(1e30f, 0, 0);
+		bodies[1]->position = ofVec3f(std::nanf(""), 0, 0);
+		bodies[2]->position = bodies[3]->position;
+		BodyStore store = storeOf(bodies);
+		grid.build(store);
+		grid.findPairs(store, pairs);
+		REQUIRE(std::binary_search(pairs.begin(), pairs.end(), std::make_pair(2u, 3u)));
+		for (const std::pair<uint32_t, uint32_t>& pair : pairs) {
+			REQUIRE(pair.first > 1);
+		}
+		deleteModels(bodies);
+	}
+}
+
+TEST_CASE("Test collisions through the grid match colliding every pair") {
+	std::vector<PhysicsBody*> grid_bodies = boxOfBalls(400, 3);
+	std::vector<PhysicsBody*> linear_bodies = boxOfBalls(400, 3);
+	CollisionGrid grid;
+	std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+	for (int step = 0; step < 20; step++) {
+		BodyStore store = storeOf(grid_bodies);
+		grid.build(store);
+		grid.findPairs(store, pairs);
+		for (const std::pair<uint32_t, uint32_t>& pair : pairs) {
+			grid_bodies[pair.first]->collideWithBody(grid_bodies[pair.second]);
+		}
+		for (size_t i = 0; i + 1 < linear_bodies.size(); i++) {
+			for (size_t j = i + 1; j < linear_bodies.size(); j++) {
+				linear_bodies[i]->collideWith(linear_bodies[j]);
+			}
+		}
+		for (size_t i = 0; i < grid_bodies.size(); i++) {
+			grid_bodies[i]->update(1.0f / 60);
+			linear_bodies[i]->update(1.0f / 60);
+			REQUIRE(grid_bodies[i]->velocity == linear_bodies[i]->velocity);
+			REQUIRE(grid_bodies[i]->position == linear_bodies[i]->position);
+		}
+	}
+	deleteModels(grid_bodies);
+	deleteModels(linear_bodies);
+}
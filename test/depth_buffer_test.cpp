@@ -0,0 +1,180 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+/* Total screen length of every segment in a batch */
+static float totalLength(const LineBatch& lines) {
+	float length = 0;
+	for (size_t i = 0; i < lines.getPoints().size(); i += 2) {
+		length += (lines.getPoints()[i + 1] - lines.getPoints()[i]).length();
+	}
+	return length;
+}
+
+TEST_CASE("Test void rasterizeTriangle(ofVec2f point0, float depth0, ofVec2f point1, float depth1, ofVec2f point2, float depth2)") {
+	DepthBuffer depth_buffer = DepthBuffer(40, 30);
+
+	SECTION("Covers the pixel centers inside the triangle, in either winding") {
+		depth_buffer.rasterizeTriangle(ofVec2f(0, 0), 1, ofVec2f(20, 0), 1, ofVec2f(0, 20), 1);
+		REQUIRE(depth_buffer.getDepth(0, 0) == Approx(1));
+		REQUIRE(depth_buffer.getDepth(18, 0) == Approx(1));
+		REQUIRE(depth_buffer.getDepth(0, 18) == Approx(1));
+		REQUIRE(depth_buffer.getDepth(10, 10) == 0);
+		REQUIRE(depth_buffer.getDepth(20, 0) == 0);
+
+		depth_buffer.rasterizeTriangle(ofVec2f(40, 30), 2, ofVec2f(20, 30), 2, ofVec2f(40, 10), 2);
+		REQUIRE(depth_buffer.getDepth(39, 29) == Approx(2));
+		REQUIRE(depth_buffer.getDepth(21, 29) == Approx(2));
+		REQUIRE(depth_buffer.getDepth(25, 15) == 0);
+	}
+
+	SECTION("Blends the corners' depths and keeps the nearest face") {
+		depth_buffer.rasterizeTriangle(ofVec2f(0, 0), 1, ofVec2f(40, 0), 3, ofVec2f(0, 40), 1);
+		REQUIRE(depth_buffer.getDepth(0, 0) == Approx(1 + 2 * 0.5f / 40));
+		REQUIRE(depth_buffer.getDepth(20, 5) == Approx(1 + 2 * 20.5f / 40));
+
+		//A farther face doesn't replace it, a nearer one does
+		depth_buffer.rasterizeTriangle(ofVec2f(0, 0), 0.5f, ofVec2f(40, 0), 0.5f, ofVec2f(0, 40), 0.5f);
+		REQUIRE(depth_buffer.getDepth(20, 5) == Approx(1 + 2 * 20.5f / 40));
+		depth_buffer.rasterizeTriangle(ofVec2f(0, 0), 5, ofVec2f(40, 0), 5, ofVec2f(0, 40), 5);
+		REQUIRE(depth_buffer.getDepth(20, 5) == Approx(5));
+	}
+
+	SECTION("Corners far off the buffer are clipped") {
+		depth_buffer.rasterizeTriangle(ofVec2f(-1e6f, -1e6f), 1, ofVec2f(1e6f, -1e6f), 1, ofVec2f(0, 1e6f), 1);
+		REQUIRE(depth_buffer.getDepth(20, 15) == Approx(1));
+		REQUIRE(depth_buffer.getDepth(39, 29) == Approx(1));
+	}
+
+	SECTION("clear() removes every face") {
+		depth_buffer.rasterizeTriangle(ofVec2f(0, 0), 1, ofVec2f(40, 0), 1, ofVec2f(0, 30), 1);
+		depth_buffer.clear();
+		REQUIRE(depth_buffer.getDepth(0, 0) == 0);
+	}
+}
+
+TEST_CASE("Test void addVisibleParts(ofVec2f point0, float depth0, ofVec2f point1, float depth1, const ofFloatColor& color, LineBatch& lines)") {
+	DepthBuffer depth_buffer = DepthBuffer(64, 32);
+	LineBatch lines;
+
+	//A square face at inverse depth 1 covering x from 16 to 48
+	depth_buffer.rasterizeTriangle(ofVec2f(16, 0), 1, ofVec2f(48, 0), 1, ofVec2f(16, 32), 1);
+	depth_buffer.rasterizeTriangle(ofVec2f(48, 0), 1, ofVec2f(48, 32), 1, ofVec2f(16, 32), 1);
+	depth_buffer.updateTiles();
+
+	SECTION("A segment in front of the face is drawn whole") {
+		depth_buffer.addVisibleParts(ofVec2f(0, 10.5f), 2, ofVec2f(64, 10.5f), 2, ofColor::white, lines);
+		REQUIRE(lines.segmentCount() == 1);
+		REQUIRE(lines.getPoints()[0] == ofVec2f(0, 10.5f));
+		REQUIRE(lines.getPoints()[1] == ofVec2f(64, 10.5f));
+	}
+
+	SECTION("A segment on the face itself is drawn whole") {
+		depth_buffer.addVisibleParts(ofVec2f(16, 10.5f), 1, ofVec2f(48, 10.5f), 1, ofColor::white, lines);
+		REQUIRE(lines.segmentCount() == 1);
+	}
+
+	SECTION("A segment behind the face is split around it") {
+		depth_buffer.addVisibleParts(ofVec2f(0, 10.5f), 0.5f, ofVec2f(64, 10.5f), 0.5f, ofColor::red, lines);
+		REQUIRE(lines.segmentCount() == 2);
+		REQUIRE(lines.getPoints()[0] == ofVec2f(0, 10.5f));
+		REQUIRE(lines.getPoints()[1] == ofVec2f(16, 10.5f));
+		REQUIRE(lines.getPoints()[2] == ofVec2f(48, 10.5f));
+		REQUIRE(lines.getPoints()[3] == ofVec2f(64, 10.5f));
+		REQUIRE(lines.getColors()[3] == ofFloatColor(ofColor::red));
+		REQUIRE(depth_buffer.edges_rejected == 0);
+	}
+
+	SECTION("A segment entirely behind the face is rejected by the tiles alone") {
+		depth_buffer.addVisibleParts(ofVec2f(20, 5), 0.5f, ofVec2f(40, 25), 0.9f, ofColor::white, lines);
+		REQUIRE(lines.segmentCount() == 0);
+		REQUIRE(depth_buffer.edges_tested == 1);
+		REQUIRE(depth_buffer.edges_rejected == 1);
+	}
+}
+
+TEST_CASE("Test hidden-line drawing of models") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	DepthBuffer depth_buffer = DepthBuffer(1920, 1080);
+	Model3D cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 0), 1);
+	REQUIRE(cube.mesh->triangles.size() == 12 * 3);
+
+	SECTION("Only the front face of a cube seen straight on is drawn") {
+		//With the usual bias, edges a few hundredths of a unit behind the front face show near its corners
+		depth_buffer.bias = 0.001f;
+		REQUIRE(camera.drawModelDepth(&cube, depth_buffer));
+		depth_buffer.updateTiles();
+		LineBatch lines;
+		REQUIRE(camera.drawModel(&cube, lines, &depth_buffer));
+
+		//The front face is 1 unit wide at a distance of 4.5, so its outline and one diagonal add up to this many pixels
+		float side = 600.0f / 4.5f;
+		REQUIRE(totalLength(lines) == Approx(side * (4 + std::sqrt(2.0f))).epsilon(0.02));
+
+		//Without hiding, the back face and the sides are drawn as well
+		LineBatch wireframe;
+		camera.drawModel(&cube, wireframe);
+		REQUIRE(totalLength(wireframe) > totalLength(lines) * 1.5f);
+	}
+
+	SECTION("A teapot hides its own back and every visible part stays on screen") {
+		Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(0, 0, 0), 0.6f);
+		camera.drawModelDepth(&teapot, depth_buffer);
+		depth_buffer.updateTiles();
+		LineBatch lines;
+		camera.drawModel(&teapot, lines, &depth_buffer);
+		LineBatch wireframe;
+		camera.drawModel(&teapot, wireframe);
+		REQUIRE(lines.segmentCount() > 0);
+		REQUIRE(totalLength(lines) < totalLength(wireframe) * 0.75f);
+		for (const ofVec2f& point : lines.getPoints()) {
+			REQUIRE((point.x >= 0 && point.x <= 1920 && point.y >= 0 && point.y <= 1080));
+		}
+	}
+
+	SECTION("A model behind another is hidden") {
+		Model3D hidden_cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, -3), 0.5f);
+		camera.drawModelDepth(&cube, depth_buffer);
+		camera.drawModelDepth(&hidden_cube, depth_buffer);
+		depth_buffer.updateTiles();
+		LineBatch lines;
+		camera.drawModel(&hidden_cube, lines, &depth_buffer);
+		REQUIRE(lines.segmentCount() == 0);
+		REQUIRE(depth_buffer.edges_rejected > 0);
+	}
+
+	SECTION("Faces crossing the near plane still hide what is behind them") {
+		//Standing inside a large cube, the back wall hides nothing but a small cube outside it is hidden
+		Model3D room = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 5), 4);
+		Model3D outside_cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, -2), 0.5f);
+		camera.drawModelDepth(&room, depth_buffer);
+		depth_buffer.updateTiles();
+		LineBatch lines;
+		camera.drawModel(&outside_cube, lines, &depth_buffer);
+		REQUIRE(lines.segmentCount() == 0);
+		camera.drawModel(&room, lines, &depth_buffer);
+		REQUIRE(lines.segmentCount() > 0);
+	}
+}
+
+TEST_CASE("Test int clipTriangleToNearPlane(const ofVec3f triangle[3], ofVec3f clipped[4])") {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	camera.near_plane = 1;
+	ofVec3f clipped[4];
+
+	ofVec3f in_front[3] = { ofVec3f(0, 0, -2), ofVec3f(1, 0, -2), ofVec3f(0, 1, -3) };
+	REQUIRE(camera.clipTriangleToNearPlane(in_front, clipped) == 3);
+	REQUIRE(clipped[2] == ofVec3f(0, 1, -3));
+
+	ofVec3f one_behind[3] = { ofVec3f(0, 0, -3), ofVec3f(2, 0, 1), ofVec3f(0, 2, -3) };
+	REQUIRE(camera.clipTriangleToNearPlane(one_behind, clipped) == 4);
+	for (int i = 0; i < 4; i++) {
+		REQUIRE(clipped[i].z <= -1);
+	}
+
+	ofVec3f two_behind[3] = { ofVec3f(0, 0, -3), ofVec3f(2, 0, 1), ofVec3f(0, 2, 1) };
+	REQUIRE(camera.clipTriangleToNearPlane(two_behind, clipped) == 3);
+	REQUIRE(nearlyEquivalent(clipped[1], ofVec3f(1, 0, -1)));
+
+	ofVec3f all_behind[3] = { ofVec3f(0, 0, 0), ofVec3f(2, 0, 1), ofVec3f(0, 2, 1) };
+	REQUIRE(camera.clipTriangleToNearPlane(all_behind, clipped) == 0);
+}
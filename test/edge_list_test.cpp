@@ -0,0 +1,42 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+TEST_CASE("Test EdgeList storage") {
+	EdgeList edge_list = EdgeList();
+
+	SECTION("Small indices are stored in 16 bits") {
+		edge_list.push_back(Edge(0, 1));
+		edge_list.push_back(Edge(65535, 2));
+		REQUIRE(!edge_list.isWide());
+		REQUIRE(edge_list.size() == 2);
+		REQUIRE(edge_list[1] == Edge(65535, 2));
+
+		//Half of the space an ofVec2f edge would take
+		REQUIRE(edge_list.byteSize() == edge_list.size() * sizeof(ofVec2f) / 2);
+	}
+
+	SECTION("Large indices switch the list to 32 bits") {
+		edge_list.push_back(Edge(0, 1));
+		edge_list.push_back(Edge(3, 70000));
+		REQUIRE(edge_list.isWide());
+		REQUIRE(edge_list.size() == 2);
+		REQUIRE(edge_list[0] == Edge(0, 1));
+		REQUIRE(edge_list[1] == Edge(3, 70000));
+	}
+
+	SECTION("Indices above 2^24 are kept exactly") {
+		edge_list.push_back(Edge(16777217, 16777219));
+		REQUIRE(edge_list[0] == Edge(16777217, 16777219));
+	}
+
+	SECTION("forEach visits every edge in order") {
+		edge_list.push_back(Edge(4, 5));
+		edge_list.push_back(Edge(6, 7));
+		std::vector<uint32_t> visited;
+		edge_list.forEach([&](uint32_t vert0, uint32_t vert1) {
+			visited.push_back(vert0);
+			visited.push_back(vert1);
+		});
+		REQUIRE(visited == std::vector<uint32_t>{ 4, 5, 6, 7 });
+	}
+}
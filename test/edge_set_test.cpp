@@ -0,0 +1,29 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+TEST_CASE("Test bool insert(int vert0, int vert1)") {
+	EdgeSet edge_set = EdgeSet();
+
+	SECTION("New edges are inserted") {
+		REQUIRE(edge_set.insert(0, 1));
+		REQUIRE(edge_set.insert(1, 2));
+		REQUIRE(edge_set.size() == 2);
+	}
+
+	SECTION("Repeated and reversed edges are rejected") {
+		edge_set.insert(3, 7);
+		REQUIRE(!edge_set.insert(3, 7));
+		REQUIRE(!edge_set.insert(7, 3));
+		REQUIRE(edge_set.size() == 1);
+	}
+
+	SECTION("Set grows past its initial capacity") {
+		for (int i = 0; i < 1000; i++) {
+			REQUIRE(edge_set.insert(i, i + 1));
+		}
+		for (int i = 0; i < 1000; i++) {
+			REQUIRE(!edge_set.insert(i + 1, i));
+		}
+		REQUIRE(edge_set.size() == 1000);
+	}
+}
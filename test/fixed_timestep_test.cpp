@@ -0,0 +1,49 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+TEST_CASE("Test int advance(float frame_time)") {
+	FixedTimestep timestep;
+	timestep.step_time = 0.25f;
+	timestep.max_steps = 4;
+
+	SECTION("Frames shorter than a step add up to one") {
+		REQUIRE(timestep.advance(0.1f) == 0);
+		REQUIRE(timestep.advance(0.1f) == 0);
+		REQUIRE(timestep.advance(0.1f) == 1);
+		REQUIRE(timestep.interpolation() == Approx(0.2f));
+	}
+
+	SECTION("Frames longer than a step run several") {
+		REQUIRE(timestep.advance(0.625f) == 2);
+		REQUIRE(timestep.interpolation() == Approx(0.5f));
+		REQUIRE(timestep.advance(0.125f) == 1);
+		REQUIRE(timestep.interpolation() == Approx(0));
+	}
+
+	SECTION("A stall runs the most steps allowed and drops the rest, keeping what's left of a step") {
+		REQUIRE(timestep.advance(10.125f) == 4);
+		REQUIRE(timestep.interpolation() == Approx(0.5f));
+		REQUIRE(timestep.advance(0.125f) == 1);
+	}
+
+	SECTION("Frame times that are not positive numbers add nothing") {
+		REQUIRE(timestep.advance(-1) == 0);
+		REQUIRE(timestep.advance(std::nanf("")) == 0);
+		REQUIRE(timestep.advance(std::numeric_limits<float>::infinity()) == 0);
+		REQUIRE(timestep.interpolation() == 0);
+	}
+
+	SECTION("Shortening the step leaves the interpolation at most 1 until the next frame catches up") {
+		timestep.advance(0.2f);
+		timestep.step_time = 0.1f;
+		REQUIRE(timestep.interpolation() == 1);
+		REQUIRE(timestep.advance(0) == 2);
+	}
+
+	SECTION("Resetting drops what's left over") {
+		timestep.advance(0.2f);
+		timestep.reset();
+		REQUIRE(timestep.interpolation() == 0);
+		REQUIRE(timestep.advance(0.2f) == 0);
+	}
+}
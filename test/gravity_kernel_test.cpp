@@ -0,0 +1,144 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+#include <cmath>
+#include <limits>
+
+/* Deterministic bodies of a few masses and sizes scattered through a ball, some of them touching */
+static BodyStore scatteredBodies(size_t count, float ball_radius) {
+	BodyStore bodies;
+	bodies.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f direction = scatteredPoint(i).getNormalized();
+		float distance = ball_radius * std::abs(std::sin(i * 1.7f));
+		bodies.setBody(i, direction * distance, 1.0f + i % 7, 0.02f * (i % 3));
+	}
+	return bodies;
+}
+
+/* Runs one path over every body of a store and returns the forces */
+static std::vector<ofVec3f> runPath(ProjectionKernel::Path path, BodyStore bodies, float softening) {
+	GravityKernel::accumulate(bodies, 0, bodies.size(), softening, path);
+	std::vector<ofVec3f> forces;
+	for (size_t i = 0; i < bodies.size(); i++) {
+		forces.push_back(bodies.force(i));
+	}
+	return forces;
+}
+
+/* Requires each force to be within a small fraction of the largest force of the reference, since the approximate reciprocal
+   square root changes the last bits of every term */
+static void requireClose(const std::vector<ofVec3f>& forces, const std::vector<ofVec3f>& reference) {
+	REQUIRE(forces.size() == reference.size());
+	float largest = 0;
+	for (const ofVec3f& force : reference) {
+		largest = std::max(largest, force.length());
+	}
+	for (size_t i = 0; i < forces.size(); i++) {
+		REQUIRE((forces[i] - reference[i]).length() <= largest * 1e-5f);
+	}
+}
+
+TEST_CASE("Test BodyStore") {
+	BodyStore bodies;
+	bodies.resize(3);
+	bodies.setBody(1, ofVec3f(1, 2, 3), 4, 5);
+	bodies.setForce(2, ofVec3f(6, 7, 8));
+
+	//Padded to a whole register, with padding that has no mass and no position
+	REQUIRE(bodies.size() == 3);
+	REQUIRE(bodies.paddedSize() == 8);
+	REQUIRE(bodies.position(1) == ofVec3f(1, 2, 3));
+	REQUIRE(bodies.masses[1] == 4);
+	REQUIRE(bodies.radii[1] == 5);
+	REQUIRE(bodies.force(2) == ofVec3f(6, 7, 8));
+	REQUIRE(bodies.position(0) == ofVec3f(0, 0, 0));
+	REQUIRE(std::isnan(bodies.xs[3]));
+	REQUIRE(bodies.masses[7] == 0);
+
+	//Growing over old padding turns it into bodies at the origin
+	bodies.resize(9);
+	REQUIRE(bodies.paddedSize() == 16);
+	REQUIRE(bodies.position(1) == ofVec3f(1, 2, 3));
+	REQUIRE(bodies.position(5) == ofVec3f(0, 0, 0));
+	REQUIRE(std::isnan(bodies.zs[15]));
+}
+
+/* Requires the scalar kernel to give each body the same force as gravitating every pair of them */
+static void requireMatchesGravitateWith(const std::vector<PhysicsBody*>& physics_bodies) {
+	BodyStore bodies;
+	bodies.resize(physics_bodies.size());
+	for (size_t i = 0; i < physics_bodies.size(); i++) {
+		physics_bodies[i]->force = ofVec3f();
+		bodies.setBody(i, physics_bodies[i]->position, physics_bodies[i]->mass, physics_bodies[i]->radius);
+	}
+	for (size_t i = 0; i < physics_bodies.size(); i++) {
+		for (size_t j = i + 1; j < physics_bodies.size(); j++) {
+			physics_bodies[i]->gravitateWith(physics_bodies[j]);
+		}
+	}
+	GravityKernel::accumulateScalar(bodies, 0, bodies.size(), 0);
+	for (size_t i = 0; i < physics_bodies.size(); i++) {
+		REQUIRE(nearlyEquivalent(bodies.force(i), physics_bodies[i]->force));
+	}
+}
+
+TEST_CASE("Test GravityKernel::accumulateScalar against PhysicsBody::gravitateWith") {
+	PhysicsBody body0 = PhysicsBody("..\\models\\sphere.obj", ofColor::white, 100.0f, ofVec3f(1, 0, 0), ofVec3f(), ofVec3f(), 1.0f);
+	PhysicsBody body1 = PhysicsBody("..\\models\\sphere.obj", ofColor::white, 30.0f, ofVec3f(-5, 2, 1), ofVec3f(), ofVec3f(), 0.5f);
+	PhysicsBody body2 = PhysicsBody("..\\models\\sphere.obj", ofColor::white, 70.0f, ofVec3f(2, 6, -3), ofVec3f(), ofVec3f(), 0.2f);
+
+	SECTION("Bodies are not colliding") {
+		requireMatchesGravitateWith({ &body0, &body1, &body2 });
+	}
+
+	SECTION("Two of the bodies are colliding") {
+		body2.position = ofVec3f(1.5f, 0.5f, 0);
+		requireMatchesGravitateWith({ &body0, &body1, &body2 });
+		REQUIRE(body2.force.length() > 0);
+	}
+}
+
+TEST_CASE("Test GravityKernel::accumulateAVX2 against the scalar path") {
+	if (!ProjectionKernel::supports(ProjectionKernel::AVX2)) {
+		WARN("AVX2 is not supported here, so only the scalar path was tested");
+		return;
+	}
+
+	SECTION("Every count up to a few registers, so every amount of padding is covered") {
+		for (size_t count = 0; count <= 40; count++) {
+			BodyStore bodies = scatteredBodies(count, 3);
+			requireClose(runPath(ProjectionKernel::AVX2, bodies, 0), runPath(ProjectionKernel::SCALAR, bodies, 0));
+		}
+	}
+
+	SECTION("More bodies than a tile, with and without softening") {
+		BodyStore bodies = scatteredBodies(GravityKernel::TILE_BODIES * 2 + 77, 20);
+		for (float softening : { 0.0f, 0.1f, 3.0f }) {
+			requireClose(runPath(ProjectionKernel::AVX2, bodies, softening), runPath(ProjectionKernel::SCALAR, bodies, softening));
+		}
+	}
+
+	SECTION("Bodies on top of each other and bodies that are not numbers pull on nothing") {
+		BodyStore bodies = scatteredBodies(20, 3);
+		bodies.setBody(4, bodies.position(3), 10, 0);
+		bodies.radii[3] = 0;
+		bodies.xs[9] = std::numeric_limits<float>::quiet_NaN();
+		std::vector<ofVec3f> forces = runPath(ProjectionKernel::AVX2, bodies, 0);
+		for (const ofVec3f& force : forces) {
+			REQUIRE(std::isfinite(force.x));
+			REQUIRE(std::isfinite(force.y));
+			REQUIRE(std::isfinite(force.z));
+		}
+		requireClose(forces, runPath(ProjectionKernel::SCALAR, bodies, 0));
+	}
+
+	SECTION("Running a range gives the same forces as running everything") {
+		BodyStore bodies = scatteredBodies(300, 10);
+		std::vector<ofVec3f> everything = runPath(ProjectionKernel::AVX2, bodies, 0.1f);
+		GravityKernel::accumulateAVX2(bodies, 100, 70, 0.1f);
+		for (size_t i = 100; i < 170; i++) {
+			REQUIRE(bodies.force(i) == everything[i]);
+		}
+	}
+}
@@ -0,0 +1,162 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+/* Deterministic small bodies of a few masses scattered through a ball, denser toward the middle like a star cluster */
+static std::vector<PhysicsBody*> clusterOfBodies(size_t count, float cluster_radius) {
+	std::vector<PhysicsBody*> bodies;
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f direction = scatteredPoint(i).getNormalized();
+		float distance = cluster_radius * std::abs(std::sin(i * 1.7f)) * std::abs(std::cos(i * 0.13f));
+		bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 1 + i % 5, direction * distance, ofVec3f(), ofVec3f(), 0.01f));
+	}
+	return bodies;
+}
+
+/* Runs a solver over a store of the bodies and returns the force on each */
+static std::vector<ofVec3f> solverForces(GravitySolver& solver, const std::vector<PhysicsBody*>& bodies) {
+	BodyStore store = storeOf(bodies);
+	solver.applyForces(store);
+	std::vector<ofVec3f> forces;
+	for (size_t i = 0; i < store.size(); i++) {
+		forces.push_back(store.force(i));
+	}
+	return forces;
+}
+
+/* Square root of the mean squared difference between two sets of forces, relative to the mean squared size of the reference forces */
+static float relativeError(const std::vector<ofVec3f>& forces, const std::vector<ofVec3f>& reference) {
+	double error = 0;
+	double size = 0;
+	for (size_t i = 0; i < forces.size(); i++) {
+		error += (forces[i] - reference[i]).lengthSquared();
+		size += reference[i].lengthSquared();
+	}
+	return (float)std::sqrt(error / size);
+}
+
+TEST_CASE("Test void applyForces(BodyStore& bodies)") {
+	GravitySolver solver;
+
+	SECTION("No bodies") {
+		BodyStore bodies;
+		solver.method = GravitySolver::BARNES_HUT;
+		solver.applyForces(bodies);
+		REQUIRE(solver.nodeCount() == 0);
+	}
+
+	SECTION("The direct sum matches gravitating every pair") {
+		std::vector<PhysicsBody*> bodies = clusterOfBodies(200, 10);
+		std::vector<ofVec3f> direct = solverForces(solver, bodies);
+
+		for (size_t i = 0; i + 1 < bodies.size(); i++) {
+			for (size_t j = i + 1; j < bodies.size(); j++) {
+				bodies[i]->gravitateWith(bodies[j]);
+			}
+		}
+		for (size_t i = 0; i < bodies.size(); i++) {
+			REQUIRE(direct[i].x == Approx(bodies[i]->force.x).epsilon(1e-3).margin(1e-6));
+			REQUIRE(direct[i].y == Approx(bodies[i]->force.y).epsilon(1e-3).margin(1e-6));
+			REQUIRE(direct[i].z == Approx(bodies[i]->force.z).epsilon(1e-3).margin(1e-6));
+		}
+		deleteModels(bodies);
+	}
+
+	SECTION("Touching bodies don't pull on each other") {
+		std::vector<PhysicsBody*> bodies = clusterOfBodies(2, 10);
+		bodies[1]->position = bodies[0]->position + ofVec3f(bodies[0]->radius, 0, 0);
+		for (GravitySolver::Method method : { GravitySolver::DIRECT, GravitySolver::BARNES_HUT }) {
+			solver.method = method;
+			std::vector<ofVec3f> forces = solverForces(solver, bodies);
+			REQUIRE(forces[0] == ofVec3f());
+			REQUIRE(forces[1] == ofVec3f());
+		}
+		deleteModels(bodies);
+	}
+
+	SECTION("A node is opened for a body touching one inside it, even when its center of mass is in the far corner") {
+		//Eight bodies bunched in one corner of the root's first child, one in the opposite corner, and one just past it touching that one
+		std::vector<PhysicsBody*> bodies;
+		for (int i = 0; i < 8; i++) {
+			bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 1, ofVec3f(i * 0.001f, 0, 0), ofVec3f(), ofVec3f(), 0.0001f));
+		}
+		bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 1, ofVec3f(3.95f, 3.9f, 3.9f), ofVec3f(), ofVec3f(), 0.05f));
+		bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 1, ofVec3f(4.04f, 3.9f, 3.9f), ofVec3f(), ofVec3f(), 0.05f));
+		bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 1, ofVec3f(8, 8, 8), ofVec3f(), ofVec3f(), 0.0001f));
+		std::vector<ofVec3f> direct = solverForces(solver, bodies);
+
+		//Even with an opening angle that lets every node pull as one mass, the touching body must not pull at all
+		solver.method = GravitySolver::BARNES_HUT;
+		solver.opening_angle = 100;
+		std::vector<ofVec3f> tree = solverForces(solver, bodies);
+		REQUIRE(relativeError({ tree[9] }, { direct[9] }) < 1e-3f);
+		deleteModels(bodies);
+	}
+
+	SECTION("An opening angle of 0 opens every node, matching the direct sum") {
+		std::vector<PhysicsBody*> bodies = clusterOfBodies(3000, 10);
+		std::vector<ofVec3f> direct = solverForces(solver, bodies);
+		solver.method = GravitySolver::BARNES_HUT;
+		solver.opening_angle = 0;
+		std::vector<ofVec3f> tree = solverForces(solver, bodies);
+		REQUIRE(solver.nodeCount() > 3000 / 8);
+		REQUIRE(relativeError(tree, direct) < 1e-5f);
+		deleteModels(bodies);
+	}
+
+	SECTION("The error grows with the opening angle, and stays small at the default") {
+		std::vector<PhysicsBody*> bodies = clusterOfBodies(3000, 10);
+		std::vector<ofVec3f> direct = solverForces(solver, bodies);
+		solver.method = GravitySolver::BARNES_HUT;
+		float last_error = 0;
+		for (float opening_angle : { 0.3f, 0.5f, 1.0f }) {
+			solver.opening_angle = opening_angle;
+			float error = relativeError(solverForces(solver, bodies), direct);
+			REQUIRE(error > last_error);
+			last_error = error;
+			if (opening_angle == 0.5f) {
+				REQUIRE(error < 0.01f);
+			}
+		}
+		deleteModels(bodies);
+	}
+
+	SECTION("The forces don't depend on the number of threads") {
+		std::vector<PhysicsBody*> bodies = clusterOfBodies(3000, 10);
+		for (GravitySolver::Method method : { GravitySolver::DIRECT, GravitySolver::BARNES_HUT }) {
+			solver.method = method;
+			solver.thread_count = 1;
+			std::vector<ofVec3f> one_thread = solverForces(solver, bodies);
+			solver.thread_count = 7;
+			std::vector<ofVec3f> seven_threads = solverForces(solver, bodies);
+			REQUIRE(one_thread == seven_threads);
+		}
+		deleteModels(bodies);
+	}
+
+	SECTION("Softening weakens close passes but not distant ones") {
+		std::vector<PhysicsBody*> bodies = clusterOfBodies(2, 10);
+		bodies[0]->position = ofVec3f(0, 0, 0);
+		bodies[1]->position = ofVec3f(0.5f, 0, 0);
+		float plain = solverForces(solver, bodies)[0].x;
+		solver.softening = 0.5f;
+		float softened = solverForces(solver, bodies)[0].x;
+		REQUIRE(softened == Approx(plain / std::pow(2.0f, 1.5f)));
+
+		bodies[1]->position = ofVec3f(500, 0, 0);
+		solver.softening = 0;
+		plain = solverForces(solver, bodies)[0].x;
+		solver.softening = 0.5f;
+		REQUIRE(solverForces(solver, bodies)[0].x == Approx(plain).epsilon(1e-5));
+		deleteModels(bodies);
+	}
+
+	SECTION("Bodies that are all in the same place") {
+		std::vector<PhysicsBody*> bodies = clusterOfBodies(2000, 0);
+		solver.method = GravitySolver::BARNES_HUT;
+		std::vector<ofVec3f> forces = solverForces(solver, bodies);
+		for (const ofVec3f& force : forces) {
+			REQUIRE(force == ofVec3f());
+		}
+		deleteModels(bodies);
+	}
+}
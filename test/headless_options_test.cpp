@@ -0,0 +1,156 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+TEST_CASE("Test static bool parse(const std::vector<std::string>& args, HeadlessOptions& options, std::string& error)") {
+	HeadlessOptions options;
+	std::string error;
+
+	SECTION("No arguments keeps the defaults and the window") {
+		REQUIRE(HeadlessOptions::parse({}, options, error));
+		REQUIRE(!options.enabled);
+		REQUIRE(options.demo == "models");
+		REQUIRE(options.width == 1920);
+		REQUIRE(options.height == 1080);
+	}
+
+	SECTION("Every option") {
+		REQUIRE(HeadlessOptions::parse({ "--headless", "--demo", "box", "--frames", "120", "--size", "640x360", "--every", "10",
+			"--output", "out/run_", "--format", "png", "--frame-time", "0.02", "--physics-rate", "240", "--aa", "--floor", "--hidden-lines", "--outlines", "--gravity", "barnes-hut", "--seed", "7" }, options, error));
+		REQUIRE(options.enabled);
+		REQUIRE(options.demo == "box");
+		REQUIRE(options.frame_count == 120);
+		REQUIRE(options.width == 640);
+		REQUIRE(options.height == 360);
+		REQUIRE(options.save_every == 10);
+		REQUIRE(options.output_prefix == "out/run_");
+		REQUIRE(options.format == "png");
+		REQUIRE(options.frame_time == 0.02f);
+		REQUIRE(options.physics_rate == 240);
+		REQUIRE(options.anti_aliasing);
+		REQUIRE(options.show_floor);
+		REQUIRE(options.hidden_lines);
+		REQUIRE(options.outlines_only);
+		REQUIRE(options.gravity == "barnes-hut");
+		REQUIRE(options.seed == 7);
+	}
+
+	SECTION("Invalid arguments are rejected with a message") {
+		for (std::vector<std::string> args : std::vector<std::vector<std::string>>({
+			{ "--bogus" }, { "--frames" }, { "--frames", "0" }, { "--frames", "ten" }, { "--demo", "teapot" },
+			{ "--size", "640" }, { "--size", "640x" }, { "--size", "0x360" }, { "--format", "bmp" },
+			{ "--frame-time", "-1" }, { "--every", "-2" }, { "--physics-rate", "0" }, { "--gravity", "fast" }, { "--seed", "1.5" } })) {
+			error.clear();
+			REQUIRE(!HeadlessOptions::parse(args, options, error));
+			REQUIRE(!error.empty());
+		}
+	}
+}
+
+TEST_CASE("Test bool shouldSave(int frame) and std::string framePath(int frame)") {
+	HeadlessOptions options;
+	options.frame_count = 30;
+
+	SECTION("Every nth frame, starting with the first") {
+		options.save_every = 10;
+		REQUIRE(options.shouldSave(0));
+		REQUIRE(!options.shouldSave(9));
+		REQUIRE(options.shouldSave(10));
+		REQUIRE(options.shouldSave(20));
+		REQUIRE(!options.shouldSave(29));
+	}
+
+	SECTION("Only the last frame") {
+		options.save_every = 0;
+		REQUIRE(!options.shouldSave(0));
+		REQUIRE(options.shouldSave(29));
+	}
+
+	SECTION("File names sort in frame order") {
+		options.output_prefix = "out/frame_";
+		options.format = "png";
+		REQUIRE(options.framePath(7) == "out/frame_00007.png");
+		REQUIRE(options.framePath(12345) == "out/frame_12345.png");
+	}
+}
+
+/* Runs the renderer without a window for the given options, the way main() does, frame by frame until it has drawn them all.
+   The main loop keeps the window it is given, so one window is set up for the whole test run and never destroyed */
+static void runHeadless(const HeadlessOptions& options) {
+	static std::shared_ptr<ofAppNoWindow> window = [&]() {
+		std::shared_ptr<ofAppNoWindow> no_window = std::make_shared<ofAppNoWindow>();
+		ofSetupOpenGL(no_window, options.width, options.height, OF_WINDOW);
+		return no_window;
+	}();
+	Renderer renderer(options);
+	renderer.setup();
+	for (int frame = 0; frame < options.frame_count; frame++) {
+		renderer.update();
+		renderer.draw();
+	}
+}
+
+/* Returns the first count bytes of a file, or fewer if it is shorter */
+static std::string fileStart(const std::filesystem::path& path, size_t count) {
+	std::string start(count, '\0');
+	std::ifstream file(path, std::ios::binary);
+	file.read(&start[0], count);
+	start.resize((size_t)file.gcount());
+	return start;
+}
+
+TEST_CASE("Test a headless run saves the frames it was asked for") {
+	std::filesystem::path folder = std::filesystem::temp_directory_path() / "headless_test";
+	std::filesystem::remove_all(folder);
+	std::filesystem::create_directories(folder);
+
+	HeadlessOptions options;
+	options.enabled = true;
+	options.demo = "planets";
+	options.frame_count = 5;
+	options.save_every = 2;
+	options.width = 64;
+	options.height = 48;
+	options.output_prefix = (folder / "frame_").string();
+
+	SECTION("PPM frames") {
+		runHeadless(options);
+
+		//Frames 0, 2 and 4 and nothing else, each a binary PPM of the whole frame
+		std::vector<std::string> names;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(folder)) {
+			names.push_back(entry.path().filename().string());
+		}
+		std::sort(names.begin(), names.end());
+		REQUIRE(names == std::vector<std::string>({ "frame_00000.ppm", "frame_00002.ppm", "frame_00004.ppm" }));
+		for (const std::string& name : names) {
+			std::string header = "P6\n64 48\n255\n";
+			REQUIRE(fileStart(folder / name, header.size()) == header);
+			REQUIRE(std::filesystem::file_size(folder / name) == header.size() + 64 * 48 * 3);
+		}
+	}
+
+	SECTION("Only the last frame, as a PNG") {
+		options.save_every = 0;
+		options.format = "png";
+		runHeadless(options);
+
+		std::vector<std::string> names;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(folder)) {
+			names.push_back(entry.path().filename().string());
+		}
+		REQUIRE(names == std::vector<std::string>({ "frame_00004.png" }));
+
+		//The PNG signature, then the IHDR chunk with the width and height as big-endian 32 bit numbers
+		std::string start = fileStart(folder / names[0], 24);
+		REQUIRE(start.size() == 24);
+		REQUIRE(start.substr(0, 8) == std::string("\x89PNG\r\n\x1a\n", 8));
+		REQUIRE(start.substr(12, 4) == "IHDR");
+		REQUIRE(start.substr(16, 8) == std::string("\0\0\0\x40\0\0\0\x30", 8));
+	}
+
+	std::filesystem::remove_all(folder);
+}
@@ -0,0 +1,40 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+TEST_CASE("Test void addSegment(const ofVec2f& point0, const ofVec2f& point1, const ofFloatColor& color)") {
+	LineBatch lines;
+	REQUIRE(lines.segmentCount() == 0);
+
+	lines.addSegment(ofVec2f(1, 2), ofVec2f(3, 4), ofColor::red);
+	lines.addSegment(ofVec2f(5, 6), ofVec2f(7, 8), ofColor::blue);
+	REQUIRE(lines.segmentCount() == 2);
+
+	//Both endpoints of a segment are stored next to each other, each with the segment's color
+	REQUIRE(lines.getPoints() == std::vector<ofVec2f>({ ofVec2f(1, 2), ofVec2f(3, 4), ofVec2f(5, 6), ofVec2f(7, 8) }));
+	REQUIRE(lines.getColors() == std::vector<ofFloatColor>({ ofColor::red, ofColor::red, ofColor::blue, ofColor::blue }));
+}
+
+TEST_CASE("Test LineBatch reuse across frames") {
+	LineBatch lines;
+	lines.reserve(100);
+	REQUIRE(lines.segmentCapacity() >= 100);
+
+	//Fill the batch for one frame
+	for (int i = 0; i < 1000; i++) {
+		lines.addSegment(ofVec2f(i, 0), ofVec2f(0, i), ofColor::white);
+	}
+	size_t capacity = lines.segmentCapacity();
+	const ofVec2f* memory = lines.getPoints().data();
+
+	//Later frames of the same size or smaller use the same memory
+	for (int frame = 0; frame < 10; frame++) {
+		lines.clear();
+		REQUIRE(lines.segmentCount() == 0);
+		for (int i = 0; i < 1000 - frame; i++) {
+			lines.addSegment(ofVec2f(i, frame), ofVec2f(frame, i), ofColor::white);
+		}
+		REQUIRE(lines.segmentCount() == 1000 - frame);
+		REQUIRE(lines.segmentCapacity() == capacity);
+		REQUIRE(lines.getPoints().data() == memory);
+	}
+}
@@ -0,0 +1,123 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+#include <cstdio>
+#include <fstream>
+
+/* Describes an OBJ file with the given contents and modification time */
+static MeshCacheSource testSource(const std::string& contents, int64_t modified_time) {
+	MeshCacheSource source;
+	source.data = contents.data();
+	source.size = contents.size();
+	source.modified_time = modified_time;
+	return source;
+}
+
+/* Flips one byte of a file at the given offset from its start */
+void corruptByte(const std::string& file_path, long offset) {
+	std::fstream file(file_path, std::ios::in | std::ios::out | std::ios::binary);
+	file.seekg(offset);
+	char byte = file.get();
+	file.seekp(offset);
+	file.put(~byte);
+}
+
+TEST_CASE("Test MeshCache save and load") {
+	std::string cache_path = "mesh_cache_test.rrmesh";
+	std::vector<ofVec3f> vertices = { ofVec3f(0, 1, 2), ofVec3f(-1, 0.5, 3), ofVec3f(4, 4, 4) };
+	EdgeList edges;
+	edges.push_back(Edge(0, 1));
+	edges.push_back(Edge(1, 2));
+	edges.push_back(Edge(2, 0));
+	std::vector<uint32_t> triangles = { 0, 1, 2, 2, 1, 0 };
+	std::string obj = "v 0 1 2\nv -1 0.5 3\nv 4 4 4\n";
+	MeshCacheSource source = testSource(obj, 1234);
+	REQUIRE(MeshCache::save(cache_path, source, vertices, edges, triangles));
+
+	std::vector<ofVec3f> loaded_vertices;
+	EdgeList loaded_edges;
+	std::vector<uint32_t> loaded_triangles;
+
+	SECTION("Round trip") {
+		REQUIRE(MeshCache::load(cache_path, source, loaded_vertices, loaded_edges, loaded_triangles));
+		REQUIRE(loaded_vertices == vertices);
+		REQUIRE(loaded_edges == edges);
+		REQUIRE(loaded_triangles == triangles);
+	}
+
+	SECTION("Damaged triangle data") {
+		long triangle_offset = sizeof(MeshCacheHeader) + vertices.size() * sizeof(ofVec3f) + edges.byteSize();
+		corruptByte(cache_path, triangle_offset + 4);
+		REQUIRE(!MeshCache::load(cache_path, source, loaded_vertices, loaded_edges, loaded_triangles));
+	}
+
+	SECTION("Triangles pointing past the vertices") {
+		triangles[4] = 3;
+		REQUIRE(MeshCache::save(cache_path, source, vertices, edges, triangles));
+		REQUIRE(!MeshCache::load(cache_path, source, loaded_vertices, loaded_edges, loaded_triangles));
+		REQUIRE(loaded_triangles.empty());
+	}
+
+	SECTION("Stale cache from a source file of a different size") {
+		std::string longer_obj = obj + "v 5 5 5\n";
+		REQUIRE(!MeshCache::load(cache_path, testSource(longer_obj, 1234), loaded_vertices, loaded_edges, loaded_triangles));
+		REQUIRE(loaded_vertices.empty());
+	}
+
+	SECTION("Stale cache from a changed source file of the same size") {
+		std::string changed_obj = "v 0 1 2\nv -1 0.5 3\nv 4 4 5\n";
+		REQUIRE(!MeshCache::load(cache_path, testSource(changed_obj, 4321), loaded_vertices, loaded_edges, loaded_triangles));
+		REQUIRE(loaded_vertices.empty());
+	}
+
+	SECTION("A source file of the same size and time is trusted without hashing it") {
+		std::string changed_obj = "v 0 1 2\nv -1 0.5 3\nv 4 4 5\n";
+		REQUIRE(MeshCache::load(cache_path, testSource(changed_obj, 1234), loaded_vertices, loaded_edges, loaded_triangles));
+	}
+
+	SECTION("A source file that was only touched is hashed once, then trusted by its new time") {
+		REQUIRE(MeshCache::load(cache_path, testSource(obj, 4321), loaded_vertices, loaded_edges, loaded_triangles));
+		std::string changed_obj = "v 0 1 2\nv -1 0.5 3\nv 4 4 5\n";
+		REQUIRE(MeshCache::load(cache_path, testSource(changed_obj, 4321), loaded_vertices, loaded_edges, loaded_triangles));
+		REQUIRE(loaded_vertices == vertices);
+	}
+
+	SECTION("Damaged vertex data") {
+		corruptByte(cache_path, sizeof(MeshCacheHeader) + 5);
+		REQUIRE(!MeshCache::load(cache_path, source, loaded_vertices, loaded_edges, loaded_triangles));
+	}
+
+	SECTION("Damaged header") {
+		corruptByte(cache_path, 0);
+		REQUIRE(!MeshCache::load(cache_path, source, loaded_vertices, loaded_edges, loaded_triangles));
+	}
+
+	SECTION("Truncated file") {
+		std::ofstream(cache_path, std::ios::binary | std::ios::trunc).write("RRMESH", 6);
+		REQUIRE(!MeshCache::load(cache_path, source, loaded_vertices, loaded_edges, loaded_triangles));
+	}
+
+	SECTION("Missing file") {
+		std::remove(cache_path.c_str());
+		REQUIRE(!MeshCache::load(cache_path, source, loaded_vertices, loaded_edges, loaded_triangles));
+	}
+
+	std::remove(cache_path.c_str());
+}
+
+TEST_CASE("Test cached model matches the OBJ") {
+	std::string obj_path = "..\\models\\teapot.obj";
+	std::remove(MeshCache::cachePath(obj_path).c_str());
+
+	//The first import parses the OBJ and writes the cache, the second reads the cache
+	Mesh parsed;
+	parsed.readFromOBJ(obj_path);
+	REQUIRE(std::ifstream(MeshCache::cachePath(obj_path)).good());
+	Mesh cached;
+	cached.readFromOBJ(obj_path);
+
+	REQUIRE(cached.vertices == parsed.vertices);
+	REQUIRE(cached.edges == parsed.edges);
+	REQUIRE(cached.triangles == parsed.triangles);
+	REQUIRE(!cached.triangles.empty());
+}
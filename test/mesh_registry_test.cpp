@@ -0,0 +1,65 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+TEST_CASE("Test std::shared_ptr<const Mesh> acquire(const std::string& obj_path)") {
+
+	SECTION("Many models read the file once") {
+		size_t loads_before = MeshRegistry::loadCount();
+		std::vector<PhysicsBody*> balls;
+		for (int i = 0; i < 40; i++) {
+			balls.push_back(new PhysicsBody("..\\models\\tetrahedron.obj", ofColor::white, 1, ofVec3f(i, 0, 0), ofVec3f(), ofVec3f(), 0.1 * i));
+		}
+		REQUIRE(MeshRegistry::loadCount() == loads_before + 1);
+
+		//Every ball points at the same vertices
+		bool all_shared = true;
+		for (PhysicsBody* ball : balls) {
+			all_shared = all_shared && (ball->mesh == balls[0]->mesh);
+		}
+		for (PhysicsBody* ball : balls) {
+			delete ball;
+		}
+		REQUIRE(all_shared);
+	}
+
+	SECTION("A mesh is released once no model uses it") {
+		std::weak_ptr<const Mesh> released;
+		{
+			Model3D model = Model3D("..\\models\\tetrahedron.obj", ofColor::white, ofVec3f(), 1);
+			released = model.mesh;
+		}
+		REQUIRE(released.expired());
+	}
+
+	SECTION("Meshes no model uses are forgotten") {
+		Model3D other = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(), 1);
+		size_t tracked = MeshRegistry::size();
+		{
+			Model3D model = Model3D("..\\models\\tetrahedron.obj", ofColor::white, ofVec3f(), 1);
+			REQUIRE(MeshRegistry::size() == tracked + 1);
+		}
+
+		//The next acquire forgets the tetrahedron
+		Model3D another = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(), 1);
+		REQUIRE(MeshRegistry::size() == tracked);
+	}
+
+	SECTION("Threads acquiring the same file at once read it once") {
+		size_t loads_before = MeshRegistry::loadCount();
+		std::vector<std::shared_ptr<const Mesh>> meshes(8);
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < meshes.size(); i++) {
+			threads.push_back(std::thread([&meshes, i]() {
+				meshes[i] = MeshRegistry::acquire("..\\models\\teapot.obj");
+			}));
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		REQUIRE(MeshRegistry::loadCount() == loads_before + 1);
+		for (const std::shared_ptr<const Mesh>& mesh : meshes) {
+			REQUIRE(mesh == meshes[0]);
+			REQUIRE(!mesh->vertices.empty());
+		}
+	}
+}
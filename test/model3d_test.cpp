@@ -13,38 +13,45 @@ TEST_CASE("Test Proper Construction of Model3D") {
 	SECTION("Test Proper Vertex Set") {
 		//A Cube should have 8 verticies, but different from those defined in cube.obj.
 		//Their average should be the origin and they should be multiplied by 2
-		REQUIRE(test_model.vertices.size() == 8);
-		REQUIRE(test_model.vertices[0] == ofVec3f(-1, -1, -1));
-		REQUIRE(test_model.vertices[1] == ofVec3f(-1, -1, 1));
-		REQUIRE(test_model.vertices[2] == ofVec3f(-1, 1, -1));
-		REQUIRE(test_model.vertices[3] == ofVec3f(-1, 1, 1));
-		REQUIRE(test_model.vertices[4] == ofVec3f(1, -1, -1));
-		REQUIRE(test_model.vertices[5] == ofVec3f(1, -1, 1));
-		REQUIRE(test_model.vertices[6] == ofVec3f(1, 1, -1));
-		REQUIRE(test_model.vertices[7] == ofVec3f(1, 1, 1));
+		REQUIRE(test_model.mesh->vertices.size() == 8);
+		REQUIRE(test_model.transformedVertex(0) == ofVec3f(-1, -1, -1));
+		REQUIRE(test_model.transformedVertex(1) == ofVec3f(-1, -1, 1));
+		REQUIRE(test_model.transformedVertex(2) == ofVec3f(-1, 1, -1));
+		REQUIRE(test_model.transformedVertex(3) == ofVec3f(-1, 1, 1));
+		REQUIRE(test_model.transformedVertex(4) == ofVec3f(1, -1, -1));
+		REQUIRE(test_model.transformedVertex(5) == ofVec3f(1, -1, 1));
+		REQUIRE(test_model.transformedVertex(6) == ofVec3f(1, 1, -1));
+		REQUIRE(test_model.transformedVertex(7) == ofVec3f(1, 1, 1));
+	}
+
+	SECTION("Test Bounding Radius") {
+		//The corners of a cube of side 2 are sqrt(3) from its center
+		REQUIRE(nearlyEquivalent(test_model.mesh->bounding_radius, std::sqrt(3.0f) / 2));
+		REQUIRE(nearlyEquivalent(test_model.boundingRadius(), std::sqrt(3.0f)));
 	}
 
 	SECTION("Test Proper Edge Set") {
 		//A Cube defined with triangles has 12 triangles, with 18 distinct edges
-		REQUIRE(test_model.edges.size() == 18);
-		REQUIRE(test_model.edges[0] == ofVec2f(0, 6));
-		REQUIRE(test_model.edges[1] == ofVec2f(6, 4));
-		REQUIRE(test_model.edges[2] == ofVec2f(4, 0));
-		REQUIRE(test_model.edges[3] == ofVec2f(0, 2));
-		REQUIRE(test_model.edges[4] == ofVec2f(2, 6));
-		REQUIRE(test_model.edges[5] == ofVec2f(0, 3));
-		REQUIRE(test_model.edges[6] == ofVec2f(3, 2));
-		REQUIRE(test_model.edges[7] == ofVec2f(0, 1));
-		REQUIRE(test_model.edges[8] == ofVec2f(1, 3));
-		REQUIRE(test_model.edges[9] == ofVec2f(2, 7));
-		REQUIRE(test_model.edges[10] == ofVec2f(7, 6));
-		REQUIRE(test_model.edges[11] == ofVec2f(3, 7));
-		REQUIRE(test_model.edges[12] == ofVec2f(7, 4));
-		REQUIRE(test_model.edges[13] == ofVec2f(7, 5));
-		REQUIRE(test_model.edges[14] == ofVec2f(5, 4));
-		REQUIRE(test_model.edges[15] == ofVec2f(5, 0));
-		REQUIRE(test_model.edges[16] == ofVec2f(5, 1));
-		REQUIRE(test_model.edges[17] == ofVec2f(7, 1));
+		REQUIRE(test_model.mesh->edges.size() == 18);
+		REQUIRE(!test_model.mesh->edges.isWide());
+		REQUIRE(test_model.mesh->edges[0] == Edge(0, 6));
+		REQUIRE(test_model.mesh->edges[1] == Edge(6, 4));
+		REQUIRE(test_model.mesh->edges[2] == Edge(4, 0));
+		REQUIRE(test_model.mesh->edges[3] == Edge(0, 2));
+		REQUIRE(test_model.mesh->edges[4] == Edge(2, 6));
+		REQUIRE(test_model.mesh->edges[5] == Edge(0, 3));
+		REQUIRE(test_model.mesh->edges[6] == Edge(3, 2));
+		REQUIRE(test_model.mesh->edges[7] == Edge(0, 1));
+		REQUIRE(test_model.mesh->edges[8] == Edge(1, 3));
+		REQUIRE(test_model.mesh->edges[9] == Edge(2, 7));
+		REQUIRE(test_model.mesh->edges[10] == Edge(7, 6));
+		REQUIRE(test_model.mesh->edges[11] == Edge(3, 7));
+		REQUIRE(test_model.mesh->edges[12] == Edge(7, 4));
+		REQUIRE(test_model.mesh->edges[13] == Edge(7, 5));
+		REQUIRE(test_model.mesh->edges[14] == Edge(5, 4));
+		REQUIRE(test_model.mesh->edges[15] == Edge(5, 0));
+		REQUIRE(test_model.mesh->edges[16] == Edge(5, 1));
+		REQUIRE(test_model.mesh->edges[17] == Edge(7, 1));
 	}
 }
 
@@ -53,29 +60,182 @@ TEST_CASE("Test Rotation") {
 	SECTION("No Rotation") {
 		test_model.rotate(ofVec3f(0, 0, 0));
 
-		REQUIRE(test_model.vertices[0] == ofVec3f(-1, -1, -1));
-		REQUIRE(test_model.vertices[1] == ofVec3f(-1, -1, 1));
-		REQUIRE(test_model.vertices[2] == ofVec3f(-1, 1, -1));
-		REQUIRE(test_model.vertices[3] == ofVec3f(-1, 1, 1));
-		REQUIRE(test_model.vertices[4] == ofVec3f(1, -1, -1));
-		REQUIRE(test_model.vertices[5] == ofVec3f(1, -1, 1));
-		REQUIRE(test_model.vertices[6] == ofVec3f(1, 1, -1));
-		REQUIRE(test_model.vertices[7] == ofVec3f(1, 1, 1));
+		REQUIRE(test_model.transformedVertex(0) == ofVec3f(-1, -1, -1));
+		REQUIRE(test_model.transformedVertex(1) == ofVec3f(-1, -1, 1));
+		REQUIRE(test_model.transformedVertex(2) == ofVec3f(-1, 1, -1));
+		REQUIRE(test_model.transformedVertex(3) == ofVec3f(-1, 1, 1));
+		REQUIRE(test_model.transformedVertex(4) == ofVec3f(1, -1, -1));
+		REQUIRE(test_model.transformedVertex(5) == ofVec3f(1, -1, 1));
+		REQUIRE(test_model.transformedVertex(6) == ofVec3f(1, 1, -1));
+		REQUIRE(test_model.transformedVertex(7) == ofVec3f(1, 1, 1));
 	}
 
 	SECTION("90 Degree Rotation about X-axis") {
 		test_model.rotate(ofVec3f(PI / 2, 0, 0));
 
-		REQUIRE(nearlyEquivalent(test_model.vertices[0], ofVec3f(-1, 1, -1)));
-		REQUIRE(nearlyEquivalent(test_model.vertices[1], ofVec3f(-1, -1, -1)));
-		REQUIRE(nearlyEquivalent(test_model.vertices[2], ofVec3f(-1, 1, 1)));
-		REQUIRE(nearlyEquivalent(test_model.vertices[3], ofVec3f(-1, -1, 1)));
-		REQUIRE(nearlyEquivalent(test_model.vertices[4], ofVec3f(1, 1, -1)));
-		REQUIRE(nearlyEquivalent(test_model.vertices[5], ofVec3f(1, -1, -1)));
-		REQUIRE(nearlyEquivalent(test_model.vertices[6], ofVec3f(1, 1, 1)));
-		REQUIRE(nearlyEquivalent(test_model.vertices[7], ofVec3f(1, -1, 1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(0), ofVec3f(-1, 1, -1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(1), ofVec3f(-1, -1, -1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(2), ofVec3f(-1, 1, 1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(3), ofVec3f(-1, -1, 1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(4), ofVec3f(1, 1, -1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(5), ofVec3f(1, -1, -1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(6), ofVec3f(1, 1, 1)));
+		REQUIRE(nearlyEquivalent(test_model.transformedVertex(7), ofVec3f(1, -1, 1)));
+	}
+}
+
+TEST_CASE("Test Edge Set Matches Linear Search Deduplication") {
+
+	SECTION("cube.obj") {
+		Model3D cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 0), 1);
+		REQUIRE(cube.mesh->edges == referenceEdges("..\\models\\cube.obj"));
+	}
+
+	SECTION("teapot.obj") {
+		Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(0, 0, 0), 1);
+		REQUIRE(teapot.mesh->edges == referenceEdges("..\\models\\teapot.obj"));
+	}
+}
+
+/* Imports an OBJ file into a mesh using the given number of threads */
+Mesh importWithThreads(std::string obj_path, unsigned thread_count) {
+	Mesh mesh;
+	MappedFile obj_file(obj_path);
+	mesh.importOBJ(obj_file, thread_count);
+	return mesh;
+}
+
+TEST_CASE("Test Chunked Import Matches Single-Threaded Import") {
+	for (std::string name : { "cube", "head", "teapot", "cow" }) {
+		std::string path = "..\\models\\" + name + ".obj";
+		Mesh single = importWithThreads(path, 1);
+
+		//Include more chunks than cube.obj has lines, so some chunks are empty
+		for (unsigned thread_count : { 2, 3, 8, 64 }) {
+			Mesh chunked = importWithThreads(path, thread_count);
+			REQUIRE(chunked.vertices == single.vertices);
+			REQUIRE(chunked.edges == single.edges);
+		}
 	}
 }
 
-//Methods readFromOBJ, addEdge, fixVertices, and rotateVector cannot be tested
-//directly and are tested thorugh the "Proper Construction" test case
\ No newline at end of file
+TEST_CASE("Test Models Share Their Mesh") {
+	Model3D small = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 0), 1);
+	Model3D large = Model3D("..\\models\\cube.obj", ofColor::red, ofVec3f(5, 0, 0), 3);
+	REQUIRE(small.mesh == large.mesh);
+
+	//Rotating or scaling one model doesn't affect the other
+	large.rotate(ofVec3f(PI / 2, 0, 0));
+	REQUIRE(small.transformedVertex(0) == ofVec3f(-0.5, -0.5, -0.5));
+	REQUIRE(nearlyEquivalent(large.transformedVertex(0), ofVec3f(-1.5, 1.5, -1.5)));
+}
+
+TEST_CASE("Test Repeated Rotation Does Not Drift") {
+	Model3D spinning = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 0), 2);
+
+	//A full turn in 10000 small steps about a tilted axis
+	ofVec3f axis = ofVec3f(1, 2, 3).getNormalized();
+	for (int i = 0; i < 10000; i++) {
+		spinning.rotate(axis * (2 * PI / 10000));
+	}
+
+	//The rest pose is untouched, and every vertex comes back to where it started
+	REQUIRE(spinning.mesh->vertices[7] == ofVec3f(0.5, 0.5, 0.5));
+	for (int i = 0; i < 8; i++) {
+		REQUIRE((spinning.transformedVertex(i) - spinning.mesh->vertices[i] * 2).length() < 0.001f);
+	}
+}
+TEST_CASE("Test Instance Matches The Model") {
+	Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::lightBlue, ofVec3f(3, 1, 2), 0.4);
+	teapot.rotate(ofVec3f(0.7f, -0.2f, 1.1f));
+	ModelInstance instance = teapot.instance();
+	REQUIRE(instance.position == teapot.position);
+	REQUIRE(instance.scale == teapot.scale);
+	REQUIRE(instance.color == teapot.color);
+	ofMatrix3x3 instance_matrix = instance.modelMatrix();
+	ofMatrix3x3 model_matrix = teapot.modelMatrix();
+	for (int i = 0; i < 9; i++) {
+		REQUIRE(instance_matrix[i] == model_matrix[i]);
+	}
+}
+
+TEST_CASE("Test Bounding Radius Contains Every Vertex") {
+	Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(3, 1, 2), 0.4);
+	teapot.rotate(ofVec3f(0.7f, -0.2f, 1.1f));
+	float radius = teapot.boundingRadius();
+	float furthest = 0;
+	for (size_t i = 0; i < teapot.mesh->vertices.size(); i++) {
+		furthest = std::max(furthest, teapot.transformedVertex(i).length());
+	}
+	REQUIRE(furthest <= radius * 1.0001f);
+	REQUIRE(furthest == Approx(radius).epsilon(1e-4));
+}
+
+TEST_CASE("Test Edge Adjacency") {
+	SECTION("cube.obj") {
+		Model3D cube = Model3D("..\\models\\cube.obj", ofColor::white, ofVec3f(0, 0, 0), 1);
+		const Mesh& mesh = *cube.mesh;
+		REQUIRE(mesh.edge_faces.size() == mesh.edges.size() * 2);
+		REQUIRE(mesh.face_normals.size() == 12);
+
+		//Every edge of a closed box has two faces, and both of them contain it
+		for (size_t i = 0; i < mesh.edges.size(); i++) {
+			Edge edge = mesh.edges[i];
+			for (int side = 0; side < 2; side++) {
+				uint32_t face = mesh.edge_faces[i * 2 + side];
+				REQUIRE(face != Mesh::NO_FACE);
+				const uint32_t* corners = &mesh.triangles[face * 3];
+				REQUIRE(std::count(corners, corners + 3, edge.v0) == 1);
+				REQUIRE(std::count(corners, corners + 3, edge.v1) == 1);
+			}
+		}
+
+		//The normals point out of the box, and each face's plane is half a unit from the center
+		for (size_t face = 0; face < mesh.face_normals.size(); face++) {
+			REQUIRE(mesh.face_normals[face].length() == Approx(1));
+			REQUIRE(mesh.face_offsets[face] == Approx(0.5f));
+		}
+
+		//The twelve edges of the box are creases. The six diagonals across its sides are flat
+		REQUIRE(mesh.crease_edges.size() == 12);
+		for (uint32_t index : mesh.crease_edges) {
+			Edge edge = mesh.edges[index];
+			REQUIRE((mesh.vertices[edge.v1] - mesh.vertices[edge.v0]).length() == Approx(1));
+		}
+
+		//The box's edges bend at right angles, so they outrank the longer diagonals
+		REQUIRE(mesh.edges_by_priority.size() == mesh.edges.size());
+		std::vector<uint32_t> first_twelve(mesh.edges_by_priority.begin(), mesh.edges_by_priority.begin() + 12);
+		std::sort(first_twelve.begin(), first_twelve.end());
+		REQUIRE(first_twelve == mesh.crease_edges);
+	}
+
+	SECTION("tetrahedron.obj") {
+		//Every edge of a tetrahedron bends by more than 60 degrees
+		Model3D tetrahedron = Model3D("..\\models\\tetrahedron.obj", ofColor::white, ofVec3f(0, 0, 0), 1);
+		REQUIRE(tetrahedron.mesh->crease_edges.size() == tetrahedron.mesh->edges.size());
+	}
+
+	SECTION("A mesh with a hole and a face with no area") {
+		Mesh mesh;
+		mesh.vertices = { ofVec3f(0, 0, 0), ofVec3f(1, 0, 0), ofVec3f(0, 1, 0), ofVec3f(1, 1, 0), ofVec3f(2, 1, 0) };
+		mesh.triangles = { 0, 1, 2, 1, 3, 2, 2, 3, 4 };
+		mesh.edges.push_back(Edge(0, 1));
+		mesh.edges.push_back(Edge(1, 2));
+		mesh.edges.push_back(Edge(2, 0));
+		mesh.edges.push_back(Edge(1, 3));
+		mesh.edges.push_back(Edge(3, 2));
+		mesh.edges.push_back(Edge(3, 4));
+		mesh.edges.push_back(Edge(4, 2));
+		mesh.computeEdgeFaces();
+
+		//Only the diagonal shared by the two real faces is flat. The straight third face adds nothing
+		REQUIRE(mesh.face_normals[2] == ofVec3f(0, 0, 0));
+		REQUIRE(mesh.edge_faces[1 * 2] == 0);
+		REQUIRE(mesh.edge_faces[1 * 2 + 1] == 1);
+		REQUIRE(mesh.edge_faces[4 * 2] == 1);
+		REQUIRE(mesh.edge_faces[4 * 2 + 1] == Mesh::NO_FACE);
+		REQUIRE(mesh.edge_faces[5 * 2] == Mesh::NO_FACE);
+		REQUIRE(mesh.crease_edges == std::vector<uint32_t>({ 0, 2, 3, 4, 5, 6 }));
+	}
+}
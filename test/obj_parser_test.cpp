@@ -0,0 +1,106 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+#include <charconv>
+
+/* Parses an OBJ file given as a string */
+ObjContents parseString(const std::string& obj_text) {
+	ObjContents contents;
+	ObjParser::parse(obj_text.data(), obj_text.data() + obj_text.size(), contents);
+	return contents;
+}
+
+TEST_CASE("Test void parse(const char* begin, const char* end, ObjContents& contents)") {
+
+	SECTION("Vertices and plain faces") {
+		ObjContents contents = parseString("v 1 2 3\nv -1.5 +2e1 0.25\nv 0 0 0\nf 1 2 3\n");
+		REQUIRE(contents.vertices.size() == 3);
+		REQUIRE(contents.vertices[1] == ofVec3f(-1.5f, 20.0f, 0.25f));
+		REQUIRE(contents.triangles == std::vector<uint32_t>{ 0, 1, 2 });
+	}
+
+	SECTION("Comments and other line types are skipped") {
+		ObjContents contents = parseString("# v 9 9 9\nvn 1 0 0\nvt 0.5 0.5\ng group\ns off\nusemtl none\nv 1 1 1\n");
+		REQUIRE(contents.vertices.size() == 1);
+		REQUIRE(contents.vertices[0] == ofVec3f(1, 1, 1));
+		REQUIRE(contents.triangles.empty());
+	}
+
+	SECTION("Texture and normal indices are ignored") {
+		ObjContents contents = parseString("f 1/1/1 2/2/2 3/3/3\nf  4//2  5//2  6//2 \nf 7/1 8/2 9/3");
+		REQUIRE(contents.triangles == std::vector<uint32_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+	}
+
+	SECTION("Windows line endings and extra vertex values") {
+		ObjContents contents = parseString("v 0.5 0.25 0.125 1.0 0.5 0.5\r\nf 1 1 1\r\n");
+		REQUIRE(contents.vertices.size() == 1);
+		REQUIRE(contents.vertices[0] == ofVec3f(0.5f, 0.25f, 0.125f));
+		REQUIRE(contents.triangles.size() == 3);
+	}
+
+	SECTION("Decimal shortcut matches std::from_chars") {
+		std::vector<std::string> numbers = { "0", "-0.992723", "135.483398", "0.000001", "3.268430", "-28.849100", "2.54558420181",
+			"123456789.123456", "1e-3", "-2.5E2", "7.", ".5", "0.1234567890123456789" };
+		for (const std::string& number : numbers) {
+			float expected = 0;
+			std::from_chars(number.data(), number.data() + number.size(), expected);
+			ObjContents contents = parseString("v " + number + " 0 0\n");
+			REQUIRE(contents.vertices.size() == 1);
+			REQUIRE(contents.vertices[0].x == expected);
+		}
+	}
+
+	SECTION("Numbers that end the file, the line or a long run of digits") {
+		ObjContents contents = parseString("v 12345678901234567890 1.5 0\r\nv 0.5 2 -3\nf 1 2 99999999\nv 1 2 3");
+		REQUIRE(contents.vertices.size() == 3);
+		REQUIRE(contents.vertices[0].x == 12345678901234567890.0f);
+		REQUIRE(contents.vertices[1] == ofVec3f(0.5f, 2, -3));
+		REQUIRE(contents.vertices[2] == ofVec3f(1, 2, 3));
+		REQUIRE(contents.triangles == std::vector<uint32_t>{ 0, 1, 99999998 });
+	}
+
+	SECTION("An unreadable vertex still takes its place, so later faces refer to the right vertices") {
+		ObjContents contents = parseString("v 1 1 1\nv 2 x 2\nv 3 3 3\nf 1 2 3\n");
+		REQUIRE(contents.vertices.size() == 3);
+		REQUIRE(contents.vertices[1] == ofVec3f(0, 0, 0));
+		REQUIRE(contents.vertices[2] == ofVec3f(3, 3, 3));
+		REQUIRE(contents.triangles == std::vector<uint32_t>{ 0, 1, 2 });
+	}
+
+	SECTION("Indices with more digits than fit are dropped with their face") {
+		ObjContents contents = parseString("f 1 2 3\nf 1 2 1234567890\n");
+		REQUIRE(contents.triangles == std::vector<uint32_t>{ 0, 1, 2 });
+	}
+
+	SECTION("Polygons are split into triangle fans") {
+		ObjContents contents = parseString("f 1 2 3 4\n");
+		REQUIRE(contents.triangles == std::vector<uint32_t>{ 0, 1, 2, 0, 2, 3 });
+	}
+
+	SECTION("Faces with relative indices are dropped") {
+		ObjContents contents = parseString("f -1 -2 -3\n");
+		REQUIRE(contents.triangles.empty());
+	}
+
+	SECTION("A bad index in the last slot drops the triangles already emitted for that face") {
+		ObjContents contents = parseString("f 1 2 3\nf 1 2 3 4 -1\nf 4 5 6 7 x\nf 1 2 3 0\n");
+		REQUIRE(contents.triangles == std::vector<uint32_t>{ 0, 1, 2 });
+	}
+}
+
+TEST_CASE("Test parsing every model file") {
+	//Expected vertex and face counts for each file in the models folder
+	std::vector<std::string> names = { "cow", "cube", "head", "pumpkin", "sphere", "teapot", "teddy", "tetrahedron" };
+	std::vector<size_t> vertex_counts = { 4583, 8, 463, 5002, 162, 3644, 1598, 4 };
+	std::vector<size_t> face_counts = { 5804, 12, 896, 10000, 320, 6320, 3192, 4 };
+
+	for (size_t i = 0; i < names.size(); i++) {
+		MappedFile obj_file("..\\models\\" + names[i] + ".obj");
+		REQUIRE(obj_file.isOpen());
+
+		ObjContents contents;
+		ObjParser::parse(obj_file.begin(), obj_file.end(), contents);
+		REQUIRE(contents.vertices.size() == vertex_counts[i]);
+		REQUIRE(contents.triangles.size() == face_counts[i] * 3);
+	}
+}
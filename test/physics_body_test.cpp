@@ -17,14 +17,14 @@ TEST_CASE("Test proper construction of test_body") {
 
 TEST_CASE("Test void update(float time_interval)") {
 
-	ofVec3f rotated_vert = ofVec3f(test_body.vertices[0].x, -test_body.vertices[0].y, -test_body.vertices[0].z);
+	ofVec3f rotated_vert = ofVec3f(test_body.transformedVertex(0).x, -test_body.transformedVertex(0).y, -test_body.transformedVertex(0).z);
 
 	//Test proper update after a second of time
 	test_body.update(1.0f);
 
 	REQUIRE(nearlyEquivalent(test_body.velocity, ofVec3f(1, 0, 0)));
 	REQUIRE(nearlyEquivalent(test_body.position, ofVec3f(2, 0, 0)));
-	REQUIRE(nearlyEquivalent(test_body.vertices[0], rotated_vert));
+	REQUIRE(nearlyEquivalent(test_body.transformedVertex(0), rotated_vert));
 }
 
 TEST_CASE("Test gravitateWith(PhysicsBody* other)") {
@@ -0,0 +1,167 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+/* The walls, floor and ceiling of the box demo */
+static std::vector<Plane*> boxWalls(int box_size) {
+	int wall_offset = (box_size + 1) / 2;
+	int size = 2 * wall_offset + 1;
+	return {
+		new Plane(ofVec3f(0, -wall_offset, 0), ofVec3f(0, 1, 0), ofColor::gray, size),
+		new Plane(ofVec3f(0, wall_offset, 0), ofVec3f(0, -1, 0), ofColor::gray, size),
+		new Plane(ofVec3f(wall_offset, 0, 0), ofVec3f(-1, 0, 0), ofColor::gray, size),
+		new Plane(ofVec3f(-wall_offset, 0, 0), ofVec3f(1, 0, 0), ofColor::gray, size),
+		new Plane(ofVec3f(0, 0, wall_offset), ofVec3f(0, 0, -1), ofColor::gray, size),
+		new Plane(ofVec3f(0, 0, -wall_offset), ofVec3f(0, 0, 1), ofColor::gray, size)
+	};
+}
+
+/* One physics step the way the renderer did it before there was a PhysicsWorld, calling into every model */
+static void referenceStep(const std::vector<PhysicsBody*>& bodies, const std::vector<Plane*>& planes, float time_interval, GravitySolver* gravity, const Model3D* held_model) {
+	if (gravity != nullptr) {
+		BodyStore store = storeOf(bodies);
+		gravity->applyForces(store);
+		for (size_t i = 0; i < bodies.size(); i++) {
+			bodies[i]->force += store.force(i);
+		}
+	}
+	for (size_t i = 0; i < bodies.size(); i++) {
+		for (size_t j = i + 1; j < bodies.size(); j++) {
+			bodies[i]->collideWithBody(bodies[j]);
+		}
+	}
+	for (PhysicsBody* body : bodies) {
+		for (Plane* plane : planes) {
+			body->collideWithPlane(plane);
+		}
+	}
+	for (PhysicsBody* body : bodies) {
+		if (held_model != body) {
+			body->update(time_interval);
+		}
+		body->force = ofVec3f(0, 0, 0);
+	}
+}
+
+TEST_CASE("Test void step(float time_interval, bool gravity, const Model3D* held_model) against stepping the models") {
+	PhysicsWorld world;
+
+	SECTION("A box of balls, with one of them held") {
+		std::vector<PhysicsBody*> bodies = boxOfBalls(200, 4, true);
+		std::vector<PhysicsBody*> reference_bodies = boxOfBalls(200, 4, true);
+		std::vector<Plane*> planes = boxWalls(10);
+		for (PhysicsBody* body : bodies) {
+			world.addBody(body);
+		}
+		for (Plane* plane : planes) {
+			world.addCollider(plane);
+		}
+		REQUIRE(world.bodyCount() == 200);
+		REQUIRE(world.colliderCount() == 6);
+		ofVec3f held_position = bodies[7]->position;
+
+		for (int step = 0; step < 30; step++) {
+			world.step(0.02f, false, bodies[7]);
+			world.writeToModels();
+			referenceStep(reference_bodies, planes, 0.02f, nullptr, reference_bodies[7]);
+		}
+		for (size_t i = 0; i < bodies.size(); i++) {
+			REQUIRE(bodies[i]->position == reference_bodies[i]->position);
+			REQUIRE(bodies[i]->velocity == reference_bodies[i]->velocity);
+			REQUIRE(world.bodyPosition(i) == bodies[i]->position);
+		}
+		REQUIRE(bodies[7]->position == held_position);
+
+		deleteModels(bodies);
+		deleteModels(reference_bodies);
+		deleteModels(planes);
+	}
+
+	SECTION("Planets pulling on each other") {
+		std::vector<PhysicsBody*> bodies = boxOfBalls(50, 16, true);
+		std::vector<PhysicsBody*> reference_bodies = boxOfBalls(50, 16, true);
+		for (PhysicsBody* body : bodies) {
+			world.addBody(body);
+		}
+		GravitySolver reference_gravity;
+
+		for (int step = 0; step < 10; step++) {
+			world.step(0.02f, true);
+			world.writeToModels();
+			referenceStep(reference_bodies, {}, 0.02f, &reference_gravity, nullptr);
+		}
+		for (size_t i = 0; i < bodies.size(); i++) {
+			REQUIRE(nearlyEquivalent(bodies[i]->position, reference_bodies[i]->position));
+			REQUIRE(nearlyEquivalent(bodies[i]->velocity, reference_bodies[i]->velocity));
+		}
+
+		deleteModels(bodies);
+		deleteModels(reference_bodies);
+	}
+}
+
+TEST_CASE("Test adding, syncing and clearing bodies and colliders") {
+	PhysicsWorld world;
+	std::vector<PhysicsBody*> bodies = boxOfBalls(5, 4, true);
+	std::vector<Plane*> planes = boxWalls(10);
+	for (PhysicsBody* body : bodies) {
+		world.addBody(body);
+	}
+	for (Plane* plane : planes) {
+		world.addCollider(plane);
+	}
+
+	SECTION("Syncing a moved body") {
+		bodies[2]->position = ofVec3f(1, 2, 3);
+		bodies[2]->velocity = ofVec3f(0, 0, 0);
+		REQUIRE(world.bodyPosition(2) != ofVec3f(1, 2, 3));
+		world.syncFromModel(bodies[2]);
+		REQUIRE(world.bodyPosition(2) == ofVec3f(1, 2, 3));
+		world.step(0.02f, false, bodies[2]);
+		world.writeToModels();
+		REQUIRE(bodies[2]->position == ofVec3f(1, 2, 3));
+	}
+
+	SECTION("Drawing between steps") {
+		ofVec3f before = bodies[3]->position;
+		world.step(0.02f, false);
+		ofVec3f after = world.bodyPosition(3);
+		world.writeToModels(0.25f);
+		REQUIRE(nearlyEquivalent(bodies[3]->position, before + (after - before) * 0.25f));
+
+		//No new step, so the next frame is drawn further along the same one
+		world.writeToModels(1);
+		REQUIRE(bodies[3]->position == after);
+	}
+
+	SECTION("Drawing bodies as instances of their mesh") {
+		PhysicsBody cube("..\\models\\cube.obj", ofColor::white, 1, ofVec3f(), ofVec3f(), ofVec3f(), 1);
+		world.addBody(&cube);
+		world.step(0.02f, false);
+		world.writeToModels();
+		std::vector<ModelInstance> instances;
+		std::vector<uint32_t> others;
+		world.bodyInstances(bodies[0]->mesh.get(), instances, others);
+		REQUIRE(instances.size() == 5);
+		REQUIRE(others == std::vector<uint32_t>{ 5 });
+		REQUIRE(instances[2].position == bodies[2]->position);
+		REQUIRE(instances[2].orientation.w == bodies[2]->orientation.w);
+		REQUIRE(instances[2].orientation.x == bodies[2]->orientation.x);
+		REQUIRE(instances[2].scale == bodies[2]->scale);
+		REQUIRE(instances[2].color == bodies[2]->color);
+		world.clear();
+	}
+
+	SECTION("Clearing") {
+		world.clear();
+		REQUIRE(world.bodyCount() == 0);
+		REQUIRE(world.colliderCount() == 0);
+
+		//Models that were in the world before it was cleared are ignored
+		world.syncFromModel(bodies[0]);
+		REQUIRE(world.bodyCount() == 0);
+		world.step(0.02f, true);
+	}
+
+	deleteModels(bodies);
+	deleteModels(planes);
+}
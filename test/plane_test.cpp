@@ -13,49 +13,60 @@ TEST_CASE("Test proper construction of Plane") {
 	}
 
 	SECTION("Check vertices") {
-		REQUIRE(nearlyEquivalent(plane.vertices[0], ofVec3f(0.0f, -1.5f, -1.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[1], ofVec3f(0.0f, -1.5f, -0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[2], ofVec3f(0.0f, -1.5f, 0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[3], ofVec3f(0.0f, -1.5f, 1.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[4], ofVec3f(0.0f, -0.5f, -1.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[5], ofVec3f(0.0f, -0.5f, -0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[6], ofVec3f(0.0f, -0.5f, 0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[7], ofVec3f(0.0f, -0.5f, 1.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[8], ofVec3f(0.0f, 0.5f, -1.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[9], ofVec3f(0.0f, 0.5f, -0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[10], ofVec3f(0.0f, 0.5f, 0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[11], ofVec3f(0.0f, 0.5f, 1.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[12], ofVec3f(0.0f, 1.5f, -1.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[13], ofVec3f(0.0f, 1.5f, -0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[14], ofVec3f(0.0f, 1.5f, 0.5f)));
-		REQUIRE(nearlyEquivalent(plane.vertices[15], ofVec3f(0.0f, 1.5f, 1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(0), ofVec3f(0.0f, -1.5f, -1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(1), ofVec3f(0.0f, -1.5f, -0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(2), ofVec3f(0.0f, -1.5f, 0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(3), ofVec3f(0.0f, -1.5f, 1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(4), ofVec3f(0.0f, -0.5f, -1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(5), ofVec3f(0.0f, -0.5f, -0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(6), ofVec3f(0.0f, -0.5f, 0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(7), ofVec3f(0.0f, -0.5f, 1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(8), ofVec3f(0.0f, 0.5f, -1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(9), ofVec3f(0.0f, 0.5f, -0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(10), ofVec3f(0.0f, 0.5f, 0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(11), ofVec3f(0.0f, 0.5f, 1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(12), ofVec3f(0.0f, 1.5f, -1.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(13), ofVec3f(0.0f, 1.5f, -0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(14), ofVec3f(0.0f, 1.5f, 0.5f)));
+		REQUIRE(nearlyEquivalent(plane.transformedVertex(15), ofVec3f(0.0f, 1.5f, 1.5f)));
 	}
 	
+	SECTION("Check faces") {
+		//Two triangles for each of the 3x3 squares between the vertices
+		REQUIRE(plane.mesh->triangles.size() == 3 * 3 * 2 * 3);
+		REQUIRE(std::vector<uint32_t>(plane.mesh->triangles.begin(), plane.mesh->triangles.begin() + 6) == std::vector<uint32_t>({ 0, 4, 1, 1, 4, 5 }));
+	}
+
+	SECTION("Check bounding radius") {
+		//The corners are 1.5 from the center along both axes of the plane
+		REQUIRE(nearlyEquivalent(plane.boundingRadius(), std::sqrt(1.5f * 1.5f * 2)));
+	}
+
 	SECTION("Check edges") {
-		REQUIRE(plane.edges[0] == ofVec2f(0, 4));
-		REQUIRE(plane.edges[1] == ofVec2f(4, 8));
-		REQUIRE(plane.edges[2] == ofVec2f(8, 12));
-		REQUIRE(plane.edges[3] == ofVec2f(1, 5));
-		REQUIRE(plane.edges[4] == ofVec2f(5, 9));
-		REQUIRE(plane.edges[5] == ofVec2f(9, 13));
-		REQUIRE(plane.edges[6] == ofVec2f(2, 6));
-		REQUIRE(plane.edges[7] == ofVec2f(6, 10));
-		REQUIRE(plane.edges[8] == ofVec2f(10, 14));
-		REQUIRE(plane.edges[9] == ofVec2f(3, 7));
-		REQUIRE(plane.edges[10] == ofVec2f(7, 11));
-		REQUIRE(plane.edges[11] == ofVec2f(11, 15));
-		REQUIRE(plane.edges[12] == ofVec2f(0, 1));
-		REQUIRE(plane.edges[13] == ofVec2f(1, 2));
-		REQUIRE(plane.edges[14] == ofVec2f(2, 3));
-		REQUIRE(plane.edges[15] == ofVec2f(4, 5));
-		REQUIRE(plane.edges[16] == ofVec2f(5, 6));
-		REQUIRE(plane.edges[17] == ofVec2f(6, 7));
-		REQUIRE(plane.edges[18] == ofVec2f(8, 9));
-		REQUIRE(plane.edges[19] == ofVec2f(9, 10));
-		REQUIRE(plane.edges[20] == ofVec2f(10, 11));
-		REQUIRE(plane.edges[21] == ofVec2f(12, 13));
-		REQUIRE(plane.edges[22] == ofVec2f(13, 14));
-		REQUIRE(plane.edges[23] == ofVec2f(14, 15));
+		REQUIRE(plane.mesh->edges[0] == Edge(0, 4));
+		REQUIRE(plane.mesh->edges[1] == Edge(4, 8));
+		REQUIRE(plane.mesh->edges[2] == Edge(8, 12));
+		REQUIRE(plane.mesh->edges[3] == Edge(1, 5));
+		REQUIRE(plane.mesh->edges[4] == Edge(5, 9));
+		REQUIRE(plane.mesh->edges[5] == Edge(9, 13));
+		REQUIRE(plane.mesh->edges[6] == Edge(2, 6));
+		REQUIRE(plane.mesh->edges[7] == Edge(6, 10));
+		REQUIRE(plane.mesh->edges[8] == Edge(10, 14));
+		REQUIRE(plane.mesh->edges[9] == Edge(3, 7));
+		REQUIRE(plane.mesh->edges[10] == Edge(7, 11));
+		REQUIRE(plane.mesh->edges[11] == Edge(11, 15));
+		REQUIRE(plane.mesh->edges[12] == Edge(0, 1));
+		REQUIRE(plane.mesh->edges[13] == Edge(1, 2));
+		REQUIRE(plane.mesh->edges[14] == Edge(2, 3));
+		REQUIRE(plane.mesh->edges[15] == Edge(4, 5));
+		REQUIRE(plane.mesh->edges[16] == Edge(5, 6));
+		REQUIRE(plane.mesh->edges[17] == Edge(6, 7));
+		REQUIRE(plane.mesh->edges[18] == Edge(8, 9));
+		REQUIRE(plane.mesh->edges[19] == Edge(9, 10));
+		REQUIRE(plane.mesh->edges[20] == Edge(10, 11));
+		REQUIRE(plane.mesh->edges[21] == Edge(12, 13));
+		REQUIRE(plane.mesh->edges[22] == Edge(13, 14));
+		REQUIRE(plane.mesh->edges[23] == Edge(14, 15));
 	}
 }
 
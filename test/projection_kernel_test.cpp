@@ -0,0 +1,183 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+/* The three arrays of vertex components the kernel reads */
+struct ComponentArrays {
+	std::vector<float> xs, ys, zs;
+
+	void push_back(ofVec3f vertex) {
+		xs.push_back(vertex.x);
+		ys.push_back(vertex.y);
+		zs.push_back(vertex.z);
+	}
+	size_t size() const {
+		return xs.size();
+	}
+};
+
+/* Projection results of one path */
+struct ProjectionResult {
+	std::vector<ofVec2f> points;
+	std::vector<uint8_t> outcodes;
+};
+
+static ProjectionResult runPath(ProjectionKernel::Path path, const ComponentArrays& vertices, const ProjectionParams& params) {
+	ProjectionResult result;
+	result.points.resize(vertices.size());
+	result.outcodes.resize(vertices.size());
+	ProjectionKernel::project(vertices.xs.data(), vertices.ys.data(), vertices.zs.data(), vertices.size(), params, result.points.data(), result.outcodes.data(), path);
+	return result;
+}
+
+/* Compares two results bit for bit, so NaNs and the sign of zero have to match as well */
+static void requireIdentical(const ProjectionResult& result, const ProjectionResult& expected) {
+	REQUIRE(result.points.size() == expected.points.size());
+	REQUIRE(std::memcmp(result.points.data(), expected.points.data(), expected.points.size() * sizeof(ofVec2f)) == 0);
+	REQUIRE(result.outcodes == expected.outcodes);
+}
+
+/* Every path this machine can run */
+static std::vector<ProjectionKernel::Path> supportedPaths() {
+	std::vector<ProjectionKernel::Path> paths;
+	for (ProjectionKernel::Path path : { ProjectionKernel::SCALAR, ProjectionKernel::SSE, ProjectionKernel::AVX2 }) {
+		if (ProjectionKernel::supports(path)) {
+			paths.push_back(path);
+		}
+	}
+	return paths;
+}
+
+/* Camera used throughout, turned so that no matrix entry is zero */
+static Camera kernelTestCamera() {
+	Camera camera = Camera(ofVec3f(0.5f, 1, 5), ofVec2f(0.3f, -0.2f), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+	camera.computeLocalBasis();
+	return camera;
+}
+
+/* Deterministic points spread in front of, beside and behind the camera */
+static ComponentArrays scatteredVertices(size_t count) {
+	ComponentArrays vertices;
+	for (size_t i = 0; i < count; i++) {
+		vertices.push_back(scatteredPoint(i) * 10);
+	}
+	return vertices;
+}
+
+TEST_CASE("Test ProjectionKernel::supports(Path path)") {
+	REQUIRE(ProjectionKernel::supports(ProjectionKernel::SCALAR));
+	REQUIRE(ProjectionKernel::supports(ProjectionKernel::bestPath()));
+
+	//AVX2 implies SSE
+	if (ProjectionKernel::supports(ProjectionKernel::AVX2)) {
+		REQUIRE(ProjectionKernel::supports(ProjectionKernel::SSE));
+	}
+}
+
+TEST_CASE("Test ProjectionKernel::projectScalar against Camera::project") {
+	Camera camera = kernelTestCamera();
+	ofMatrix3x3 model_view_matrix = camera.view_matrix * ofMatrix3x3(0.5f, 0, 0, 0, 0.5f, 0, 0, 0, 0.5f);
+	ofVec3f model_view_offset = Model3D::applyMatrix(camera.view_matrix, ofVec3f(1, -2, 0) - camera.position);
+	ComponentArrays vertices = scatteredVertices(5000);
+
+	ProjectionResult result = runPath(ProjectionKernel::SCALAR, vertices, camera.projectionParams(model_view_matrix, model_view_offset));
+	for (size_t i = 0; i < vertices.size(); i++) {
+		ofVec3f vertex = ofVec3f(vertices.xs[i], vertices.ys[i], vertices.zs[i]);
+		ofVec3f view_point = Model3D::applyMatrix(model_view_matrix, vertex) + model_view_offset;
+		ofVec2f expected = camera.project(view_point);
+		REQUIRE(result.points[i] == expected);
+
+		//Visible means in front of the near plane and inside the window
+		bool on_screen = expected.x >= 0 && expected.x <= camera.win_width && expected.y >= 0 && expected.y <= camera.win_height;
+		REQUIRE((result.outcodes[i] == 0) == (view_point.z < -camera.near_plane && on_screen));
+		REQUIRE(((result.outcodes[i] & ProjectionKernel::BEHIND) != 0) == !(view_point.z < -camera.near_plane));
+	}
+}
+
+TEST_CASE("Test SIMD paths of ProjectionKernel::project against the scalar path") {
+	Camera camera = kernelTestCamera();
+	ProjectionParams params = camera.projectionParams(camera.view_matrix, Model3D::applyMatrix(camera.view_matrix, -camera.position));
+
+	SECTION("Every length up to a few registers, so every remainder is covered") {
+		ComponentArrays all_vertices = scatteredVertices(40);
+		for (size_t count = 0; count <= all_vertices.size(); count++) {
+			ComponentArrays vertices;
+			for (size_t i = 0; i < count; i++) {
+				vertices.push_back(ofVec3f(all_vertices.xs[i], all_vertices.ys[i], all_vertices.zs[i]));
+			}
+			ProjectionResult expected = runPath(ProjectionKernel::SCALAR, vertices, params);
+			for (ProjectionKernel::Path path : supportedPaths()) {
+				requireIdentical(runPath(path, vertices, params), expected);
+			}
+		}
+	}
+
+	SECTION("A dense grid around the camera, from many directions") {
+		ComponentArrays vertices;
+		for (int x = -20; x <= 20; x++) {
+			for (int y = -20; y <= 20; y++) {
+				for (int z = -20; z <= 20; z++) {
+					vertices.push_back(camera.position + ofVec3f(x, y, z) * 0.37f);
+				}
+			}
+		}
+		for (int turn = 0; turn < 8; turn++) {
+			camera.update(ofVec3f(), ofVec2f(0.9f, (turn % 3 - 1) * 0.6f), false, 1);
+			params = camera.projectionParams(camera.view_matrix, Model3D::applyMatrix(camera.view_matrix, -camera.position));
+			ProjectionResult expected = runPath(ProjectionKernel::SCALAR, vertices, params);
+			for (ProjectionKernel::Path path : supportedPaths()) {
+				requireIdentical(runPath(path, vertices, params), expected);
+			}
+		}
+	}
+
+	SECTION("Points on the near plane, on the screen edges, and not numbers") {
+		//With the identity view there is no rounding, so these land exactly on the edges
+		Camera straight_camera = Camera(ofVec3f(0, 0, 0), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 1.0f, 1920, 1080);
+		params = straight_camera.projectionParams(ofMatrix3x3(1, 0, 0, 0, 1, 0, 0, 0, 1), ofVec3f());
+		float infinity = std::numeric_limits<float>::infinity();
+		float nan = std::numeric_limits<float>::quiet_NaN();
+		float near_z = -straight_camera.near_plane;
+		ComponentArrays vertices;
+		for (ofVec3f vertex : {
+			ofVec3f(0, 0, 0), ofVec3f(0, 0, -0.0f), ofVec3f(1, 1, -1e-30f), ofVec3f(0, 0, 1e-30f), ofVec3f(0, 0, near_z), ofVec3f(0, 0, near_z * 1.01f),
+			ofVec3f(960, 0, 1), ofVec3f(960, 0, -1), ofVec3f(961, 0, -1), ofVec3f(-960, 0, -1), ofVec3f(-961, 0, -1),
+			ofVec3f(0, 540, -1), ofVec3f(0, 541, -1), ofVec3f(0, -540, -1), ofVec3f(0, -541, -1),
+			ofVec3f(nan, 0, -1), ofVec3f(0, nan, -1), ofVec3f(0, 0, nan), ofVec3f(infinity, 0, -1), ofVec3f(0, 0, -infinity) }) {
+			vertices.push_back(vertex);
+		}
+
+		ProjectionResult expected = runPath(ProjectionKernel::SCALAR, vertices, params);
+		for (ProjectionKernel::Path path : supportedPaths()) {
+			requireIdentical(runPath(path, vertices, params), expected);
+		}
+
+		//Points on the near plane are behind it and points on the window edges are inside it. A vertex that is not a number is behind the
+		//camera, since zero times it is not a number either, and an infinite z times a zero matrix entry leaves both screen coordinates outside both sides
+		const uint8_t B = ProjectionKernel::BEHIND, L = ProjectionKernel::LEFT, R = ProjectionKernel::RIGHT;
+		const uint8_t A = ProjectionKernel::ABOVE, D = ProjectionKernel::BELOW;
+		REQUIRE(expected.outcodes == std::vector<uint8_t>({ B, B, B, B, B, 0, B, 0, R, 0, L, 0, A, 0, D, B, B, B, B, L | R | A | D }));
+	}
+}
+
+TEST_CASE("Test Camera::projectModel with every ProjectionKernel path") {
+	Camera camera = kernelTestCamera();
+	Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::white, ofVec3f(1, 0, 0), 0.4);
+	teapot.rotate(ofVec3f(0.3f, 0.2f, 0.1f));
+	REQUIRE(teapot.mesh->hasVertexComponents());
+
+	camera.projection_path = ProjectionKernel::SCALAR;
+	camera.projectModel(&teapot);
+	std::vector<ofVec2f> expected_points = camera.projected_vertices;
+	std::vector<uint8_t> expected_outcodes = camera.vertex_outcodes;
+
+	for (ProjectionKernel::Path path : supportedPaths()) {
+		camera.projection_path = path;
+		camera.projectModel(&teapot);
+		REQUIRE(camera.projected_vertices == expected_points);
+		REQUIRE(camera.vertex_outcodes == expected_outcodes);
+	}
+}
@@ -0,0 +1,124 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+/* Deterministic models of a few shapes and sizes, scattered around the origin */
+static std::vector<Model3D*> scatteredModels(size_t count) {
+	const char* obj_paths[3] = { "..\\models\\cube.obj", "..\\models\\teapot.obj", "..\\models\\sphere.obj" };
+	std::vector<Model3D*> models;
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f position = scatteredPoint(i) * ofVec3f(40, 10, 40);
+		models.push_back(new Model3D(obj_paths[i % 3], ofColor::white, position, 0.2f + (i % 7) * 0.1f));
+	}
+	return models;
+}
+
+/* Culls by testing every model on its own */
+static std::vector<uint32_t> linearCull(const Camera& camera, const std::vector<Model3D*>& models) {
+	std::vector<uint32_t> visible;
+	for (uint32_t i = 0; i < models.size(); i++) {
+		if (camera.inFrustum(models[i]->position, models[i]->boundingRadius())) {
+			visible.push_back(i);
+		}
+	}
+	return visible;
+}
+
+/* Finds the models near a ray by testing every model on its own */
+static std::vector<uint32_t> linearRay(ofVec3f origin, ofVec3f direction, float radius, const std::vector<Model3D*>& models) {
+	std::vector<uint32_t> hits;
+	for (uint32_t i = 0; i < models.size(); i++) {
+		ofVec3f offset = models[i]->position - origin;
+		float t = offset.dot(direction);
+		if (t >= 0 && (offset - direction * t).lengthSquared() <= radius * radius) {
+			hits.push_back(i);
+		}
+	}
+	return hits;
+}
+
+TEST_CASE("Test void build(const std::vector<Model3D*>& scene_models)") {
+	SceneBVH bvh;
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+
+	SECTION("An empty scene finds nothing") {
+		bvh.build(std::vector<Model3D*>());
+		bvh.refit();
+		std::vector<uint32_t> results;
+		bvh.cullFrustum(camera, results);
+		bvh.queryRay(ofVec3f(), ofVec3f(0, 0, -1), 1, results);
+		REQUIRE(results.empty());
+		REQUIRE(bvh.modelCount() == 0);
+	}
+
+	SECTION("Every model ends up in exactly one leaf") {
+		std::vector<Model3D*> models = scatteredModels(1000);
+		bvh.build(models);
+		REQUIRE(bvh.modelCount() == 1000);
+		REQUIRE(bvh.nodeCount() < 2 * models.size());
+
+		//A frustum so wide nothing is outside it sees every model once
+		Camera wide_camera = Camera(ofVec3f(0, 0, 200), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 1.0f, 1920, 1080);
+		std::vector<uint32_t> visible;
+		bvh.cullFrustum(wide_camera, visible);
+		REQUIRE(visible.size() == models.size());
+		for (uint32_t i = 0; i < visible.size(); i++) {
+			REQUIRE(visible[i] == i);
+		}
+		deleteModels(models);
+	}
+}
+
+TEST_CASE("Test void cullFrustum(const Camera& camera, std::vector<uint32_t>& visible)") {
+	std::vector<Model3D*> models = scatteredModels(2000);
+	SceneBVH bvh;
+	bvh.build(models);
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0, 0), 1.5f, 1.0f, 3.0f, 0.5f, 600.0f, 1920, 1080);
+
+	//The hierarchy finds the same models, in scene order, as testing each one from many directions
+	for (int turn = 0; turn < 12; turn++) {
+		camera.update(ofVec3f(), ofVec2f(0.55f, (turn % 3 - 1) * 0.5f), false, 1);
+		std::vector<uint32_t> visible;
+		bvh.cullFrustum(camera, visible);
+		REQUIRE(visible == linearCull(camera, models));
+	}
+
+	SECTION("After models move and the hierarchy is refit") {
+		for (size_t i = 0; i < models.size(); i += 3) {
+			models[i]->position += ofVec3f(std::cos(i * 0.5f) * 30, 5, std::sin(i * 0.5f) * 30);
+		}
+		bvh.refit();
+		for (int turn = 0; turn < 12; turn++) {
+			camera.update(ofVec3f(), ofVec2f(0.55f, 0.1f), false, 1);
+			std::vector<uint32_t> visible;
+			bvh.cullFrustum(camera, visible);
+			REQUIRE(visible == linearCull(camera, models));
+		}
+	}
+	deleteModels(models);
+}
+
+TEST_CASE("Test void queryRay(ofVec3f origin, ofVec3f direction, float radius, std::vector<uint32_t>& hits)") {
+	std::vector<Model3D*> models = scatteredModels(2000);
+	SceneBVH bvh;
+	bvh.build(models);
+
+	//Rays from inside and outside the scene, including along the axes
+	for (int i = 0; i < 50; i++) {
+		ofVec3f origin = ofVec3f(std::sin(i * 1.3f) * 60, std::cos(i * 0.7f) * 15, std::cos(i * 2.1f) * 60);
+		ofVec3f direction = ofVec3f(std::sin(i * 0.9f), std::sin(i * 0.4f) * 0.3f, std::cos(i * 0.9f)).getNormalized();
+		if (i % 10 == 0) {
+			direction = ofVec3f(0, 0, i % 20 == 0 ? 1 : -1);
+		}
+		for (float radius : { 0.5f, 3.0f }) {
+			std::vector<uint32_t> hits;
+			bvh.queryRay(origin, direction, radius, hits);
+			REQUIRE(hits == linearRay(origin, direction, radius, models));
+		}
+	}
+
+	//A ray straight at a model finds it
+	std::vector<uint32_t> hits;
+	bvh.queryRay(models[17]->position + ofVec3f(0, 0, 100), ofVec3f(0, 0, -1), 0.01f, hits);
+	REQUIRE(std::find(hits.begin(), hits.end(), 17) != hits.end());
+	deleteModels(models);
+}
@@ -0,0 +1,153 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+/* Counts the pixels of a framebuffer that aren't the background color */
+static size_t countLitPixels(const SoftwareRasterizer& rasterizer) {
+	size_t lit = 0;
+	for (int y = 0; y < rasterizer.getHeight(); y++) {
+		for (int x = 0; x < rasterizer.getWidth(); x++) {
+			if (rasterizer.getPixel(x, y) != ofColor::black) {
+				lit++;
+			}
+		}
+	}
+	return lit;
+}
+
+/* The lines of the models demo seen from the camera's starting position, at a small resolution */
+static LineBatch modelsDemoLines(int width, int height) {
+	Camera camera = Camera(ofVec3f(0, 0, 5), ofVec2f(0.1f, -0.05f), 1.5f, 1.0f, 3.0f, 0.5f, 150.0f, width, height);
+	Model3D cow = Model3D("..\\models\\cow.obj", ofColor::white, ofVec3f(0, 0, -1), 0.2);
+	Model3D teapot = Model3D("..\\models\\teapot.obj", ofColor::lightBlue, ofVec3f(2, 0, 0), 0.4);
+	Model3D cube = Model3D("..\\models\\cube.obj", ofColor::green, ofVec3f(-2, 0, 0), 1);
+	LineBatch lines;
+	camera.drawModel(&cow, lines);
+	camera.drawModel(&teapot, lines);
+	camera.drawModel(&cube, lines);
+	return lines;
+}
+
+TEST_CASE("Test SoftwareRasterizer(int width_, int height_, int tile_size_)") {
+	SoftwareRasterizer rasterizer = SoftwareRasterizer(100, 50, 16);
+	REQUIRE(rasterizer.getWidth() == 100);
+	REQUIRE(rasterizer.getHeight() == 50);
+	REQUIRE(rasterizer.getFramebuffer().size() == 100 * 50 * 4);
+}
+
+TEST_CASE("Test void rasterize(const LineBatch& lines)") {
+	SoftwareRasterizer rasterizer = SoftwareRasterizer(100, 50, 16);
+	LineBatch lines;
+
+	SECTION("An empty batch clears the framebuffer") {
+		rasterizer.background_color = ofColor::blue;
+		rasterizer.rasterize(lines);
+		REQUIRE(rasterizer.getPixel(0, 0) == ofColor::blue);
+		REQUIRE(rasterizer.getPixel(99, 49) == ofColor::blue);
+	}
+
+	SECTION("A horizontal line fills the pixels whose centers it passes through") {
+		lines.addSegment(ofVec2f(10, 20.5f), ofVec2f(30, 20.5f), ofColor::red);
+		rasterizer.rasterize(lines);
+		for (int x = 10; x < 30; x++) {
+			REQUIRE(rasterizer.getPixel(x, 20) == ofColor::red);
+		}
+		REQUIRE(rasterizer.getPixel(9, 20) == ofColor::black);
+		REQUIRE(rasterizer.getPixel(30, 20) == ofColor::black);
+		REQUIRE(countLitPixels(rasterizer) == 20);
+	}
+
+	SECTION("A steep line has one pixel per row") {
+		lines.addSegment(ofVec2f(40, 2), ofVec2f(45, 47), ofColor::green);
+		rasterizer.rasterize(lines);
+		REQUIRE(countLitPixels(rasterizer) == 45);
+		for (int y = 2; y < 47; y++) {
+			int lit_in_row = 0;
+			for (int x = 0; x < 100; x++) {
+				lit_in_row += rasterizer.getPixel(x, y) != ofColor::black;
+			}
+			REQUIRE(lit_in_row == 1);
+		}
+	}
+
+	SECTION("Later segments cover earlier ones") {
+		lines.addSegment(ofVec2f(0, 10.5f), ofVec2f(100, 10.5f), ofColor::red);
+		lines.addSegment(ofVec2f(50.5f, 0), ofVec2f(50.5f, 50), ofColor::yellow);
+		rasterizer.rasterize(lines);
+		REQUIRE(rasterizer.getPixel(50, 10) == ofColor::yellow);
+		REQUIRE(rasterizer.getPixel(49, 10) == ofColor::red);
+	}
+
+	SECTION("Segments partly or entirely off the screen are clipped") {
+		lines.addSegment(ofVec2f(-500, 25.5f), ofVec2f(600, 25.5f), ofColor::red);
+		lines.addSegment(ofVec2f(-500, -500), ofVec2f(-100, -20), ofColor::red);
+		lines.addSegment(ofVec2f(1e30f, 0), ofVec2f(-1e30f, 1), ofColor::red);
+		rasterizer.rasterize(lines);
+		for (int x = 0; x < 100; x++) {
+			REQUIRE(rasterizer.getPixel(x, 25) == ofColor::red);
+		}
+	}
+
+	SECTION("Anti-aliased lines split their color between neighbouring pixels") {
+		rasterizer.anti_aliasing = true;
+		lines.addSegment(ofVec2f(10, 20.75f), ofVec2f(30, 20.75f), ofColor::white);
+		rasterizer.rasterize(lines);
+
+		//The line is a quarter of the way from the center of row 20 to the center of row 21
+		REQUIRE(rasterizer.getPixel(15, 20) == ofColor(191, 191, 191));
+		REQUIRE(rasterizer.getPixel(15, 21) == ofColor(64, 64, 64));
+		REQUIRE(rasterizer.getPixel(15, 19) == ofColor::black);
+	}
+}
+
+TEST_CASE("Test rasterized output does not depend on tiles or threads") {
+	int width = 320;
+	int height = 180;
+	LineBatch lines = modelsDemoLines(width, height);
+	REQUIRE(lines.segmentCount() > 1000);
+
+	for (bool anti_aliasing : { false, true }) {
+		//One tile on one thread is the reference
+		SoftwareRasterizer reference = SoftwareRasterizer(width, height, std::max(width, height));
+		reference.anti_aliasing = anti_aliasing;
+		reference.thread_count = 1;
+		reference.rasterize(lines);
+		REQUIRE(countLitPixels(reference) > 1000);
+
+		for (int tile_size : { 7, 16, 64 }) {
+			for (unsigned thread_count : { 1u, 3u, 8u }) {
+				SoftwareRasterizer rasterizer = SoftwareRasterizer(width, height, tile_size);
+				rasterizer.anti_aliasing = anti_aliasing;
+				rasterizer.thread_count = thread_count;
+
+				//Rasterize twice, to check that nothing is left over from the last frame
+				rasterizer.rasterize(lines);
+				rasterizer.rasterize(lines);
+				REQUIRE(rasterizer.getFramebuffer() == reference.getFramebuffer());
+			}
+		}
+	}
+}
+
+TEST_CASE("Test bool save(const std::string& file_path) as PPM") {
+	SoftwareRasterizer rasterizer = SoftwareRasterizer(4, 3);
+	LineBatch lines;
+	lines.addSegment(ofVec2f(0, 1.5f), ofVec2f(4, 1.5f), ofColor(10, 20, 30));
+	rasterizer.rasterize(lines);
+
+	std::string path = "software_rasterizer_test.ppm";
+	REQUIRE(rasterizer.save(path));
+
+	//Header, then three bytes per pixel. Only the middle row is lit
+	std::ifstream file(path, std::ios::binary);
+	std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::string header = "P6\n4 3\n255\n";
+	REQUIRE(contents.size() == header.size() + 4 * 3 * 3);
+	REQUIRE(contents.substr(0, header.size()) == header);
+	REQUIRE(contents.substr(header.size(), 12) == std::string(12, '\0'));
+	REQUIRE(contents.substr(header.size() + 12, 3) == std::string({ 10, 20, 30 }));
+	file.close();
+	std::remove(path.c_str());
+
+	//A folder that doesn't exist can't be written to
+	REQUIRE(!rasterizer.save("no_such_folder/frame.ppm"));
+}
@@ -1,5 +1,7 @@
 #include "test_utils.h"
 
+#include <fstream>
+
 bool nearlyEquivalent(float num0, float num1) {
 	float difference = std::abs(num0 - num1);
 	return (difference <= 0.00001);
@@ -8,4 +10,62 @@ bool nearlyEquivalent(float num0, float num1) {
 bool nearlyEquivalent(ofVec3f vec0, ofVec3f vec1) {
 	ofVec3f difference = vec0 - vec1;
 	return (difference.length() <= 0.00001);
-}
\ No newline at end of file
+}
+
+EdgeList referenceEdges(std::string obj_path) {
+	EdgeList edges;
+	std::fstream obj_reader(obj_path);
+	std::string token;
+
+	while (obj_reader >> token) {
+		if (token == "f") {
+			//Take the vertex index from the front of each of the three face tokens
+			int triangle_verts[3];
+			for (int i = 0; i < 3; i++) {
+				obj_reader >> token;
+				triangle_verts[i] = std::stoi(token) - 1;
+			}
+
+			//Linear search for the edge or its reverse before adding it
+			for (int i = 0; i < 3; i++) {
+				int vert0 = triangle_verts[i];
+				int vert1 = triangle_verts[(i + 1) % 3];
+				bool found = false;
+				for (size_t j = 0; j < edges.size(); j++) {
+					Edge edge = edges[j];
+					if ((vert0 == edge.v0 && vert1 == edge.v1) || (vert0 == edge.v1 && vert1 == edge.v0)) {
+						found = true;
+						break;
+					}
+				}
+				if (!found) {
+					edges.push_back(Edge(vert0, vert1));
+				}
+			}
+		}
+	}
+	return edges;
+}
+
+ofVec3f scatteredPoint(size_t i) {
+	return ofVec3f(std::sin(i * 0.37f), std::cos(i * 0.71f), std::sin(i * 0.23f + 1));
+}
+
+std::vector<PhysicsBody*> boxOfBalls(size_t count, float spread, bool spinning) {
+	std::vector<PhysicsBody*> bodies;
+	for (size_t i = 0; i < count; i++) {
+		ofVec3f velocity = ofVec3f(std::cos(i * 1.3f), std::sin(i * 0.9f), std::cos(i * 0.5f)) * 3;
+		ofVec3f angular_vel = spinning ? ofVec3f(std::sin(i * 0.1f), 0, std::cos(i * 0.3f)) : ofVec3f(0, 0, 0);
+		bodies.push_back(new PhysicsBody("..\\models\\sphere.obj", ofColor::white, 1 + i % 5, scatteredPoint(i) * spread, velocity, angular_vel, 0.1f + (i % 4) * 0.15f));
+	}
+	return bodies;
+}
+
+BodyStore storeOf(const std::vector<PhysicsBody*>& bodies) {
+	BodyStore store;
+	store.resize(bodies.size());
+	for (size_t i = 0; i < bodies.size(); i++) {
+		store.setBody(i, bodies[i]->position, bodies[i]->mass, bodies[i]->radius);
+	}
+	return store;
+}
@@ -9,4 +9,26 @@
 bool nearlyEquivalent(float num0, float num1);
 
 /* Bool for determining near-equivalence of vectors */
-bool nearlyEquivalent(ofVec3f vec0, ofVec3f vec1);
\ No newline at end of file
+bool nearlyEquivalent(ofVec3f vec0, ofVec3f vec1);
+
+/* Builds the edge set of an OBJ file by checking every new edge against all previous ones, the way Model3D originally did */
+EdgeList referenceEdges(std::string obj_path);
+
+/* Returns a deterministic point for the ith of many scattered objects, with each coordinate between -1 and 1 */
+ofVec3f scatteredPoint(size_t i);
+
+/* Deterministic balls of a few masses and sizes scattered through a box like the box demo, moving in every direction. Their centers are
+   up to spread from the origin along each axis. Spinning balls also get an angular velocity */
+std::vector<PhysicsBody*> boxOfBalls(size_t count, float spread, bool spinning = false);
+
+/* Returns a store holding the position, mass and radius of each body, for the code that works on stores instead of models */
+BodyStore storeOf(const std::vector<PhysicsBody*>& bodies);
+
+/* Deletes every model in a list and empties it */
+template <typename T>
+void deleteModels(std::vector<T*>& models) {
+	for (T* model : models) {
+		delete model;
+	}
+	models.clear();
+}
@@ -0,0 +1,72 @@
+#include "catch.hpp"
+#include "test_utils.h"
+
+#include <atomic>
+
+TEST_CASE("Test void run(unsigned thread_count, const std::function<void()>& job)") {
+	WorkerPool pool(3);
+	REQUIRE(pool.workerCount() == 3);
+
+	SECTION("Every piece of work is done once, however many threads take part") {
+		for (unsigned thread_count : { 0u, 1u, 2u, 4u, 16u }) {
+			std::vector<int> done(1000, 0);
+			std::atomic<size_t> next(0);
+			pool.run(thread_count, [&]() {
+				for (size_t i = next++; i < done.size(); i = next++) {
+					done[i]++;
+				}
+			});
+			REQUIRE(std::count(done.begin(), done.end(), 1) == 1000);
+		}
+	}
+
+	SECTION("No more threads run the job than asked for") {
+		std::atomic<int> threads(0);
+		pool.run(2, [&]() {
+			threads++;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		});
+		REQUIRE(threads <= 2);
+		REQUIRE(threads >= 1);
+	}
+
+	SECTION("The same workers run job after job") {
+		std::atomic<int> total(0);
+		for (int job = 0; job < 500; job++) {
+			std::atomic<int> next(0);
+			pool.run(4, [&]() {
+				for (int i = next++; i < 8; i = next++) {
+					total++;
+				}
+			});
+		}
+		REQUIRE(total == 4000);
+	}
+
+	SECTION("A job started from inside a job runs inline on the same thread, on the caller and on the workers alike") {
+		std::atomic<int> outer(0);
+		std::atomic<int> inner(0);
+		std::atomic<int> inner_elsewhere(0);
+		pool.run(4, [&]() {
+			outer++;
+			std::thread::id outer_thread = std::this_thread::get_id();
+			pool.run(4, [&]() {
+				inner++;
+				inner_elsewhere += std::this_thread::get_id() != outer_thread;
+			});
+
+			//Keep this thread busy so the other threads get to join the outer job too
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		});
+		REQUIRE(outer >= 1);
+		REQUIRE(inner == outer);
+		REQUIRE(inner_elsewhere == 0);
+
+		//The pool is free again afterwards
+		std::atomic<int> threads(0);
+		pool.run(1, [&]() {
+			threads++;
+		});
+		REQUIRE(threads == 1);
+	}
+}